@@ -0,0 +1,2 @@
+DELETE FROM `command` WHERE `name` = 'debug lootroll';
+INSERT INTO `command` VALUES ('debug lootroll', 3, 'Syntax: .debug lootroll $table $lootId $groupId [$rolls]\r\n\r\nRolls the group $groupId of the loot $lootId of $table (creature_loot_template, gameobject_loot_template...) $rolls times (1000000 by default) with the sequential walk over the entries and with the alias table, then compares both distributions with a chi-square test.');
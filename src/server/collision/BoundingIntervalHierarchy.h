@@ -15,6 +15,7 @@
 
 #include "Define.h"
 #include "Common.h"
+#include "RayPacket.h"
 
 #define MAX_STACK_SIZE 64
 
@@ -241,6 +242,130 @@ class BIH
             }
         }
 
+        /// Same as intersectRay for the rays of mask, the tree is traversed once for the whole packet
+        /// The callback is uint32 (RayPacket& packet, uint32 entry, uint32 mask, bool stopAtFirst), it returns the rays of mask hitting
+        /// the entry and lowers their MaxDist. With stopAtFirst, a ray is no longer tested once it hit something
+        template<typename RayPacketCallback>
+        void intersectRays(RayPacket& packet, RayPacketCallback& intersectCallback, uint32 mask, bool stopAtFirst=false) const
+        {
+            // current is one of these two nodes or a node of the stack, the nearest child of an interior node is written in the other one
+            PacketNode scratch[2];
+            memset(&scratch[0], 0, sizeof(scratch[0]));
+            PacketNode* current = &scratch[0];
+
+            // clip each ray to the tree bounds, like intersectRay
+            for (uint32 i = 0; i < packet.Count; ++i)
+            {
+                if (!(mask & (1u << i)))
+                    continue;
+
+                float intervalMin = -1.0f;
+                float intervalMax = -1.0f;
+                bool outside = false;
+                for (int axis = 0; axis < 3 && !outside; ++axis)
+                {
+                    if (G3D::fuzzyNe(packet.Direction[axis][i], 0.0f))
+                    {
+                        float t1 = (bounds.low()[axis]  - packet.Origin[axis][i]) * packet.InvDirection[axis][i];
+                        float t2 = (bounds.high()[axis] - packet.Origin[axis][i]) * packet.InvDirection[axis][i];
+                        if (t1 > t2)
+                            std::swap(t1, t2);
+                        if (t1 > intervalMin)
+                            intervalMin = t1;
+                        if (t2 < intervalMax || intervalMax < 0.0f)
+                            intervalMax = t2;
+                        if (intervalMax <= 0 || intervalMin >= packet.MaxDist[i])
+                            outside = true;
+                    }
+                }
+
+                if (outside || intervalMin > intervalMax)
+                    continue;
+
+                current->tnear[i] = std::max(intervalMin, 0.0f);
+                current->tfar[i] = std::min(intervalMax, packet.MaxDist[i]);
+                current->mask |= 1u << i;
+            }
+
+            // the farthest child of an interior node is written in the free slot of the stack before being pushed, so one more node
+            PacketNode stack[MAX_STACK_SIZE + 1];
+            int stackPos = 0;
+            uint32 finished = 0;    // rays that hit something with stopAtFirst
+
+            while (true)
+            {
+                while (current->mask)
+                {
+                    uint32 tn = tree[current->node];
+                    uint32 axis = (tn & (3 << 30)) >> 30;
+                    bool BVH2 = (tn & (1 << 29)) != 0;
+                    int offset = tn & ~(7 << 29);
+                    if (!BVH2)
+                    {
+                        if (axis < 3)
+                        {
+                            // "normal" interior node, each ray goes to the nodes it would visit alone
+                            // the node in front of most rays is visited first, the other one is kept for later
+                            uint32 negative = packet.NegativeMask[axis] & current->mask;
+                            bool rightFirst = RayPacket::CountRays(negative) * 2 > RayPacket::CountRays(current->mask);
+                            PacketNode* nearNode = current == &scratch[0] ? &scratch[1] : &scratch[0];
+                            PacketNode* farNode = &stack[stackPos];
+
+                            splitPacket(packet, axis, intBitsToFloat(tree[current->node + 1]), intBitsToFloat(tree[current->node + 2]), *current,
+                                rightFirst ? *farNode : *nearNode, rightFirst ? *nearNode : *farNode);
+                            nearNode->node = rightFirst ? offset + 3 : offset;
+                            farNode->node = rightFirst ? offset : offset + 3;
+
+                            if (nearNode->mask && farNode->mask)
+                                stackPos++;
+
+                            current = nearNode->mask ? nearNode : farNode;
+                            continue;
+                        }
+                        else
+                        {
+                            // leaf - test some objects
+                            int n = tree[current->node + 1];
+                            while (n > 0 && current->mask) {
+                                uint32 hits = intersectCallback(packet, objects[offset], current->mask, stopAtFirst);
+                                if (stopAtFirst && hits)
+                                {
+                                    finished |= hits;
+                                    current->mask &= ~hits;
+                                }
+                                --n;
+                                ++offset;
+                            }
+                            break;
+                        }
+                    }
+                    else
+                    {
+                        if (axis>2)
+                            return; // should not happen
+                        clipPacket(packet, axis, intBitsToFloat(tree[current->node + 1]), intBitsToFloat(tree[current->node + 2]), *current);
+                        current->node = offset;
+                        continue;
+                    }
+                } // traversal loop
+                do
+                {
+                    // stack is empty?
+                    if (stackPos == 0)
+                        return;
+                    // move back up the stack, skipping the rays already done or whose closest hit is before the node
+                    stackPos--;
+                    current = &stack[stackPos];
+                    current->mask &= ~finished;
+                    for (uint32 i = 0; i < packet.Count; ++i)
+                    {
+                        if ((current->mask & (1u << i)) && packet.MaxDist[i] < current->tnear[i])
+                            current->mask &= ~(1u << i);
+                    }
+                } while (!current->mask);
+            }
+        }
+
         template<typename IsectCallback>
         void intersectPoint(const G3D::Vector3 &p, IsectCallback& intersectCallback) const
         {
@@ -340,6 +465,138 @@ class BIH
             float tnear;
             float tfar;
         };
+        struct PacketNode
+        {
+            uint32 node;
+            uint32 mask;
+            float tnear[RayPacket::MAX_RAYS];
+            float tfar[RayPacket::MAX_RAYS];
+        };
+
+        /// Rays of current entering the left and the right child of an interior node, with their clipped intervals
+        /// current may be the same node as left or right
+        static void splitPacket(RayPacket const& packet, uint32 axis, float leftPlane, float rightPlane, PacketNode const& current, PacketNode& left, PacketNode& right)
+        {
+            uint32 mask = current.mask;
+            left.mask = 0;
+            right.mask = 0;
+
+            for (uint32 i = 0; i < RayPacket::MAX_RAYS; i += 4)
+            {
+                uint32 group = (mask >> i) & 0xF;
+                if (!group)
+                    continue;
+#ifdef RAY_PACKET_SSE
+                __m128 neg = _mm_castsi128_ps(_mm_loadu_si128(reinterpret_cast<__m128i const*>(&packet.Negative[axis][i])));
+                __m128 org = _mm_loadu_ps(&packet.Origin[axis][i]);
+                __m128 inv = _mm_loadu_ps(&packet.InvDirection[axis][i]);
+                __m128 tl = _mm_mul_ps(_mm_sub_ps(_mm_set1_ps(leftPlane), org), inv);
+                __m128 tr = _mm_mul_ps(_mm_sub_ps(_mm_set1_ps(rightPlane), org), inv);
+                // front plane is the left one for positive directions
+                __m128 tf = selectLanes(neg, tr, tl);
+                __m128 tb = selectLanes(neg, tl, tr);
+                __m128 tnear = _mm_loadu_ps(&current.tnear[i]);
+                __m128 tfar = _mm_loadu_ps(&current.tfar[i]);
+
+                // comparisons are written as in intersectRay, a NaN distance enters both nodes
+                uint32 front = ~_mm_movemask_ps(_mm_cmplt_ps(tf, tnear)) & 0xF;
+                uint32 back = ~_mm_movemask_ps(_mm_cmpgt_ps(tb, tfar)) & 0xF;
+                __m128 frontFar = selectLanes(_mm_cmple_ps(tf, tfar), tf, tfar);
+                __m128 backNear = selectLanes(_mm_cmpge_ps(tb, tnear), tb, tnear);
+                uint32 negBits = _mm_movemask_ps(neg);
+
+                _mm_storeu_ps(&left.tnear[i], selectLanes(neg, backNear, tnear));
+                _mm_storeu_ps(&left.tfar[i], selectLanes(neg, tfar, frontFar));
+                _mm_storeu_ps(&right.tnear[i], selectLanes(neg, tnear, backNear));
+                _mm_storeu_ps(&right.tfar[i], selectLanes(neg, frontFar, tfar));
+
+                left.mask |= (((negBits & back) | (~negBits & front)) & group) << i;
+                right.mask |= (((negBits & front) | (~negBits & back)) & group) << i;
+#else
+                for (uint32 j = i; j < i + 4; ++j)
+                {
+                    if (!(group & (1u << (j - i))))
+                        continue;
+
+                    bool neg = packet.Negative[axis][j] != 0;
+                    float tl = (leftPlane - packet.Origin[axis][j]) * packet.InvDirection[axis][j];
+                    float tr = (rightPlane - packet.Origin[axis][j]) * packet.InvDirection[axis][j];
+                    float tf = neg ? tr : tl;
+                    float tb = neg ? tl : tr;
+                    float tnear = current.tnear[j];
+                    float tfar = current.tfar[j];
+
+                    bool front = !(tf < tnear);
+                    bool back = !(tb > tfar);
+                    float frontFar = (tf <= tfar) ? tf : tfar;
+                    float backNear = (tb >= tnear) ? tb : tnear;
+
+                    left.tnear[j] = neg ? backNear : tnear;
+                    left.tfar[j] = neg ? tfar : frontFar;
+                    right.tnear[j] = neg ? tnear : backNear;
+                    right.tfar[j] = neg ? frontFar : tfar;
+
+                    if (neg ? back : front)
+                        left.mask |= 1u << j;
+                    if (neg ? front : back)
+                        right.mask |= 1u << j;
+                }
+#endif
+            }
+        }
+
+        /// Clip the intervals of the rays of current to a BVH2 node, rays leaving the node are removed
+        static void clipPacket(RayPacket const& packet, uint32 axis, float leftPlane, float rightPlane, PacketNode& current)
+        {
+            for (uint32 i = 0; i < RayPacket::MAX_RAYS; i += 4)
+            {
+                uint32 group = (current.mask >> i) & 0xF;
+                if (!group)
+                    continue;
+#ifdef RAY_PACKET_SSE
+                __m128 neg = _mm_castsi128_ps(_mm_loadu_si128(reinterpret_cast<__m128i const*>(&packet.Negative[axis][i])));
+                __m128 org = _mm_loadu_ps(&packet.Origin[axis][i]);
+                __m128 inv = _mm_loadu_ps(&packet.InvDirection[axis][i]);
+                __m128 tl = _mm_mul_ps(_mm_sub_ps(_mm_set1_ps(leftPlane), org), inv);
+                __m128 tr = _mm_mul_ps(_mm_sub_ps(_mm_set1_ps(rightPlane), org), inv);
+                __m128 tf = selectLanes(neg, tr, tl);
+                __m128 tb = selectLanes(neg, tl, tr);
+                __m128 tnear = _mm_loadu_ps(&current.tnear[i]);
+                __m128 tfar = _mm_loadu_ps(&current.tfar[i]);
+
+                tnear = selectLanes(_mm_cmpge_ps(tf, tnear), tf, tnear);
+                tfar = selectLanes(_mm_cmple_ps(tb, tfar), tb, tfar);
+                _mm_storeu_ps(&current.tnear[i], tnear);
+                _mm_storeu_ps(&current.tfar[i], tfar);
+
+                current.mask &= ~((uint32(_mm_movemask_ps(_mm_cmpgt_ps(tnear, tfar))) & group) << i);
+#else
+                for (uint32 j = i; j < i + 4; ++j)
+                {
+                    if (!(group & (1u << (j - i))))
+                        continue;
+
+                    bool neg = packet.Negative[axis][j] != 0;
+                    float tl = (leftPlane - packet.Origin[axis][j]) * packet.InvDirection[axis][j];
+                    float tr = (rightPlane - packet.Origin[axis][j]) * packet.InvDirection[axis][j];
+                    float tf = neg ? tr : tl;
+                    float tb = neg ? tl : tr;
+
+                    current.tnear[j] = (tf >= current.tnear[j]) ? tf : current.tnear[j];
+                    current.tfar[j] = (tb <= current.tfar[j]) ? tb : current.tfar[j];
+                    if (current.tnear[j] > current.tfar[j])
+                        current.mask &= ~(1u << j);
+                }
+#endif
+            }
+        }
+
+#ifdef RAY_PACKET_SSE
+        static __m128 selectLanes(__m128 mask, __m128 a, __m128 b)
+        {
+            return _mm_or_ps(_mm_and_ps(mask, a), _mm_andnot_ps(mask, b));
+        }
+#endif
 
         class BuildStats
         {
@@ -0,0 +1,408 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+//  MILLENIUM-STUDIO
+//  Copyright 2016 Millenium-studio SARL
+//  All Rights Reserved.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef _DYNAMIC_BVH_H
+#define _DYNAMIC_BVH_H
+
+#include <G3D/Ray.h>
+#include <G3D/AABox.h>
+#include <G3D/BoundsTrait.h>
+
+#include "Define.h"
+#include "Errors.h"
+
+#include <algorithm>
+#include <unordered_map>
+#include <vector>
+
+/// Bounding volume hierarchy updated one object at a time
+/// - Leaves hold the bound of their object enlarged by a margin, an object moving inside it doesn't change the tree
+/// - An object leaving it is removed and inserted again, only the nodes above it are refitted
+/// - Nodes are rotated on the way up like an AVL tree, the height stays in O(log n) without any full rebuild
+template<class T, class BoundsFunc = BoundsTrait<T> >
+class DynamicBVH
+{
+    public:
+        explicit DynamicBVH(float margin = 1.0f) : root(NULL_NODE), freeList(NULL_NODE), margin(margin), rotations(0) { }
+
+        void insert(const T& obj)
+        {
+            int32 leaf = allocateNode();
+            nodes[leaf].object = &obj;
+            nodes[leaf].bound = fatBound(obj);
+            insertLeaf(leaf);
+            leaves[&obj] = leaf;
+        }
+
+        void remove(const T& obj)
+        {
+            typename LeafMap::iterator itr = leaves.find(&obj);
+            if (itr == leaves.end())
+                return;
+
+            removeLeaf(itr->second);
+            freeNode(itr->second);
+            leaves.erase(itr);
+        }
+
+        /// Must be called when the bound of obj changed, return true if obj left its leaf and was inserted again
+        bool update(const T& obj)
+        {
+            typename LeafMap::const_iterator itr = leaves.find(&obj);
+            if (itr == leaves.end())
+                return false;
+
+            G3D::AABox bound;
+            BoundsFunc::getBounds(obj, bound);
+
+            int32 leaf = itr->second;
+            if (nodes[leaf].bound.contains(bound))
+                return false;
+
+            removeLeaf(leaf);
+            nodes[leaf].bound = fatBound(obj);
+            insertLeaf(leaf);
+            return true;
+        }
+
+        bool contains(const T& obj) const { return leaves.find(&obj) != leaves.end(); }
+        int size() const { return int(leaves.size()); }
+        int height() const { return root == NULL_NODE ? 0 : nodes[root].height; }
+        uint64 getRotationCount() const { return rotations; }
+
+        /// Objects are tested front to back, the callback is bool (const G3D::Ray& ray, const T& obj, float& maxDist)
+        template<typename RayCallback>
+        void intersectRay(const G3D::Ray& ray, RayCallback& intersectCallback, float& maxDist, bool stopAtFirst) const
+        {
+            if (root == NULL_NODE)
+                return;
+
+            // a child is pushed only if its parent is on the path, so the stack never holds more than height + 1 nodes
+            StackNode stack[MAX_HEIGHT + 1];
+            int stackPos = 0;
+
+            if (intersectBound(ray, nodes[root].bound, maxDist, stack[0].tnear))
+            {
+                stack[0].node = root;
+                ++stackPos;
+            }
+
+            while (stackPos)
+            {
+                --stackPos;
+
+                // maxDist may have been lowered by a closer hit since the push
+                if (stack[stackPos].tnear > maxDist)
+                    continue;
+
+                const Node& node = nodes[stack[stackPos].node];
+
+                if (node.isLeaf())
+                {
+                    if (intersectCallback(ray, *node.object, maxDist) && stopAtFirst)
+                        return;
+                    continue;
+                }
+
+                float tnear1, tnear2;
+                bool hit1 = intersectBound(ray, nodes[node.child1].bound, maxDist, tnear1);
+                bool hit2 = intersectBound(ray, nodes[node.child2].bound, maxDist, tnear2);
+
+                // the nearest child is popped first
+                if (hit1 && hit2 && tnear1 <= tnear2)
+                {
+                    push(stack, stackPos, node.child2, tnear2);
+                    push(stack, stackPos, node.child1, tnear1);
+                }
+                else if (hit1 && hit2)
+                {
+                    push(stack, stackPos, node.child1, tnear1);
+                    push(stack, stackPos, node.child2, tnear2);
+                }
+                else if (hit1)
+                    push(stack, stackPos, node.child1, tnear1);
+                else if (hit2)
+                    push(stack, stackPos, node.child2, tnear2);
+            }
+        }
+
+    private:
+        enum
+        {
+            NULL_NODE  = -1,
+            MAX_HEIGHT = 64     // an AVL tree of that height would hold billions of objects
+        };
+
+        struct Node
+        {
+            G3D::AABox bound;
+            const T* object;    // NULL for internal nodes
+            int32 parent;       // next free node once freed
+            int32 child1;
+            int32 child2;
+            int32 height;       // 0 for leaves
+
+            bool isLeaf() const { return child1 == NULL_NODE; }
+        };
+
+        typedef std::unordered_map<const T*, int32> LeafMap;
+
+        struct StackNode
+        {
+            int32 node;
+            float tnear;
+        };
+
+        static void push(StackNode* stack, int& stackPos, int32 node, float tnear)
+        {
+            ASSERT(stackPos <= MAX_HEIGHT);
+            stack[stackPos].node = node;
+            stack[stackPos].tnear = tnear;
+            ++stackPos;
+        }
+
+        G3D::AABox fatBound(const T& obj) const
+        {
+            G3D::AABox bound;
+            BoundsFunc::getBounds(obj, bound);
+
+            G3D::Vector3 extra(margin, margin, margin);
+            return G3D::AABox(bound.low() - extra, bound.high() + extra);
+        }
+
+        static G3D::AABox mergeBounds(const G3D::AABox& a, const G3D::AABox& b)
+        {
+            return G3D::AABox(a.low().min(b.low()), a.high().max(b.high()));
+        }
+
+        /// Slab test, a ray parallel to a slab and starting on one of its planes gives a NaN and is kept
+        static bool intersectBound(const G3D::Ray& ray, const G3D::AABox& bound, float maxDist, float& tnear)
+        {
+            float tmin = 0.0f;
+            float tmax = maxDist;
+            for (int axis = 0; axis < 3; ++axis)
+            {
+                float t1 = (bound.low()[axis] - ray.origin()[axis]) * ray.invDirection()[axis];
+                float t2 = (bound.high()[axis] - ray.origin()[axis]) * ray.invDirection()[axis];
+                if (t1 > t2)
+                    std::swap(t1, t2);
+                if (t1 > tmin)
+                    tmin = t1;
+                if (t2 < tmax)
+                    tmax = t2;
+                if (tmin > tmax)
+                    return false;
+            }
+
+            tnear = tmin;
+            return true;
+        }
+
+        int32 allocateNode()
+        {
+            int32 index;
+            if (freeList != NULL_NODE)
+            {
+                index = freeList;
+                freeList = nodes[index].parent;
+            }
+            else
+            {
+                index = int32(nodes.size());
+                nodes.push_back(Node());
+            }
+
+            Node& node = nodes[index];
+            node.object = NULL;
+            node.parent = NULL_NODE;
+            node.child1 = NULL_NODE;
+            node.child2 = NULL_NODE;
+            node.height = 0;
+            return index;
+        }
+
+        void freeNode(int32 index)
+        {
+            nodes[index].object = NULL;
+            nodes[index].parent = freeList;
+            nodes[index].height = -1;
+            freeList = index;
+        }
+
+        // cheapest sibling by surface area, the cost of a node is the growth of the area of all its ancestors
+        void insertLeaf(int32 leaf)
+        {
+            if (root == NULL_NODE)
+            {
+                root = leaf;
+                nodes[root].parent = NULL_NODE;
+                return;
+            }
+
+            G3D::AABox leafBound = nodes[leaf].bound;
+            int32 index = root;
+            while (!nodes[index].isLeaf())
+            {
+                const Node& node = nodes[index];
+                float area = node.bound.area();
+                float combinedArea = mergeBounds(node.bound, leafBound).area();
+
+                // cost of a new parent for this node and the leaf, and the minimum cost of going further down
+                float cost = 2.0f * combinedArea;
+                float inheritanceCost = 2.0f * (combinedArea - area);
+
+                float cost1 = descentCost(node.child1, leafBound) + inheritanceCost;
+                float cost2 = descentCost(node.child2, leafBound) + inheritanceCost;
+
+                if (cost < cost1 && cost < cost2)
+                    break;
+
+                index = cost1 < cost2 ? node.child1 : node.child2;
+            }
+
+            int32 sibling = index;
+            int32 oldParent = nodes[sibling].parent;
+            int32 newParent = allocateNode();
+
+            nodes[newParent].parent = oldParent;
+            nodes[newParent].bound = mergeBounds(leafBound, nodes[sibling].bound);
+            nodes[newParent].height = nodes[sibling].height + 1;
+            nodes[newParent].child1 = sibling;
+            nodes[newParent].child2 = leaf;
+            nodes[sibling].parent = newParent;
+            nodes[leaf].parent = newParent;
+
+            if (oldParent == NULL_NODE)
+                root = newParent;
+            else if (nodes[oldParent].child1 == sibling)
+                nodes[oldParent].child1 = newParent;
+            else
+                nodes[oldParent].child2 = newParent;
+
+            refit(newParent);
+        }
+
+        float descentCost(int32 index, const G3D::AABox& leafBound) const
+        {
+            float combinedArea = mergeBounds(nodes[index].bound, leafBound).area();
+            if (nodes[index].isLeaf())
+                return combinedArea;
+
+            return combinedArea - nodes[index].bound.area();
+        }
+
+        void removeLeaf(int32 leaf)
+        {
+            if (leaf == root)
+            {
+                root = NULL_NODE;
+                return;
+            }
+
+            int32 parent = nodes[leaf].parent;
+            int32 grandParent = nodes[parent].parent;
+            int32 sibling = nodes[parent].child1 == leaf ? nodes[parent].child2 : nodes[parent].child1;
+
+            nodes[sibling].parent = grandParent;
+            nodes[leaf].parent = NULL_NODE;
+            freeNode(parent);
+
+            if (grandParent == NULL_NODE)
+            {
+                root = sibling;
+                return;
+            }
+
+            if (nodes[grandParent].child1 == parent)
+                nodes[grandParent].child1 = sibling;
+            else
+                nodes[grandParent].child2 = sibling;
+
+            refit(grandParent);
+        }
+
+        // recompute the bounds and heights from index up to the root, rotating unbalanced nodes
+        void refit(int32 index)
+        {
+            while (index != NULL_NODE)
+            {
+                index = rebalance(index);
+
+                Node& node = nodes[index];
+                node.height = 1 + std::max(nodes[node.child1].height, nodes[node.child2].height);
+                node.bound = mergeBounds(nodes[node.child1].bound, nodes[node.child2].bound);
+
+                index = node.parent;
+            }
+        }
+
+        // if a child of a is 2 levels higher than the other one, it takes the place of a. Return the node now at the place of a
+        int32 rebalance(int32 a)
+        {
+            if (nodes[a].isLeaf() || nodes[a].height < 2)
+                return a;
+
+            int32 b = nodes[a].child1;
+            int32 c = nodes[a].child2;
+            int32 balance = nodes[c].height - nodes[b].height;
+
+            if (balance > 1)
+                return rotate(a, c, b);
+
+            if (balance < -1)
+                return rotate(a, b, c);
+
+            return a;
+        }
+
+        // the high child replaces a, a takes the place of the lowest child of high and gets it as its child instead of high
+        int32 rotate(int32 a, int32 high, int32 low)
+        {
+            int32 f = nodes[high].child1;
+            int32 g = nodes[high].child2;
+
+            nodes[high].child1 = a;
+            nodes[high].parent = nodes[a].parent;
+            nodes[a].parent = high;
+
+            if (nodes[high].parent == NULL_NODE)
+                root = high;
+            else if (nodes[nodes[high].parent].child1 == a)
+                nodes[nodes[high].parent].child1 = high;
+            else
+                nodes[nodes[high].parent].child2 = high;
+
+            // the highest grandchild stays below high, the other one goes below a
+            int32 keep = nodes[f].height > nodes[g].height ? f : g;
+            int32 move = keep == f ? g : f;
+
+            nodes[high].child2 = keep;
+            if (nodes[a].child1 == high)
+                nodes[a].child1 = move;
+            else
+                nodes[a].child2 = move;
+            nodes[move].parent = a;
+
+            nodes[a].bound = mergeBounds(nodes[low].bound, nodes[move].bound);
+            nodes[a].height = 1 + std::max(nodes[low].height, nodes[move].height);
+            nodes[high].bound = mergeBounds(nodes[a].bound, nodes[keep].bound);
+            nodes[high].height = 1 + std::max(nodes[a].height, nodes[keep].height);
+
+            ++rotations;
+            return high;
+        }
+
+        std::vector<Node> nodes;
+        LeafMap leaves;
+        int32 root;
+        int32 freeList;
+        float margin;
+        uint64 rotations;
+};
+
+#endif // _DYNAMIC_BVH_H
@@ -7,13 +7,10 @@
 ////////////////////////////////////////////////////////////////////////////////
 
 #include "DynamicTree.h"
-//#include "QuadTree.h"
-//#include "RegularGrid.h"
-#include "BoundingIntervalHierarchyWrapper.h"
+#include "DynamicBoundingVolumeHierarchy.h"
 
+#include "Errors.h"
 #include "Log.h"
-#include "RegularGrid.h"
-#include "Timer.h"
 #include "GameObjectModel.h"
 #include "ModelInstance.h"
 
@@ -21,80 +18,64 @@
 #include <G3D/Ray.h>
 #include <G3D/Vector3.h>
 
-using VMAP::ModelInstance;
-
-namespace {
-
-int CHECK_TREE_PERIOD = 200;
-
-} // namespace
+#include <chrono>
 
-template<> struct HashTrait< GameObjectModel>{
-    static size_t hashCode(const GameObjectModel& g) { return (size_t)(void*)&g; }
-};
-
-template<> struct PositionTrait< GameObjectModel> {
-    static void getPosition(const GameObjectModel& g, G3D::Vector3& p) { p = g.getPosition(); }
-};
+using VMAP::ModelInstance;
 
 template<> struct BoundsTrait< GameObjectModel> {
     static void getBounds(const GameObjectModel& g, G3D::AABox& out) { out = g.getBounds();}
-    static void getBounds2(const GameObjectModel* g, G3D::AABox& out) { out = g->getBounds();}
 };
 
-/*
-static bool operator == (const GameObjectModel& mdl, const GameObjectModel& mdl2){
-    return &mdl == &mdl2;
-}
-*/
-
-typedef RegularGrid2D<GameObjectModel, BIHWrap<GameObjectModel> > ParentTree;
-
-struct DynTreeImpl : public ParentTree/*, public Intersectable*/
+struct DynTreeImpl : public DynamicBVH<GameObjectModel>
 {
     typedef GameObjectModel Model;
-    typedef ParentTree base;
+    typedef DynamicBVH<GameObjectModel> base;
+
+    DynTreeImpl() : insertCount(0), removeCount(0), moveCount(0), reinsertCount(0), changeTime(0), maxChangeTime(0) { }
 
-    DynTreeImpl() :
-        rebalance_timer(CHECK_TREE_PERIOD),
-        unbalanced_times(0)
+    /// Time spent in the tree, the changes are only timed to be reported by DynamicMapTree::getStats
+    struct ChangeTimer
     {
-    }
+        ChangeTimer(DynTreeImpl& tree) : tree(tree), start(std::chrono::steady_clock::now()) { }
+        ~ChangeTimer()
+        {
+            uint32 elapsed = uint32(std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count());
+            tree.changeTime += elapsed;
+            tree.maxChangeTime = std::max(tree.maxChangeTime, elapsed);
+        }
+
+        DynTreeImpl& tree;
+        std::chrono::steady_clock::time_point start;
+    };
 
     void insert(const Model& mdl)
     {
+        ChangeTimer timer(*this);
         base::insert(mdl);
-        ++unbalanced_times;
+        ++insertCount;
     }
 
     void remove(const Model& mdl)
     {
+        ChangeTimer timer(*this);
         base::remove(mdl);
-        ++unbalanced_times;
+        ++removeCount;
     }
 
-    void balance()
+    void relocate(const Model& mdl)
     {
-        base::balance();
-        unbalanced_times = 0;
+        ChangeTimer timer(*this);
+        if (base::update(mdl))
+            ++reinsertCount;
+        ++moveCount;
     }
 
-    void update(uint32 difftime)
-    {
-        if (!size())
-            return;
-
-        rebalance_timer.Update(difftime);
-        if (rebalance_timer.Passed())
-        {
-            rebalance_timer.Reset(CHECK_TREE_PERIOD);
-            if (unbalanced_times > 0)
-                balance();
-        }
-    }
-
-    TimeTrackerSmall rebalance_timer;
-    int unbalanced_times;
+    uint64 insertCount;
+    uint64 removeCount;
+    uint64 moveCount;
+    uint64 reinsertCount;
+    uint64 changeTime;
+    uint32 maxChangeTime;
 };
 
 DynamicMapTree::DynamicMapTree() : impl(new DynTreeImpl()) { }
@@ -114,14 +95,14 @@ void DynamicMapTree::remove(const GameObjectModel& mdl)
     impl->remove(mdl);
 }
 
-bool DynamicMapTree::contains(const GameObjectModel& mdl) const
+void DynamicMapTree::relocate(const GameObjectModel& mdl)
 {
-    return impl->contains(mdl);
+    impl->relocate(mdl);
 }
 
-void DynamicMapTree::balance()
+bool DynamicMapTree::contains(const GameObjectModel& mdl) const
 {
-    impl->balance();
+    return impl->contains(mdl);
 }
 
 int DynamicMapTree::size() const
@@ -129,9 +110,17 @@ int DynamicMapTree::size() const
     return impl->size();
 }
 
-void DynamicMapTree::update(uint32 t_diff)
+void DynamicMapTree::getStats(DynamicTreeStats& stats) const
 {
-    impl->update(t_diff);
+    stats.ModelCount    = impl->size();
+    stats.Height        = impl->height();
+    stats.InsertCount   = impl->insertCount;
+    stats.RemoveCount   = impl->removeCount;
+    stats.MoveCount     = impl->moveCount;
+    stats.ReinsertCount = impl->reinsertCount;
+    stats.RotationCount = impl->getRotationCount();
+    stats.ChangeTime    = impl->changeTime;
+    stats.MaxChangeTime = impl->maxChangeTime;
 }
 
 struct DynamicTreeIntersectionCallback
@@ -170,11 +159,11 @@ struct DynamicTreeIntersectionCallback_WithLogger
 };
 
 bool DynamicMapTree::getIntersectionTime(const uint32 phasemask, const G3D::Ray& ray,
-                                         const G3D::Vector3& endPos, float& maxDist) const
+                                         float& maxDist) const
 {
     float distance = maxDist;
     DynamicTreeIntersectionCallback callback(phasemask);
-    impl->intersectRay(ray, callback, distance, endPos);
+    impl->intersectRay(ray, callback, distance, true);
     if (callback.didHit())
         maxDist = distance;
     return callback.didHit();
@@ -197,7 +186,7 @@ bool DynamicMapTree::getObjectHitPos(const uint32 phasemask, const G3D::Vector3&
     G3D::Vector3 dir = (endPos - startPos)/maxDist;              // direction with length of 1
     G3D::Ray ray(startPos, dir);
     float dist = maxDist;
-    if (getIntersectionTime(phasemask, ray, endPos, dist))
+    if (getIntersectionTime(phasemask, ray, dist))
     {
         resultHit = startPos + dir * dist;
         if (modifyDist < 0)
@@ -231,7 +220,7 @@ bool DynamicMapTree::isInLineOfSight(float x1, float y1, float z1, float x2, flo
 
     G3D::Ray r(v1, (v2-v1) / maxDist);
     DynamicTreeIntersectionCallback callback(phasemask);
-    impl->intersectRay(r, callback, maxDist, v2);
+    impl->intersectRay(r, callback, maxDist, true);
 
     return !callback.did_hit;
 }
@@ -241,7 +230,7 @@ float DynamicMapTree::getHeight(float x, float y, float z, float maxSearchDist,
     G3D::Vector3 v(x, y, z);
     G3D::Ray r(v, G3D::Vector3(0, 0, -1));
     DynamicTreeIntersectionCallback callback(phasemask);
-    impl->intersectZAllignedRay(r, callback, maxSearchDist);
+    impl->intersectRay(r, callback, maxSearchDist, true);
 
     if (callback.didHit())
         return v.z - maxSearchDist;
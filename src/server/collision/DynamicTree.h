@@ -21,6 +21,20 @@ namespace G3D
 class GameObjectModel;
 struct DynTreeImpl;
 
+/// Changes of the gameobject models of a map since it was created
+struct DynamicTreeStats
+{
+    uint32 ModelCount;
+    uint32 Height;
+    uint64 InsertCount;
+    uint64 RemoveCount;
+    uint64 MoveCount;
+    uint64 ReinsertCount;       ///< Moves out of the margin of the model leaf
+    uint64 RotationCount;
+    uint64 ChangeTime;          ///< Microseconds spent in inserts, removes and moves
+    uint32 MaxChangeTime;       ///< Microseconds, slowest change
+};
+
 class DynamicMapTree
 {
     DynTreeImpl *impl;
@@ -34,7 +48,7 @@ public:
                          float z2, uint32 phasemask) const;
 
     bool getIntersectionTime(uint32 phasemask, const G3D::Ray& ray,
-                             const G3D::Vector3& endPos, float& maxDist) const;
+                             float& maxDist) const;
 
     bool getObjectHitPos(uint32 phasemask, const G3D::Vector3& pPos1,
                          const G3D::Vector3& pPos2, G3D::Vector3& pResultHitPos,
@@ -44,11 +58,12 @@ public:
 
     void insert(const GameObjectModel&);
     void remove(const GameObjectModel&);
+    /// Must be called once the model bounds changed
+    void relocate(const GameObjectModel&);
     bool contains(const GameObjectModel&) const;
     int size() const;
 
-    void balance();
-    void update(uint32 diff);
+    void getStats(DynamicTreeStats& stats) const;
 };
 
 #endif // _DYNTREE_H
@@ -12,6 +12,11 @@
 #include "Common.h"
 #include "Define.h"
 
+namespace G3D
+{
+    class Vector3;
+}
+
 //===========================================================
 
 /**
@@ -51,6 +56,10 @@ namespace VMAP
             virtual void unloadMap(unsigned int pMapId) = 0;
 
             virtual bool isInLineOfSight(unsigned int pMapId, float x1, float y1, float z1, float x2, float y2, float z2) = 0;
+            /**
+            isInLineOfSight for pCount pairs of positions, pResults[i] is the line of sight between pStarts[i] and pEnds[i]
+            */
+            virtual void isInLineOfSight(unsigned int pMapId, G3D::Vector3 const* pStarts, G3D::Vector3 const* pEnds, uint32 pCount, bool* pResults) = 0;
             virtual float getHeight(unsigned int pMapId, float x, float y, float z, float maxSearchDist) = 0;
             /**
             test if we hit an object. return true if we hit one. rx, ry, rz will hold the hit position or the dest position, if no intersection was found
@@ -160,30 +160,57 @@ namespace MMAP
             return false;
         }
 
-        unsigned char* data = (unsigned char*)dtAlloc(fileHeader.size, DT_ALLOC_PERM);
-        ASSERT(data);
+        PhaseChildMapContainer::const_iterator phasedMaps = phaseMapData.find(mapId);
 
-        size_t result = fread(data, fileHeader.size, 1, file);
-        if (!result)
+        unsigned char* data = NULL;
+        MappedFile* mappedFile = NULL;
+
+        if (memoryMappedTiles && phasedMaps == phaseMapData.end())
         {
-            sLog->outError(LOG_FILTER_GENERAL, "MMAP:loadMap: Bad header or data in mmap %04u%02i%02i.mmtile", mapId, x, y);
             fclose(file);
-            return false;
+
+            // detour writes the tile links in place, those pages become private copies
+            mappedFile = new MappedFile();
+            if (!mappedFile->Open(fileName, true) || mappedFile->GetSize() < sizeof(MmapTileHeader) + fileHeader.size)
+            {
+                sLog->outError(LOG_FILTER_GENERAL, "MMAP:loadMap: Could not map %04u%02i%02i.mmtile", mapId, x, y);
+                delete mappedFile;
+                return false;
+            }
+
+            data = (unsigned char*)(mappedFile->GetData() + sizeof(MmapTileHeader));
         }
+        else
+        {
+            data = (unsigned char*)dtAlloc(fileHeader.size, DT_ALLOC_PERM);
+            ASSERT(data);
 
-        fclose(file);
+            size_t result = fread(data, fileHeader.size, 1, file);
+            if (!result)
+            {
+                sLog->outError(LOG_FILTER_GENERAL, "MMAP:loadMap: Bad header or data in mmap %04u%02i%02i.mmtile", mapId, x, y);
+                fclose(file);
+                dtFree(data);
+                return false;
+            }
+
+            fclose(file);
+        }
 
         dtMeshHeader* header = (dtMeshHeader*)data;
         dtTileRef tileRef = 0;
 
         // memory allocated for data is now managed by detour, and will be deallocated when the tile is removed
-        if (dtStatusSucceed(mmap->navMesh->addTile(data, fileHeader.size, DT_TILE_FREE_DATA, 0, &tileRef)))
+        // mapped data stays owned by the MappedFile, released by unloadMap
+        if (dtStatusSucceed(mmap->navMesh->addTile(data, fileHeader.size, mappedFile ? 0 : DT_TILE_FREE_DATA, 0, &tileRef)))
         {
+            if (mappedFile)
+                mmap->mappedTiles[packedGridPos] = mappedFile;
+
             mmap->loadedTileRefs.insert(std::pair<uint32, dtTileRef>(packedGridPos, tileRef));
             ++loadedTiles;
             sLog->outDebug(LOG_FILTER_GENERAL, "MMAP:loadMap: Loaded mmtile %04i[%02i, %02i] into %04i[%02i, %02i]", mapId, x, y, mapId, header->x, header->y);
 
-            PhaseChildMapContainer::const_iterator phasedMaps = phaseMapData.find(mapId);
             if (phasedMaps != phaseMapData.end())
                 LoadPhaseTiles(phasedMaps, x, y);
 
@@ -191,7 +218,10 @@ namespace MMAP
         }
 
         sLog->outError(LOG_FILTER_GENERAL, "MMAP:loadMap: Could not load %04u%02i%02i.mmtile into navmesh", mapId, x, y);
-        dtFree(data);
+        if (mappedFile)
+            delete mappedFile;
+        else
+            dtFree(data);
         return false;
     }
 
@@ -322,6 +352,13 @@ namespace MMAP
         }
         else
         {
+            MappedTileSet::iterator mapped = mmap->mappedTiles.find(packedGridPos);
+            if (mapped != mmap->mappedTiles.end())
+            {
+                delete mapped->second;
+                mmap->mappedTiles.erase(mapped);
+            }
+
             mmap->loadedTileRefs.erase(packedGridPos);
             --loadedTiles;
             sLog->outDebug(LOG_FILTER_GENERAL, "MMAP:unloadMap: Unloaded mmtile %03i[%02i, %02i] from %04i", mapId, x, y, mapId);
@@ -432,6 +469,65 @@ namespace MMAP
         return mmap->navMeshQueries[instanceId];
     }
 
+    dtNavMeshQuery* MMapManager::AcquireNavMeshQuery(uint32 mapId)
+    {
+        MMapDataSet::const_iterator itr = GetMMapData(mapId);
+        if (itr == loadedMMaps.end())
+            return NULL;
+
+        MMapData* mmap = itr->second;
+
+        {
+            std::lock_guard<std::mutex> lock(mmap->queryPoolLock);
+            if (!mmap->queryPool.empty())
+            {
+                dtNavMeshQuery* query = mmap->queryPool.back();
+                mmap->queryPool.pop_back();
+                return query;
+            }
+        }
+
+        // pool is empty, one more thread is pathing on this map
+        dtNavMeshQuery* query = dtAllocNavMeshQuery();
+        ASSERT(query);
+        if (dtStatusFailed(query->init(mmap->navMesh, 1024)))
+        {
+            dtFreeNavMeshQuery(query);
+            sLog->outError(LOG_FILTER_GENERAL, "MMAP:AcquireNavMeshQuery: Failed to initialize pooled dtNavMeshQuery for mapId %04u", mapId);
+            return NULL;
+        }
+
+        sLog->outDebug(LOG_FILTER_GENERAL, "MMAP:AcquireNavMeshQuery: created pooled dtNavMeshQuery for mapId %04u", mapId);
+        return query;
+    }
+
+    void MMapManager::ReleaseNavMeshQuery(uint32 mapId, dtNavMeshQuery* query)
+    {
+        if (!query)
+            return;
+
+        MMapDataSet::const_iterator itr = GetMMapData(mapId);
+        if (itr == loadedMMaps.end())
+        {
+            // map has been unloaded meanwhile
+            dtFreeNavMeshQuery(query);
+            return;
+        }
+
+        std::lock_guard<std::mutex> lock(itr->second->queryPoolLock);
+        itr->second->queryPool.push_back(query);
+    }
+
+    NavMeshQueryHolder::NavMeshQueryHolder(MMapManager* manager, uint32 mapId)
+        : _manager(manager), _mapId(mapId), _query(manager->AcquireNavMeshQuery(mapId))
+    {
+    }
+
+    NavMeshQueryHolder::~NavMeshQueryHolder()
+    {
+        _manager->ReleaseNavMeshQuery(_mapId, _query);
+    }
+
     MMapData::MMapData(dtNavMesh* mesh, uint32 mapId)
     {
         navMesh = mesh;
@@ -443,8 +539,15 @@ namespace MMAP
         for (NavMeshQuerySet::iterator i = navMeshQueries.begin(); i != navMeshQueries.end(); ++i)
             dtFreeNavMeshQuery(i->second);
 
+        for (dtNavMeshQuery* query : queryPool)
+            dtFreeNavMeshQuery(query);
+
         dtFreeNavMesh(navMesh);
 
+        // tiles are gone, their mapped data can be released
+        for (MappedTileSet::iterator i = mappedTiles.begin(); i != mappedTiles.end(); ++i)
+            delete i->second;
+
         for (PhaseTileContainer::iterator i = _baseTiles.begin(); i != _baseTiles.end(); ++i)
         {
             delete (*i).second->data;
@@ -14,12 +14,14 @@
 #include "DetourNavMesh.h"
 #include "DetourNavMeshQuery.h"
 #include "MapDefines.h"
+#include "MappedFile.h"
 #include "Common.h"
 
 //  move map related classes
 namespace MMAP
 {
     typedef std::unordered_map<uint32, dtTileRef> MMapTileSet;
+    typedef std::unordered_map<uint32, MappedFile*> MappedTileSet;
     typedef std::unordered_map<uint32, dtNavMeshQuery*> NavMeshQuerySet;
 
 
@@ -60,8 +62,13 @@ namespace MMAP
         // we have to use single dtNavMeshQuery for every instance, since those are not thread safe
         NavMeshQuerySet navMeshQueries;     // instanceId to query
 
+        /// Queries not used by any thread, see MMapManager::AcquireNavMeshQuery
+        std::mutex queryPoolLock;
+        std::vector<dtNavMeshQuery*> queryPool;
+
         dtNavMesh* navMesh;
         MMapTileSet loadedTileRefs;
+        MappedTileSet mappedTiles;          // tiles added from a file mapping, see MMapManager::SetMemoryMappedTiles
         TerrainSetMap loadedPhasedTiles;
 
     private:
@@ -75,12 +82,32 @@ namespace MMAP
 
     typedef std::unordered_map<uint32, MMapData*> MMapDataSet;
 
+    class MMapManager;
+
+    /// Pooled dtNavMeshQuery owned by the calling thread for the scope of the holder
+    class NavMeshQueryHolder
+    {
+        public:
+            NavMeshQueryHolder(MMapManager* manager, uint32 mapId);
+            ~NavMeshQueryHolder();
+
+            dtNavMeshQuery const* GetQuery() const { return _query; }
+
+        private:
+            NavMeshQueryHolder(NavMeshQueryHolder const&);
+            NavMeshQueryHolder& operator=(NavMeshQueryHolder const&);
+
+            MMapManager* _manager;
+            uint32 _mapId;
+            dtNavMeshQuery* _query;
+    };
+
     // singleton class
     // holds all all access to mmap loading unloading and meshes
     class MMapManager
     {
         public:
-            MMapManager() : loadedTiles(0), thread_safe_environment(true) {}
+            MMapManager() : loadedTiles(0), thread_safe_environment(true), memoryMappedTiles(false) {}
             ~MMapManager();
 
             void InitializeThreadUnsafe(std::unordered_map<uint32, std::vector<uint32>> const& mapData);
@@ -93,6 +120,15 @@ namespace MMAP
             dtNavMeshQuery const* GetNavMeshQuery(uint32 mapId, uint32 instanceId, TerrainSet swaps);
             dtNavMesh const* GetNavMesh(uint32 mapId, TerrainSet swaps);
 
+            /// Take a query out of the map pool, the calling thread owns it until ReleaseNavMeshQuery
+            /// Any number of threads can path on the same map, each one with its own query
+            dtNavMeshQuery* AcquireNavMeshQuery(uint32 mapId);
+            void ReleaseNavMeshQuery(uint32 mapId, dtNavMeshQuery* query);
+
+            /// Map .mmtile files instead of reading them, unmodified pages are shared with the other processes using the same files
+            /// Not used for maps with terrain swaps, their base tiles are moved around by MMapData::AddSwap
+            void SetMemoryMappedTiles(bool enabled) { memoryMappedTiles = enabled; }
+
             uint32 getLoadedTilesCount() const { return loadedTiles; }
             uint32 getLoadedMapsCount() const { return loadedMMaps.size(); }
 
@@ -116,6 +152,7 @@ namespace MMAP
             PhaseChildMapContainer phaseMapData;
             uint32 loadedTiles;
             bool thread_safe_environment;
+            bool memoryMappedTiles;
 
             PhasedTile* LoadTile(uint32 mapId, int32 x, int32 y);
             PhaseTileMap _phaseTiles;
@@ -22,7 +22,7 @@ using G3D::Vector3;
 
 namespace VMAP
 {
-    VMapManager2::VMapManager2()
+    VMapManager2::VMapManager2() : iMemoryMappedModels(false)
     {
         GetLiquidFlagsPtr = &GetLiquidFlagsDummy;
         IsVMAPDisabledForPtr = &IsVMAPDisabledForDummy;
@@ -142,6 +142,26 @@ namespace VMAP
         return true;
     }
 
+    void VMapManager2::isInLineOfSight(unsigned int mapId, Vector3 const* starts, Vector3 const* ends, uint32 count, bool* results)
+    {
+        InstanceTreeMap::iterator instanceTree = iInstanceMapTrees.find(mapId);
+        if (instanceTree == iInstanceMapTrees.end())
+        {
+            std::fill(results, results + count, true);
+            return;
+        }
+
+        std::vector<Vector3> internalStarts(count);
+        std::vector<Vector3> internalEnds(count);
+        for (uint32 i = 0; i < count; ++i)
+        {
+            internalStarts[i] = convertPositionToInternalRep(starts[i].x, starts[i].y, starts[i].z);
+            internalEnds[i] = convertPositionToInternalRep(ends[i].x, ends[i].y, ends[i].z);
+        }
+
+        instanceTree->second->isInLineOfSight(internalStarts.data(), internalEnds.data(), count, results);
+    }
+
     /**
     get the hit position and return true if we hit something
     otherwise the result pos will be the dest pos
@@ -253,7 +273,7 @@ namespace VMAP
         if (model == iLoadedModelFiles.end())
         {
             WorldModel* worldmodel = new WorldModel();
-            if (!worldmodel->readFile(basepath + filename + ".vmo"))
+            if (!worldmodel->readFile(basepath + filename + ".vmo", iMemoryMappedModels))
             {
                 sLog->outDebug(LOG_FILTER_MAPS, "VMapManager2: could not load '%s%s.vmo'", basepath.c_str(), filename.c_str());
                 delete worldmodel;
@@ -71,6 +71,8 @@ namespace VMAP
             InstanceTreeMap iInstanceMapTrees;
             // Mutex for iLoadedModelFiles
             std::mutex LoadedModelFilesLock;
+            // Map .vmo files instead of reading them
+            bool iMemoryMappedModels;
 
             bool _loadMap(uint32 mapId, const std::string& basePath, uint32 tileX, uint32 tileY);
             /* void _unloadMap(uint32 pMapId, uint32 x, uint32 y); */
@@ -92,6 +94,7 @@ namespace VMAP
             void unloadMap(unsigned int mapId) override;
 
             bool isInLineOfSight(unsigned int mapId, float x1, float y1, float z1, float x2, float y2, float z2) override ;
+            void isInLineOfSight(unsigned int mapId, G3D::Vector3 const* starts, G3D::Vector3 const* ends, uint32 count, bool* results) override;
             /**
             fill the hit pos and return true, if an object was hit
             */
@@ -104,6 +107,8 @@ namespace VMAP
             bool GetLiquidLevel(uint32 pMapId, float x, float y, float z, uint8 reqLiquidType, float& level, float& floor, uint32& type) const override;
 
             WorldModel* acquireModelInstance(const std::string& basepath, const std::string& filename);
+            // only used for models loaded afterwards, the geometry of a mapped model is shared with the other processes using the same files
+            void SetMemoryMappedModels(bool enabled) { iMemoryMappedModels = enabled; }
             void releaseModelInstance(const std::string& filename);
 
             // what's the use of this? o.O
@@ -0,0 +1,117 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+//  MILLENIUM-STUDIO
+//  Copyright 2016 Millenium-studio SARL
+//  All Rights Reserved.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+#include "MappedFile.h"
+
+#if PLATFORM == PLATFORM_WINDOWS
+# include <windows.h>
+#else
+# include <sys/mman.h>
+# include <sys/stat.h>
+# include <fcntl.h>
+# include <unistd.h>
+#endif
+
+std::atomic<uint64> MappedFile::s_TotalMappedSize(0);
+
+MappedFile::MappedFile() : m_Data(NULL), m_Size(0)
+#if PLATFORM == PLATFORM_WINDOWS
+    , m_FileHandle(NULL), m_MappingHandle(NULL)
+#endif
+{
+}
+
+MappedFile::~MappedFile()
+{
+    Close();
+}
+
+bool MappedFile::Open(std::string const& p_Path, bool p_CopyOnWrite)
+{
+    Close();
+
+#if PLATFORM == PLATFORM_WINDOWS
+    HANDLE l_File = CreateFileA(p_Path.c_str(), GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+    if (l_File == INVALID_HANDLE_VALUE)
+        return false;
+
+    LARGE_INTEGER l_Size;
+    if (!GetFileSizeEx(l_File, &l_Size) || l_Size.QuadPart == 0)
+    {
+        CloseHandle(l_File);
+        return false;
+    }
+
+    HANDLE l_Mapping = CreateFileMappingA(l_File, NULL, p_CopyOnWrite ? PAGE_WRITECOPY : PAGE_READONLY, 0, 0, NULL);
+    if (!l_Mapping)
+    {
+        CloseHandle(l_File);
+        return false;
+    }
+
+    void* l_View = MapViewOfFile(l_Mapping, p_CopyOnWrite ? FILE_MAP_COPY : FILE_MAP_READ, 0, 0, 0);
+    if (!l_View)
+    {
+        CloseHandle(l_Mapping);
+        CloseHandle(l_File);
+        return false;
+    }
+
+    m_FileHandle    = l_File;
+    m_MappingHandle = l_Mapping;
+    m_Data          = static_cast<char*>(l_View);
+    m_Size          = size_t(l_Size.QuadPart);
+#else
+    int l_File = open(p_Path.c_str(), O_RDONLY);
+    if (l_File < 0)
+        return false;
+
+    struct stat l_Stat;
+    if (fstat(l_File, &l_Stat) != 0 || l_Stat.st_size == 0)
+    {
+        close(l_File);
+        return false;
+    }
+
+    void* l_View = mmap(NULL, size_t(l_Stat.st_size), p_CopyOnWrite ? (PROT_READ | PROT_WRITE) : PROT_READ, MAP_PRIVATE, l_File, 0);
+
+    /// The mapping keeps its own reference on the file
+    close(l_File);
+
+    if (l_View == MAP_FAILED)
+        return false;
+
+    m_Data = static_cast<char*>(l_View);
+    m_Size = size_t(l_Stat.st_size);
+#endif
+
+    s_TotalMappedSize.fetch_add(m_Size, std::memory_order_relaxed);
+    return true;
+}
+
+void MappedFile::Close()
+{
+    if (!m_Data)
+        return;
+
+#if PLATFORM == PLATFORM_WINDOWS
+    UnmapViewOfFile(m_Data);
+    CloseHandle(m_MappingHandle);
+    CloseHandle(m_FileHandle);
+
+    m_MappingHandle = NULL;
+    m_FileHandle    = NULL;
+#else
+    munmap(m_Data, m_Size);
+#endif
+
+    s_TotalMappedSize.fetch_sub(m_Size, std::memory_order_relaxed);
+
+    m_Data = NULL;
+    m_Size = 0;
+}
@@ -0,0 +1,51 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+//  MILLENIUM-STUDIO
+//  Copyright 2016 Millenium-studio SARL
+//  All Rights Reserved.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef _MAPPED_FILE_H
+#define _MAPPED_FILE_H
+
+#include "Define.h"
+
+#include <atomic>
+#include <string>
+
+/// Whole file mapped in memory, used for the static vmap / mmap geometry
+/// Clean pages are backed by the page cache: they are shared by every process mapping the same file
+/// and only read from disk when touched
+class MappedFile
+{
+    public:
+        MappedFile();
+        ~MappedFile();
+
+        /// @p_CopyOnWrite : Allow writes to the view, written pages become private to the process and the file is never modified
+        bool Open(std::string const& p_Path, bool p_CopyOnWrite = false);
+        void Close();
+
+        char* GetData() const { return m_Data; }
+        size_t GetSize() const { return m_Size; }
+
+        /// Total size of the files currently mapped by the process
+        static uint64 GetTotalMappedSize() { return s_TotalMappedSize.load(std::memory_order_relaxed); }
+
+    private:
+        MappedFile(MappedFile const&);
+        MappedFile& operator=(MappedFile const&);
+
+        char*  m_Data;
+        size_t m_Size;
+
+#if PLATFORM == PLATFORM_WINDOWS
+        void*  m_FileHandle;
+        void*  m_MappingHandle;
+#endif
+
+        static std::atomic<uint64> s_TotalMappedSize;
+};
+
+#endif
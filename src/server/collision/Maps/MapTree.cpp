@@ -38,6 +38,22 @@ namespace VMAP
         bool hit;
     };
 
+    class MapRayPacketCallback
+    {
+        public:
+            MapRayPacketCallback(ModelInstance* val): prims(val), hits(0) { }
+            uint32 operator()(RayPacket& packet, uint32 entry, uint32 mask, bool pStopAtFirstHit=true)
+            {
+                uint32 result = prims[entry].intersectRays(packet, mask, pStopAtFirstHit);
+                hits |= result;
+                return result;
+            }
+        uint32 getHits() const { return hits; }
+    protected:
+        ModelInstance* prims;
+        uint32 hits;
+    };
+
     class AreaInfoCallback
     {
         public:
@@ -160,6 +176,36 @@ namespace VMAP
 
         return true;
     }
+
+    void StaticMapTree::isInLineOfSight(const Vector3* pStarts, const Vector3* pEnds, uint32 pCount, bool* pResults) const
+    {
+        RayPacket packet;
+        uint32 resultIndex[RayPacket::MAX_RAYS];
+
+        for (uint32 i = 0; i < pCount; ++i)
+        {
+            float maxDist = (pEnds[i] - pStarts[i]).magnitude();
+            // same early outs as the single ray query
+            if (maxDist == std::numeric_limits<float>::max() || !std::isfinite(maxDist))
+                pResults[i] = false;
+            else if (maxDist < 1e-10f)
+                pResults[i] = true;
+            else
+                resultIndex[packet.Add(pStarts[i], (pEnds[i] - pStarts[i])/maxDist, maxDist)] = i;
+
+            // traverse once the packet is full or all the rays are added
+            if (!packet.Count || (!packet.IsFull() && i + 1 < pCount))
+                continue;
+
+            MapRayPacketCallback intersectionCallBack(iTreeValues);
+            iTree.intersectRays(packet, intersectionCallBack, packet.GetMask(), true);
+
+            for (uint32 j = 0; j < packet.Count; ++j)
+                pResults[resultIndex[j]] = !(intersectionCallBack.getHits() & (1u << j));
+
+            packet = RayPacket();
+        }
+    }
     //=========================================================
     /**
     When moving from pos1 to pos2 check if we hit an object. Return true and the position if we hit one
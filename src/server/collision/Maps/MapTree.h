@@ -59,6 +59,8 @@ namespace VMAP
             ~StaticMapTree();
 
             bool isInLineOfSight(const G3D::Vector3& pos1, const G3D::Vector3& pos2) const;
+            //! isInLineOfSight for pCount pairs of positions, the tree is traversed once for each packet of rays
+            void isInLineOfSight(const G3D::Vector3* pStarts, const G3D::Vector3* pEnds, uint32 pCount, bool* pResults) const;
             bool getObjectHitPos(const G3D::Vector3& pos1, const G3D::Vector3& pos2, G3D::Vector3& pResultHitPos, float pModifyDist) const;
             float getHeight(const G3D::Vector3& pPos, float maxSearchDist) const;
             bool getAreaInfo(G3D::Vector3 &pos, uint32 &flags, int32 &adtId, int32 &rootId, int32 &groupId) const;
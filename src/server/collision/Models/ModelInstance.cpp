@@ -11,6 +11,8 @@
 #include "MapTree.h"
 #include "VMapDefinitions.h"
 
+#include <G3D/CollisionDetection.h>
+
 using G3D::Vector3;
 using G3D::Ray;
 
@@ -55,6 +57,59 @@ namespace VMAP
         return hit;
     }
 
+    uint32 ModelInstance::intersectRays(RayPacket& pPacket, uint32 pMask, bool pStopAtFirstHit) const
+    {
+        if (!iModel)
+            return 0;
+
+        // rays crossing the bound, moved to object space
+        RayPacket modPacket;
+        uint32 rayIndex[RayPacket::MAX_RAYS];
+        for (uint32 i = 0; i < pPacket.Count; ++i)
+        {
+            if (!(pMask & (1u << i)))
+                continue;
+
+            // same bound test as Ray::intersectionTime, without building the G3D::Ray
+            Vector3 origin = pPacket.GetOrigin(i);
+            Vector3 direction = pPacket.GetDirection(i);
+            Vector3 location;
+            bool inside;
+            if (G3D::CollisionDetection::collisionTimeForMovingPointFixedAABox(origin, direction, iBound, location, inside) == G3D::finf() && !inside)
+                continue;
+
+            Vector3 p = iInvRot * (origin - iPos) * iInvScale;
+            rayIndex[modPacket.Add(p, iInvRot * direction, pPacket.MaxDist[i] * iInvScale)] = i;
+        }
+
+        if (!modPacket.Count)
+            return 0;
+
+        // a packet of one ray is slower than the single ray query
+        if (modPacket.Count == 1)
+        {
+            float distance = modPacket.MaxDist[0];
+            if (!iModel->IntersectRay(modPacket.GetRay(0), distance, pStopAtFirstHit))
+                return 0;
+
+            pPacket.MaxDist[rayIndex[0]] = distance * iScale;
+            return 1u << rayIndex[0];
+        }
+
+        uint32 modHits = iModel->IntersectRays(modPacket, modPacket.GetMask(), pStopAtFirstHit);
+        uint32 hits = 0;
+        for (uint32 i = 0; i < modPacket.Count; ++i)
+        {
+            if (!(modHits & (1u << i)))
+                continue;
+
+            pPacket.MaxDist[rayIndex[i]] = modPacket.MaxDist[i] * iScale;
+            hits |= 1u << rayIndex[i];
+        }
+
+        return hits;
+    }
+
     void ModelInstance::intersectPoint(const G3D::Vector3& p, AreaInfo &info) const
     {
         if (!iModel)
@@ -16,6 +16,8 @@
 
 #include "Define.h"
 
+struct RayPacket;
+
 namespace VMAP
 {
     class WorldModel;
@@ -57,6 +59,8 @@ namespace VMAP
             ModelInstance(const ModelSpawn &spawn, WorldModel* model);
             void setUnloaded() { iModel = nullptr; }
             bool intersectRay(const G3D::Ray& pRay, float& pMaxDist, bool pStopAtFirstHit) const;
+            //! intersectRay for the rays of pMask, return the rays that hit
+            uint32 intersectRays(RayPacket& pPacket, uint32 pMask, bool pStopAtFirstHit) const;
             void intersectPoint(const G3D::Vector3& p, AreaInfo &info) const;
             bool GetLocationInfo(const G3D::Vector3& p, LocationInfo &info) const;
             bool GetLiquidLevel(const G3D::Vector3& p, LocationInfo &info, float &liqHeight) const;
@@ -21,7 +21,7 @@ template<> struct BoundsTrait<VMAP::GroupModel>
 
 namespace VMAP
 {
-    bool IntersectTriangle(const MeshTriangle &tri, std::vector<Vector3>::const_iterator points, const G3D::Ray &ray, float &distance)
+    bool IntersectTriangle(const MeshTriangle &tri, const Vector3* points, const Vector3 &origin, const Vector3 &direction, float &distance)
     {
         static const float EPS = 1e-5f;
 
@@ -29,7 +29,7 @@ namespace VMAP
 
         const Vector3 e1 = points[tri.idx1] - points[tri.idx0];
         const Vector3 e2 = points[tri.idx2] - points[tri.idx0];
-        const Vector3 p(ray.direction().cross(e2));
+        const Vector3 p(direction.cross(e2));
         const float a = e1.dot(p);
 
         if (std::fabs(a) < EPS) {
@@ -38,7 +38,7 @@ namespace VMAP
         }
 
         const float f = 1.0f / a;
-        const Vector3 s(ray.origin() - points[tri.idx0]);
+        const Vector3 s(origin - points[tri.idx0]);
         const float u = f * s.dot(p);
 
         if ((u < 0.0f) || (u > 1.0f)) {
@@ -47,7 +47,7 @@ namespace VMAP
         }
 
         const Vector3 q(s.cross(e1));
-        const float v = f * ray.direction().dot(q);
+        const float v = f * direction.dot(q);
 
         if ((v < 0.0f) || ((u + v) > 1.0f)) {
             // We hit the plane of the triangle, but outside the triangle
@@ -71,6 +71,90 @@ namespace VMAP
         return false;
     }
 
+    // Same test as above for the rays of mask, 4 rays at once. Return the rays hitting the triangle closer than their MaxDist
+    uint32 IntersectTriangle(const MeshTriangle &tri, const Vector3* points, RayPacket &packet, uint32 mask)
+    {
+#ifdef RAY_PACKET_SSE
+        static const float EPS = 1e-5f;
+
+        const Vector3 e1 = points[tri.idx1] - points[tri.idx0];
+        const Vector3 e2 = points[tri.idx2] - points[tri.idx0];
+        const Vector3& p0 = points[tri.idx0];
+
+        const __m128 e1x = _mm_set1_ps(e1.x), e1y = _mm_set1_ps(e1.y), e1z = _mm_set1_ps(e1.z);
+        const __m128 e2x = _mm_set1_ps(e2.x), e2y = _mm_set1_ps(e2.y), e2z = _mm_set1_ps(e2.z);
+        const __m128 zero = _mm_setzero_ps();
+        const __m128 one = _mm_set1_ps(1.0f);
+        const __m128 absMask = _mm_castsi128_ps(_mm_set1_epi32(0x7FFFFFFF));
+
+        uint32 hits = 0;
+        for (uint32 i = 0; i < RayPacket::MAX_RAYS; i += 4)
+        {
+            uint32 group = (mask >> i) & 0xF;
+            if (!group)
+                continue;
+
+            // operations in the same order as the single ray test, results are identical
+            __m128 dx = _mm_loadu_ps(&packet.Direction[0][i]);
+            __m128 dy = _mm_loadu_ps(&packet.Direction[1][i]);
+            __m128 dz = _mm_loadu_ps(&packet.Direction[2][i]);
+
+            // p = dir x e2
+            __m128 px = _mm_sub_ps(_mm_mul_ps(dy, e2z), _mm_mul_ps(dz, e2y));
+            __m128 py = _mm_sub_ps(_mm_mul_ps(dz, e2x), _mm_mul_ps(dx, e2z));
+            __m128 pz = _mm_sub_ps(_mm_mul_ps(dx, e2y), _mm_mul_ps(dy, e2x));
+            __m128 a = _mm_add_ps(_mm_add_ps(_mm_mul_ps(e1x, px), _mm_mul_ps(e1y, py)), _mm_mul_ps(e1z, pz));
+
+            uint32 valid = group & ~_mm_movemask_ps(_mm_cmplt_ps(_mm_and_ps(a, absMask), _mm_set1_ps(EPS)));
+            if (!valid)
+                continue;
+
+            __m128 f = _mm_div_ps(one, a);
+            __m128 sx = _mm_sub_ps(_mm_loadu_ps(&packet.Origin[0][i]), _mm_set1_ps(p0.x));
+            __m128 sy = _mm_sub_ps(_mm_loadu_ps(&packet.Origin[1][i]), _mm_set1_ps(p0.y));
+            __m128 sz = _mm_sub_ps(_mm_loadu_ps(&packet.Origin[2][i]), _mm_set1_ps(p0.z));
+            __m128 u = _mm_mul_ps(f, _mm_add_ps(_mm_add_ps(_mm_mul_ps(sx, px), _mm_mul_ps(sy, py)), _mm_mul_ps(sz, pz)));
+
+            valid &= ~_mm_movemask_ps(_mm_or_ps(_mm_cmplt_ps(u, zero), _mm_cmpgt_ps(u, one)));
+            if (!valid)
+                continue;
+
+            // q = s x e1
+            __m128 qx = _mm_sub_ps(_mm_mul_ps(sy, e1z), _mm_mul_ps(sz, e1y));
+            __m128 qy = _mm_sub_ps(_mm_mul_ps(sz, e1x), _mm_mul_ps(sx, e1z));
+            __m128 qz = _mm_sub_ps(_mm_mul_ps(sx, e1y), _mm_mul_ps(sy, e1x));
+            __m128 v = _mm_mul_ps(f, _mm_add_ps(_mm_add_ps(_mm_mul_ps(dx, qx), _mm_mul_ps(dy, qy)), _mm_mul_ps(dz, qz)));
+
+            valid &= ~_mm_movemask_ps(_mm_or_ps(_mm_cmplt_ps(v, zero), _mm_cmpgt_ps(_mm_add_ps(u, v), one)));
+            if (!valid)
+                continue;
+
+            __m128 t = _mm_mul_ps(f, _mm_add_ps(_mm_add_ps(_mm_mul_ps(e2x, qx), _mm_mul_ps(e2y, qy)), _mm_mul_ps(e2z, qz)));
+            __m128 distance = _mm_loadu_ps(&packet.MaxDist[i]);
+            __m128 closer = _mm_and_ps(_mm_cmpgt_ps(t, zero), _mm_cmplt_ps(t, distance));
+
+            uint32 hit = valid & _mm_movemask_ps(closer);
+            if (!hit)
+                continue;
+
+            __m128 hitMask = _mm_castsi128_ps(_mm_set_epi32((hit & 8) ? -1 : 0, (hit & 4) ? -1 : 0, (hit & 2) ? -1 : 0, (hit & 1) ? -1 : 0));
+            _mm_storeu_ps(&packet.MaxDist[i], _mm_or_ps(_mm_and_ps(hitMask, t), _mm_andnot_ps(hitMask, distance)));
+            hits |= hit << i;
+        }
+
+        return hits;
+#else
+        uint32 hits = 0;
+        for (uint32 i = 0; i < packet.Count; ++i)
+        {
+            if ((mask & (1u << i)) && IntersectTriangle(tri, points, packet.GetOrigin(i), packet.GetDirection(i), packet.MaxDist[i]))
+                hits |= 1u << i;
+        }
+
+        return hits;
+#endif
+    }
+
     class TriBoundFunc
     {
         public:
@@ -244,16 +328,55 @@ namespace VMAP
 
     GroupModel::GroupModel(const GroupModel &other):
         iBound(other.iBound), iMogpFlags(other.iMogpFlags), iGroupWMOID(other.iGroupWMOID),
-        vertices(other.vertices), triangles(other.triangles), meshTree(other.meshTree), iLiquid(nullptr)
+        vertices(other.vertices), triangles(other.triangles), iVertexData(other.iVertexData), iVertexCount(other.iVertexCount),
+        iTriangleData(other.iTriangleData), iTriangleCount(other.iTriangleCount), meshTree(other.meshTree), iLiquid(nullptr)
     {
         if (other.iLiquid)
             iLiquid = new WmoLiquid(*other.iLiquid);
+
+        // mapped geometry is shared, owned geometry has been copied
+        if (!other.vertices.empty() || !other.triangles.empty())
+            UseOwnedMeshData();
+    }
+
+    GroupModel& GroupModel::operator=(const GroupModel &other)
+    {
+        if (this == &other)
+            return *this;
+
+        iBound = other.iBound;
+        iMogpFlags = other.iMogpFlags;
+        iGroupWMOID = other.iGroupWMOID;
+        vertices = other.vertices;
+        triangles = other.triangles;
+        iVertexData = other.iVertexData;
+        iVertexCount = other.iVertexCount;
+        iTriangleData = other.iTriangleData;
+        iTriangleCount = other.iTriangleCount;
+        meshTree = other.meshTree;
+
+        delete iLiquid;
+        iLiquid = other.iLiquid ? new WmoLiquid(*other.iLiquid) : nullptr;
+
+        if (!other.vertices.empty() || !other.triangles.empty())
+            UseOwnedMeshData();
+
+        return *this;
+    }
+
+    void GroupModel::UseOwnedMeshData()
+    {
+        iVertexData = vertices.empty() ? NULL : &vertices[0];
+        iVertexCount = uint32(vertices.size());
+        iTriangleData = triangles.empty() ? NULL : &triangles[0];
+        iTriangleCount = uint32(triangles.size());
     }
 
     void GroupModel::setMeshData(std::vector<Vector3> &vert, std::vector<MeshTriangle> &tri)
     {
         vertices.swap(vert);
         triangles.swap(tri);
+        UseOwnedMeshData();
         TriBoundFunc bFunc(vertices);
         meshTree.build(triangles, bFunc);
     }
@@ -269,21 +392,21 @@ namespace VMAP
 
         // write vertices
         if (result && fwrite("VERT", 1, 4, wf) != 4) result = false;
-        count = vertices.size();
+        count = iVertexCount;
         chunkSize = sizeof(uint32)+ sizeof(Vector3)*count;
         if (result && fwrite(&chunkSize, sizeof(uint32), 1, wf) != 1) result = false;
         if (result && fwrite(&count, sizeof(uint32), 1, wf) != 1) result = false;
         if (!count) // models without (collision) geometry end here, unsure if they are useful
             return result;
-        if (result && fwrite(&vertices[0], sizeof(Vector3), count, wf) != count) result = false;
+        if (result && fwrite(iVertexData, sizeof(Vector3), count, wf) != count) result = false;
 
         // write triangle mesh
         if (result && fwrite("TRIM", 1, 4, wf) != 4) result = false;
-        count = triangles.size();
+        count = iTriangleCount;
         chunkSize = sizeof(uint32)+ sizeof(MeshTriangle)*count;
         if (result && fwrite(&chunkSize, sizeof(uint32), 1, wf) != 1) result = false;
         if (result && fwrite(&count, sizeof(uint32), 1, wf) != 1) result = false;
-        if (result && fwrite(&triangles[0], sizeof(MeshTriangle), count, wf) != count) result = false;
+        if (result && fwrite(iTriangleData, sizeof(MeshTriangle), count, wf) != count) result = false;
 
         // write mesh BIH
         if (result && fwrite("MBIH", 1, 4, wf) != 4) result = false;
@@ -304,7 +427,19 @@ namespace VMAP
         return result;
     }
 
-    bool GroupModel::readFromFile(FILE* rf)
+    // points to count elements of the mapped file at the current position of rf, and skips them
+    template<class T>
+    static bool MapFromFile(FILE* rf, MappedFile const* mappedFile, uint32 count, T const*& out)
+    {
+        long offset = ftell(rf);
+        if (offset < 0 || size_t(offset) + sizeof(T) * size_t(count) > mappedFile->GetSize())
+            return false;
+
+        out = reinterpret_cast<T const*>(mappedFile->GetData() + offset);
+        return fseek(rf, long(sizeof(T) * count), SEEK_CUR) == 0;
+    }
+
+    bool GroupModel::readFromFile(FILE* rf, MappedFile const* mappedFile)
     {
         char chunk[8];
         bool result = true;
@@ -312,6 +447,7 @@ namespace VMAP
         uint32 count = 0;
         triangles.clear();
         vertices.clear();
+        UseOwnedMeshData();
         delete iLiquid;
         iLiquid = NULL;
 
@@ -325,15 +461,32 @@ namespace VMAP
         if (result && fread(&count, sizeof(uint32), 1, rf) != 1) result = false;
         if (!count) // models without (collision) geometry end here, unsure if they are useful
             return result;
-        if (result) vertices.resize(count);
-        if (result && fread(&vertices[0], sizeof(Vector3), count, rf) != count) result = false;
+        if (mappedFile)
+        {
+            if (result) result = MapFromFile(rf, mappedFile, count, iVertexData);
+            iVertexCount = result ? count : 0;
+        }
+        else
+        {
+            if (result) vertices.resize(count);
+            if (result && fread(&vertices[0], sizeof(Vector3), count, rf) != count) result = false;
+        }
 
         // read triangle mesh
         if (result && !readChunk(rf, chunk, "TRIM", 4)) result = false;
         if (result && fread(&chunkSize, sizeof(uint32), 1, rf) != 1) result = false;
         if (result && fread(&count, sizeof(uint32), 1, rf) != 1) result = false;
-        if (result) triangles.resize(count);
-        if (result && fread(&triangles[0], sizeof(MeshTriangle), count, rf) != count) result = false;
+        if (mappedFile)
+        {
+            if (result) result = MapFromFile(rf, mappedFile, count, iTriangleData);
+            iTriangleCount = result ? count : 0;
+        }
+        else
+        {
+            if (result) triangles.resize(count);
+            if (result && count && fread(&triangles[0], sizeof(MeshTriangle), count, rf) != count) result = false;
+            UseOwnedMeshData();
+        }
 
         // read mesh BIH
         if (result && !readChunk(rf, chunk, "MBIH", 4)) result = false;
@@ -349,34 +502,59 @@ namespace VMAP
 
     struct GModelRayCallback
     {
-        GModelRayCallback(const std::vector<MeshTriangle> &tris, const std::vector<Vector3> &vert):
-            vertices(vert.begin()), triangles(tris.begin()), hit(false) { }
+        GModelRayCallback(const MeshTriangle* tris, const Vector3* vert):
+            vertices(vert), triangles(tris), hit(false) { }
         bool operator()(const G3D::Ray& ray, uint32 entry, float& distance, bool /*pStopAtFirstHit*/)
         {
-            bool result = IntersectTriangle(triangles[entry], vertices, ray, distance);
+            bool result = IntersectTriangle(triangles[entry], vertices, ray.origin(), ray.direction(), distance);
             if (result)  hit=true;
             return hit;
         }
-        std::vector<Vector3>::const_iterator vertices;
-        std::vector<MeshTriangle>::const_iterator triangles;
+        const Vector3* vertices;
+        const MeshTriangle* triangles;
         bool hit;
     };
 
     bool GroupModel::IntersectRay(const G3D::Ray &ray, float &distance, bool stopAtFirstHit) const
     {
-        if (triangles.empty())
+        if (!iTriangleCount)
             return false;
 
-        GModelRayCallback callback(triangles, vertices);
+        GModelRayCallback callback(iTriangleData, iVertexData);
         meshTree.intersectRay(ray, callback, distance, stopAtFirstHit);
         return callback.hit;
     }
 
+    struct GModelRayPacketCallback
+    {
+        GModelRayPacketCallback(const MeshTriangle* tris, const Vector3* vert):
+            vertices(vert), triangles(tris), hits(0) { }
+        uint32 operator()(RayPacket& packet, uint32 entry, uint32 mask, bool /*pStopAtFirstHit*/)
+        {
+            uint32 result = IntersectTriangle(triangles[entry], vertices, packet, mask);
+            hits |= result;
+            return result;
+        }
+        const Vector3* vertices;
+        const MeshTriangle* triangles;
+        uint32 hits;
+    };
+
+    uint32 GroupModel::IntersectRays(RayPacket &packet, uint32 mask, bool stopAtFirstHit) const
+    {
+        if (!iTriangleCount)
+            return 0;
+
+        GModelRayPacketCallback callback(iTriangleData, iVertexData);
+        meshTree.intersectRays(packet, callback, mask, stopAtFirstHit);
+        return callback.hits;
+    }
+
     bool GroupModel::IsInsideObject(const Vector3 &pos, const Vector3 &down, float &z_dist) const
     {
-        if (triangles.empty() || !iBound.contains(pos))
+        if (!iTriangleCount || !iBound.contains(pos))
             return false;
-        GModelRayCallback callback(triangles, vertices);
+        GModelRayCallback callback(iTriangleData, iVertexData);
         Vector3 rPos = pos - 0.1f * down;
         float dist = G3D::finf();
         G3D::Ray ray(rPos, down);
@@ -433,6 +611,29 @@ namespace VMAP
         return isc.hit;
     }
 
+    struct WModelRayPacketCallBack
+    {
+        WModelRayPacketCallBack(const std::vector<GroupModel> &mod): models(mod.begin()), hits(0) { }
+        uint32 operator()(RayPacket& packet, uint32 entry, uint32 mask, bool pStopAtFirstHit)
+        {
+            uint32 result = models[entry].IntersectRays(packet, mask, pStopAtFirstHit);
+            hits |= result;
+            return result;
+        }
+        std::vector<GroupModel>::const_iterator models;
+        uint32 hits;
+    };
+
+    uint32 WorldModel::IntersectRays(RayPacket &packet, uint32 mask, bool stopAtFirstHit) const
+    {
+        if (groupModels.size() == 1)
+            return groupModels[0].IntersectRays(packet, mask, stopAtFirstHit);
+
+        WModelRayPacketCallBack isc(groupModels);
+        groupTree.intersectRays(packet, isc, mask, stopAtFirstHit);
+        return isc.hits;
+    }
+
     class WModelAreaCallback {
         public:
             WModelAreaCallback(const std::vector<GroupModel> &vals, const Vector3 &down):
@@ -538,12 +739,20 @@ namespace VMAP
         return result;
     }
 
-    bool WorldModel::readFile(const std::string &filename)
+    bool WorldModel::readFile(const std::string &filename, bool memoryMapped)
     {
         FILE* rf = fopen(filename.c_str(), "rb");
         if (!rf)
             return false;
 
+        iMappedFile.reset();
+        if (memoryMapped)
+        {
+            iMappedFile = std::make_shared<MappedFile>();
+            if (!iMappedFile->Open(filename))
+                iMappedFile.reset();
+        }
+
         bool result = true;
         uint32 chunkSize = 0;
         uint32 count = 0;
@@ -563,7 +772,7 @@ namespace VMAP
             if (result) groupModels.resize(count);
             //if (result && fread(&groupModels[0], sizeof(GroupModel), count, rf) != count) result = false;
             for (uint32 i=0; i<count && result; ++i)
-                result = groupModels[i].readFromFile(rf);
+                result = groupModels[i].readFromFile(rf, iMappedFile.get());
 
             // read group BIH
             if (result && !readChunk(rf, chunk, "GBIH", 4)) result = false;
@@ -581,8 +790,8 @@ namespace VMAP
 
     void GroupModel::getMeshData(std::vector<G3D::Vector3>& outVertices, std::vector<MeshTriangle>& outTriangles, WmoLiquid*& liquid)
     {
-        outVertices = vertices;
-        outTriangles = triangles;
+        outVertices.assign(iVertexData, iVertexData + iVertexCount);
+        outTriangles.assign(iTriangleData, iTriangleData + iTriangleCount);
         liquid = iLiquid;
     }
 
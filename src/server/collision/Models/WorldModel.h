@@ -14,9 +14,12 @@
 #include <G3D/AABox.h>
 #include <G3D/Ray.h>
 #include "BoundingIntervalHierarchy.h"
+#include "MappedFile.h"
 
 #include "Define.h"
 
+#include <memory>
+
 namespace VMAP
 {
     class TreeNode;
@@ -64,21 +67,25 @@ namespace VMAP
     class GroupModel
     {
         public:
-            GroupModel() : iBound(), iMogpFlags(0), iGroupWMOID(0), iLiquid(NULL) { }
+            GroupModel() : iBound(), iMogpFlags(0), iGroupWMOID(0), iVertexData(NULL), iVertexCount(0), iTriangleData(NULL), iTriangleCount(0), iLiquid(NULL) { }
             GroupModel(const GroupModel &other);
             GroupModel(uint32 mogpFlags, uint32 groupWMOID, const G3D::AABox &bound):
-                        iBound(bound), iMogpFlags(mogpFlags), iGroupWMOID(groupWMOID), iLiquid(NULL) { }
+                        iBound(bound), iMogpFlags(mogpFlags), iGroupWMOID(groupWMOID), iVertexData(NULL), iVertexCount(0), iTriangleData(NULL), iTriangleCount(0), iLiquid(NULL) { }
             ~GroupModel() { delete iLiquid; }
+            GroupModel& operator=(const GroupModel &other);
 
             //! pass mesh data to object and create BIH. Passed vectors get get swapped with old geometry!
             void setMeshData(std::vector<G3D::Vector3> &vert, std::vector<MeshTriangle> &tri);
             void setLiquidData(WmoLiquid*& liquid) { iLiquid = liquid; liquid = NULL; }
             bool IntersectRay(const G3D::Ray &ray, float &distance, bool stopAtFirstHit) const;
+            //! IntersectRay for the rays of mask, return the rays that hit
+            uint32 IntersectRays(RayPacket &packet, uint32 mask, bool stopAtFirstHit) const;
             bool IsInsideObject(const G3D::Vector3 &pos, const G3D::Vector3 &down, float &z_dist) const;
             bool GetLiquidLevel(const G3D::Vector3 &pos, float &liqHeight) const;
             uint32 GetLiquidType() const;
             bool writeToFile(FILE* wf);
-            bool readFromFile(FILE* rf);
+            //! mappedFile: when set, vertices and triangles are used in place from the mapped file instead of being copied
+            bool readFromFile(FILE* rf, MappedFile const* mappedFile = NULL);
             const G3D::AABox& GetBound() const { return iBound; }
             uint32 GetMogpFlags() const { return iMogpFlags; }
             uint32 GetWmoID() const { return iGroupWMOID; }
@@ -88,8 +95,15 @@ namespace VMAP
             uint32 iGroupWMOID;
             std::vector<G3D::Vector3> vertices;
             std::vector<MeshTriangle> triangles;
+            //! geometry actually used, points to the vectors above or into the mapped .vmo file
+            G3D::Vector3 const* iVertexData;
+            uint32 iVertexCount;
+            MeshTriangle const* iTriangleData;
+            uint32 iTriangleCount;
             BIH meshTree;
             WmoLiquid* iLiquid;
+
+            void UseOwnedMeshData();
         public:
             void getMeshData(std::vector<G3D::Vector3> &vertices, std::vector<MeshTriangle> &triangles, WmoLiquid* &liquid);
     };
@@ -103,14 +117,18 @@ namespace VMAP
             void setGroupModels(std::vector<GroupModel> &models);
             void setRootWmoID(uint32 id) { RootWMOID = id; }
             bool IntersectRay(const G3D::Ray &ray, float &distance, bool stopAtFirstHit) const;
+            //! IntersectRay for the rays of mask, return the rays that hit
+            uint32 IntersectRays(RayPacket &packet, uint32 mask, bool stopAtFirstHit) const;
             bool IntersectPoint(const G3D::Vector3 &p, const G3D::Vector3 &down, float &dist, AreaInfo &info) const;
             bool GetLocationInfo(const G3D::Vector3 &p, const G3D::Vector3 &down, float &dist, LocationInfo &info) const;
             bool writeFile(const std::string &filename);
-            bool readFile(const std::string &filename);
+            //! memoryMapped: keep the file mapped and use its geometry in place, pages are shared with other processes
+            bool readFile(const std::string &filename, bool memoryMapped = false);
         protected:
             uint32 RootWMOID;
             std::vector<GroupModel> groupModels;
             BIH groupTree;
+            std::shared_ptr<MappedFile> iMappedFile;
         public:
             void getGroupModels(std::vector<GroupModel> &groupModels);
     };
@@ -4,6 +4,5 @@
 #include "WorldModel.h"
 #include "ModelInstance.h"
 #include "BoundingIntervalHierarchy.h"
-#include "RegularGrid.h"
-#include "BoundingIntervalHierarchyWrapper.h"
+#include "DynamicBoundingVolumeHierarchy.h"
 #include "GameObjectModel.h"
@@ -0,0 +1,106 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+//  MILLENIUM-STUDIO
+//  Copyright 2016 Millenium-studio SARL
+//  All Rights Reserved.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef _RAY_PACKET_H
+#define _RAY_PACKET_H
+
+#include "G3D/Ray.h"
+#include "Define.h"
+
+#include <cstring>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#   include <emmintrin.h>
+#   define RAY_PACKET_SSE
+#endif
+
+/// Rays traversed together by BIH::intersectRays
+/// - Each component is stored for all the rays, 4 rays are tested at once against a node or a triangle
+/// - A set of rays of the packet is given as a bit mask, bit i being the ray i
+/// - MaxDist is the distance to the closest hit found so far, like pMaxDist of the single ray queries
+struct RayPacket
+{
+    static uint32 const MAX_RAYS = 16;
+
+    /// Only the rays added are initialized, a packet is built for every model crossed
+    RayPacket() : Count(0)
+    {
+        memset(NegativeMask, 0, sizeof(NegativeMask));
+    }
+
+    /// Return the index of the ray in the packet, the packet must not be full
+    /// @p_Direction : Normalized, like the direction of a G3D::Ray
+    uint32 Add(G3D::Vector3 const& p_Origin, G3D::Vector3 const& p_Direction, float p_MaxDist)
+    {
+        uint32 l_Index = Count++;
+
+        /// The 4 rays tested together are always initialized, even past Count
+        if (!(l_Index & 3))
+        {
+            for (uint32 l_I = l_Index; l_I < l_Index + 4; ++l_I)
+            {
+                MaxDist[l_I] = 0.0f;
+
+                for (uint32 l_Axis = 0; l_Axis < 3; ++l_Axis)
+                {
+                    Origin[l_Axis][l_I]       = 0.0f;
+                    Direction[l_Axis][l_I]    = 0.0f;
+                    InvDirection[l_Axis][l_I] = 0.0f;
+                    Negative[l_Axis][l_I]     = 0;
+                }
+            }
+        }
+
+        MaxDist[l_Index] = p_MaxDist;
+
+        for (uint32 l_Axis = 0; l_Axis < 3; ++l_Axis)
+        {
+            Origin[l_Axis][l_Index]       = p_Origin[l_Axis];
+            Direction[l_Axis][l_Index]    = p_Direction[l_Axis];
+            InvDirection[l_Axis][l_Index] = 1.0f / p_Direction[l_Axis];
+            /// Same as the sign bit used by the single ray traversal, -0.0f is negative
+            Negative[l_Axis][l_Index]     = (floatToRawBits(p_Direction[l_Axis]) >> 31) ? 0xFFFFFFFF : 0;
+            NegativeMask[l_Axis]         |= (Negative[l_Axis][l_Index] & 1) << l_Index;
+        }
+
+        return l_Index;
+    }
+
+    G3D::Vector3 GetOrigin(uint32 p_Index) const { return G3D::Vector3(Origin[0][p_Index], Origin[1][p_Index], Origin[2][p_Index]); }
+    G3D::Vector3 GetDirection(uint32 p_Index) const { return G3D::Vector3(Direction[0][p_Index], Direction[1][p_Index], Direction[2][p_Index]); }
+    G3D::Ray GetRay(uint32 p_Index) const { return G3D::Ray(GetOrigin(p_Index), GetDirection(p_Index)); }
+
+    bool IsFull() const { return Count == MAX_RAYS; }
+    uint32 GetMask() const { return (1u << Count) - 1; }
+
+    static uint32 CountRays(uint32 p_Mask)
+    {
+        uint32 l_Count = 0;
+        for (; p_Mask; p_Mask &= p_Mask - 1)
+            ++l_Count;
+
+        return l_Count;
+    }
+
+    static uint32 floatToRawBits(float p_Value)
+    {
+        uint32 l_Bits;
+        memcpy(&l_Bits, &p_Value, sizeof(l_Bits));
+        return l_Bits;
+    }
+
+    uint32    Count;
+    float     Origin[3][MAX_RAYS];
+    float     Direction[3][MAX_RAYS];
+    float     InvDirection[3][MAX_RAYS];        ///< May be infinite, like G3D::Ray::invDirection
+    uint32    Negative[3][MAX_RAYS];            ///< All bits set if the direction is negative on this axis
+    uint32    NegativeMask[3];                  ///< Rays whose direction is negative on this axis
+    float     MaxDist[MAX_RAYS];
+};
+
+#endif
@@ -408,12 +408,17 @@ void AuctionHouseObject::AddAuction(AuctionEntry* auction)
     ASSERT(auction);
 
     AuctionsMap[auction->Id] = auction;
+
+    if (Item* item = sAuctionMgr->GetAItem(auction->itemGUIDLow))
+        m_SearchIndex.Insert(auction, item);
+
     sScriptMgr->OnAuctionAdd(this, auction);
 }
 
 bool AuctionHouseObject::RemoveAuction(AuctionEntry* auction, uint32 /*itemEntry*/)
 {
     bool wasInMap = AuctionsMap.erase(auction->Id) ? true : false;
+    m_SearchIndex.Remove(auction->Id);
 
     sScriptMgr->OnAuctionRemove(this, auction);
 
@@ -512,77 +517,37 @@ void AuctionHouseObject::BuildListAuctionItems(WorldPacket& data, Player* player
     uint32 inventoryType, uint32 itemClass, uint32 itemSubClass, uint32 quality,
     uint32& count, uint32& totalcount)
 {
-    int loc_idx = player->GetSession()->GetSessionDbLocaleIndex();
-    int locdbc_idx = player->GetSession()->GetSessionDbcLocale();
-
-    for (AuctionEntryMap::const_iterator itr = AuctionsMap.begin(); itr != AuctionsMap.end(); ++itr)
-    {
-        AuctionEntry* Aentry = itr->second;
-        Item* item = sAuctionMgr->GetAItem(Aentry->itemGUIDLow);
-        if (!item)
-            continue;
+    AuctionSearchQuery query(wsearchedname, player->GetSession()->GetSessionDbLocaleIndex(), levelmin, levelmax, inventoryType, itemClass, itemSubClass, quality);
 
-        ItemTemplate const* proto = item->GetTemplate();
+    // Only the auctions matching the template filters and the name are returned by the index
+    AuctionSearchIndex::AuctionIdList const& matches = m_SearchIndex.Search(query);
 
-        if (itemClass != 0xffffffff && proto->Class != itemClass)
-            continue;
+    if (!usable)
+    {
+        // No player dependent filter, only the requested page has to be touched
+        totalcount = matches.size();
 
-        if (itemSubClass != 0xffffffff && proto->SubClass != itemSubClass)
-            continue;
+        for (size_t i = listfrom; i < matches.size() && count < 50; ++i)
+        {
+            if (AuctionEntry* Aentry = GetAuction(matches[i]))
+                Aentry->BuildAuctionInfo(data);
 
-        if (inventoryType != 0xffffffff && proto->InventoryType != inventoryType)
-            continue;
+            ++count;
+        }
 
-        if (quality != 0xffffffff && proto->Quality != quality)
-            continue;
+        return;
+    }
 
-        if (levelmin != 0x00 && (proto->RequiredLevel < levelmin || (levelmax != 0x00 && proto->RequiredLevel > levelmax)))
+    for (uint32 auctionId : matches)
+    {
+        AuctionEntry* Aentry = GetAuction(auctionId);
+        if (!Aentry)
             continue;
 
-        if (usable != 0x00 && player->CanUseItem(item) != EQUIP_ERR_OK)
+        Item* item = sAuctionMgr->GetAItem(Aentry->itemGUIDLow);
+        if (!item || player->CanUseItem(item) != EQUIP_ERR_OK)
             continue;
 
-        // Allow search by suffix (ie: of the Monkey) or partial name (ie: Monkey)
-        // No need to do any of this if no search term was entered
-        if (!wsearchedname.empty())
-        {
-            std::string name = proto->Name1->Get(loc_idx);
-            if (name.empty())
-                continue;
-
-            // DO NOT use GetItemEnchantMod(proto->RandomProperty) as it may return a result
-            //  that matches the search but it may not equal item->GetItemRandomPropertyId()
-            //  used in BuildAuctionInfo() which then causes wrong items to be listed
-            int32 propRefID = item->GetItemRandomPropertyId();
-
-            if (propRefID)
-            {
-                // Append the suffix to the name (ie: of the Monkey) if one exists
-                // These are found in ItemRandomProperties.dbc, not ItemRandomSuffix.dbc
-                //  even though the DBC names seem misleading
-                const ItemRandomPropertiesEntry* itemRandProp = sItemRandomPropertiesStore.LookupEntry(propRefID);
-
-                if (itemRandProp)
-                {
-                    char* temp = itemRandProp->nameSuffix;
-                    //char* temp = itemRandProp->nameSuffix;
-
-                    // dbc local name
-                    if (temp)
-                    {
-                        // Append the suffix (ie: of the Monkey) to the name using localization
-                        // or default enUS if localization is invalid
-                        name += ' ';
-                        name += temp[locdbc_idx >= 0 ? locdbc_idx : LOCALE_enUS];
-                    }
-                }
-            }
-
-            // Perform the search (with or without suffix)
-            if (!Utf8FitTo(name, wsearchedname))
-                continue;
-        }
-
         // Add the item if no search term or if entered search term was found
         if (count < 50 && totalcount >= listfrom)
         {
@@ -14,6 +14,7 @@
 #include "DatabaseEnv.h"
 #include "DBCStructure.h"
 #include "DB2Structure.h"
+#include "AuctionSearchIndex.h"
 
 class Item;
 class Player;
@@ -122,9 +123,14 @@ class AuctionHouseObject
         uint32 inventoryType, uint32 itemClass, uint32 itemSubClass, uint32 quality,
         uint32& count, uint32& totalcount);
 
+    AuctionSearchIndex const& GetSearchIndex() const { return m_SearchIndex; }
+
   private:
     AuctionEntryMap AuctionsMap;
 
+    /// Secondary indexes used by BuildListAuctionItems, kept in sync by AddAuction / RemoveAuction
+    AuctionSearchIndex m_SearchIndex;
+
     // storage for "next" auction item for next Update()
     AuctionEntryMap::const_iterator next;
 };
@@ -0,0 +1,335 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+//  MILLENIUM-STUDIO
+//  Copyright 2016 Millenium-studio SARL
+//  All Rights Reserved.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef CROSS
+#include "AuctionSearchIndex.h"
+#include "AuctionHouseMgr.h"
+#include "DB2Stores.h"
+#include "Item.h"
+
+namespace
+{
+    /// Insert an id in a sorted posting list, auction ids are mostly increasing so it's usually a push_back
+    void AddPosting(AuctionSearchIndex::AuctionIdList& p_List, uint32 p_AuctionID)
+    {
+        if (p_List.empty() || p_List.back() < p_AuctionID)
+        {
+            p_List.push_back(p_AuctionID);
+            return;
+        }
+
+        AuctionSearchIndex::AuctionIdList::iterator l_Itr = std::lower_bound(p_List.begin(), p_List.end(), p_AuctionID);
+        if (l_Itr == p_List.end() || *l_Itr != p_AuctionID)
+            p_List.insert(l_Itr, p_AuctionID);
+    }
+
+    void RemovePosting(AuctionSearchIndex::AuctionIdList& p_List, uint32 p_AuctionID)
+    {
+        AuctionSearchIndex::AuctionIdList::iterator l_Itr = std::lower_bound(p_List.begin(), p_List.end(), p_AuctionID);
+        if (l_Itr != p_List.end() && *l_Itr == p_AuctionID)
+            p_List.erase(l_Itr);
+    }
+
+    template<class MAP> void RemovePosting(MAP& p_Map, typename MAP::key_type const& p_Key, uint32 p_AuctionID)
+    {
+        typename MAP::iterator l_Itr = p_Map.find(p_Key);
+        if (l_Itr == p_Map.end())
+            return;
+
+        RemovePosting(l_Itr->second, p_AuctionID);
+
+        if (l_Itr->second.empty())
+            p_Map.erase(l_Itr);
+    }
+
+    template<class MAP> AuctionSearchIndex::AuctionIdList const* FindPostings(MAP const& p_Map, typename MAP::key_type const& p_Key)
+    {
+        static AuctionSearchIndex::AuctionIdList const s_Empty;
+
+        typename MAP::const_iterator l_Itr = p_Map.find(p_Key);
+        return l_Itr != p_Map.end() ? &l_Itr->second : &s_Empty;
+    }
+
+    inline uint64 MakeSubClassKey(uint32 p_ItemClass, uint32 p_ItemSubClass)
+    {
+        return (uint64(p_ItemClass) << 32) | p_ItemSubClass;
+    }
+}
+
+bool AuctionSearchQuery::operator<(AuctionSearchQuery const& p_Other) const
+{
+    if (Locale != p_Other.Locale)
+        return Locale < p_Other.Locale;
+    if (LevelMin != p_Other.LevelMin)
+        return LevelMin < p_Other.LevelMin;
+    if (LevelMax != p_Other.LevelMax)
+        return LevelMax < p_Other.LevelMax;
+    if (InventoryType != p_Other.InventoryType)
+        return InventoryType < p_Other.InventoryType;
+    if (ItemClass != p_Other.ItemClass)
+        return ItemClass < p_Other.ItemClass;
+    if (ItemSubClass != p_Other.ItemSubClass)
+        return ItemSubClass < p_Other.ItemSubClass;
+    if (Quality != p_Other.Quality)
+        return Quality < p_Other.Quality;
+
+    return Name < p_Other.Name;
+}
+
+AuctionSearchIndex::AuctionSearchIndex() : m_CacheHits(0), m_CacheMisses(0)
+{
+    for (uint8 l_I = 0; l_I < TOTAL_LOCALES; ++l_I)
+        m_NameIndexBuilt[l_I] = false;
+}
+
+void AuctionSearchIndex::Insert(AuctionEntry const* p_Auction, Item const* p_Item)
+{
+    ItemTemplate const* l_Template = p_Item->GetTemplate();
+    if (!l_Template)
+        return;
+
+    IndexedAuction& l_Auction = m_Auctions[p_Auction->Id];
+    l_Auction.Template = l_Template;
+    l_Auction.Suffix   = NULL;
+
+    // DO NOT use GetItemEnchantMod(proto->RandomProperty) as it may return a result
+    //  that matches the search but it may not equal item->GetItemRandomPropertyId()
+    //  used in BuildAuctionInfo() which then causes wrong items to be listed
+    // These are found in ItemRandomProperties.dbc, not ItemRandomSuffix.dbc even though the DBC names seem misleading
+    if (int32 l_RandomPropertyID = p_Item->GetItemRandomPropertyId())
+    {
+        if (ItemRandomPropertiesEntry const* l_RandomProperty = sItemRandomPropertiesStore.LookupEntry(l_RandomPropertyID))
+        {
+            if (l_RandomProperty->nameSuffix && *l_RandomProperty->nameSuffix)
+                l_Auction.Suffix = l_RandomProperty->nameSuffix;
+        }
+    }
+
+    AddPosting(m_AllAuctions, p_Auction->Id);
+    AddPosting(m_ByClass[l_Template->Class], p_Auction->Id);
+    AddPosting(m_BySubClass[MakeSubClassKey(l_Template->Class, l_Template->SubClass)], p_Auction->Id);
+    AddPosting(m_ByInventoryType[l_Template->InventoryType], p_Auction->Id);
+    AddPosting(m_ByQuality[l_Template->Quality], p_Auction->Id);
+    AddPosting(m_ByRequiredLevel[l_Template->RequiredLevel], p_Auction->Id);
+
+    for (uint8 l_Locale = 0; l_Locale < TOTAL_LOCALES; ++l_Locale)
+    {
+        if (m_NameIndexBuilt[l_Locale])
+            IndexName(p_Auction->Id, l_Auction, LocaleConstant(l_Locale));
+    }
+
+    m_Cache.clear();
+}
+
+void AuctionSearchIndex::Remove(uint32 p_AuctionID)
+{
+    std::unordered_map<uint32, IndexedAuction>::iterator l_Itr = m_Auctions.find(p_AuctionID);
+    if (l_Itr == m_Auctions.end())
+        return;
+
+    ItemTemplate const* l_Template = l_Itr->second.Template;
+
+    RemovePosting(m_AllAuctions, p_AuctionID);
+    RemovePosting(m_ByClass, l_Template->Class, p_AuctionID);
+    RemovePosting(m_BySubClass, MakeSubClassKey(l_Template->Class, l_Template->SubClass), p_AuctionID);
+    RemovePosting(m_ByInventoryType, l_Template->InventoryType, p_AuctionID);
+    RemovePosting(m_ByQuality, l_Template->Quality, p_AuctionID);
+    RemovePosting(m_ByRequiredLevel, l_Template->RequiredLevel, p_AuctionID);
+
+    std::vector<uint64> l_Trigrams;
+
+    for (uint8 l_Locale = 0; l_Locale < TOTAL_LOCALES; ++l_Locale)
+    {
+        std::unordered_map<uint32, std::wstring>::iterator l_Name = m_SearchNames[l_Locale].find(p_AuctionID);
+        if (l_Name == m_SearchNames[l_Locale].end())
+            continue;
+
+        GetTrigrams(l_Name->second, l_Trigrams);
+
+        for (uint64 l_Trigram : l_Trigrams)
+            RemovePosting(m_ByTrigram[l_Locale], l_Trigram, p_AuctionID);
+
+        m_SearchNames[l_Locale].erase(l_Name);
+    }
+
+    m_Auctions.erase(l_Itr);
+    m_Cache.clear();
+}
+
+AuctionSearchIndex::AuctionIdList const& AuctionSearchIndex::Search(AuctionSearchQuery const& p_Query)
+{
+    std::map<AuctionSearchQuery, AuctionIdList>::const_iterator l_Cached = m_Cache.find(p_Query);
+    if (l_Cached != m_Cache.end())
+    {
+        ++m_CacheHits;
+        return l_Cached->second;
+    }
+
+    ++m_CacheMisses;
+
+    if (m_Cache.size() >= AUCTION_SEARCH_CACHE_SIZE)
+        m_Cache.clear();
+
+    if (!p_Query.Name.empty() && !m_NameIndexBuilt[p_Query.Locale])
+        BuildNameIndex(p_Query.Locale);
+
+    /// Pick the smallest posting list among the query filters to drive the scan
+    AuctionIdList const* l_Driver = &m_AllAuctions;
+
+    if (p_Query.ItemSubClass != 0xFFFFFFFF && p_Query.ItemClass != 0xFFFFFFFF)
+        l_Driver = FindPostings(m_BySubClass, MakeSubClassKey(p_Query.ItemClass, p_Query.ItemSubClass));
+    else if (p_Query.ItemClass != 0xFFFFFFFF)
+        l_Driver = FindPostings(m_ByClass, p_Query.ItemClass);
+
+    if (p_Query.InventoryType != 0xFFFFFFFF)
+    {
+        AuctionIdList const* l_List = FindPostings(m_ByInventoryType, p_Query.InventoryType);
+        if (l_List->size() < l_Driver->size())
+            l_Driver = l_List;
+    }
+
+    if (p_Query.Quality != 0xFFFFFFFF)
+    {
+        AuctionIdList const* l_List = FindPostings(m_ByQuality, p_Query.Quality);
+        if (l_List->size() < l_Driver->size())
+            l_Driver = l_List;
+    }
+
+    if (!p_Query.Name.empty())
+    {
+        std::vector<uint64> l_Trigrams;
+        GetTrigrams(p_Query.Name, l_Trigrams);
+
+        for (uint64 l_Trigram : l_Trigrams)
+        {
+            AuctionIdList const* l_List = FindPostings(m_ByTrigram[p_Query.Locale], l_Trigram);
+            if (l_List->size() < l_Driver->size())
+                l_Driver = l_List;
+        }
+    }
+
+    /// Level ranges span several buckets, they are merged only when they beat every other filter
+    AuctionIdList l_LevelPostings;
+
+    if (p_Query.LevelMin != 0)
+    {
+        std::map<uint32, AuctionIdList>::const_iterator l_Begin = m_ByRequiredLevel.lower_bound(p_Query.LevelMin);
+        std::map<uint32, AuctionIdList>::const_iterator l_End   = p_Query.LevelMax != 0 ? m_ByRequiredLevel.upper_bound(p_Query.LevelMax) : m_ByRequiredLevel.end();
+
+        size_t l_LevelCount = 0;
+        for (std::map<uint32, AuctionIdList>::const_iterator l_Itr = l_Begin; l_Itr != l_End && l_LevelCount < l_Driver->size(); ++l_Itr)
+            l_LevelCount += l_Itr->second.size();
+
+        if (l_LevelCount < l_Driver->size())
+        {
+            l_LevelPostings.reserve(l_LevelCount);
+
+            for (std::map<uint32, AuctionIdList>::const_iterator l_Itr = l_Begin; l_Itr != l_End; ++l_Itr)
+                l_LevelPostings.insert(l_LevelPostings.end(), l_Itr->second.begin(), l_Itr->second.end());
+
+            std::sort(l_LevelPostings.begin(), l_LevelPostings.end());
+            l_Driver = &l_LevelPostings;
+        }
+    }
+
+    AuctionIdList& l_Result = m_Cache[p_Query];
+
+    for (uint32 l_AuctionID : *l_Driver)
+    {
+        std::unordered_map<uint32, IndexedAuction>::const_iterator l_Itr = m_Auctions.find(l_AuctionID);
+        if (l_Itr != m_Auctions.end() && Match(l_AuctionID, l_Itr->second, p_Query))
+            l_Result.push_back(l_AuctionID);
+    }
+
+    return l_Result;
+}
+
+uint64 AuctionSearchIndex::MakeTrigram(wchar_t const* p_Chars)
+{
+    /// Unicode code points fit in 21 bits
+    return (uint64(p_Chars[0] & 0x1FFFFF) << 42) | (uint64(p_Chars[1] & 0x1FFFFF) << 21) | uint64(p_Chars[2] & 0x1FFFFF);
+}
+
+void AuctionSearchIndex::GetTrigrams(std::wstring const& p_Name, std::vector<uint64>& p_Trigrams)
+{
+    p_Trigrams.clear();
+
+    if (p_Name.size() < 3)
+        return;
+
+    for (size_t l_I = 0; l_I + 3 <= p_Name.size(); ++l_I)
+        p_Trigrams.push_back(MakeTrigram(p_Name.data() + l_I));
+
+    std::sort(p_Trigrams.begin(), p_Trigrams.end());
+    p_Trigrams.erase(std::unique(p_Trigrams.begin(), p_Trigrams.end()), p_Trigrams.end());
+}
+
+void AuctionSearchIndex::BuildNameIndex(LocaleConstant p_Locale)
+{
+    for (auto const& l_Auction : m_Auctions)
+        IndexName(l_Auction.first, l_Auction.second, p_Locale);
+
+    m_NameIndexBuilt[p_Locale] = true;
+}
+
+void AuctionSearchIndex::IndexName(uint32 p_AuctionID, IndexedAuction const& p_Auction, LocaleConstant p_Locale)
+{
+    std::string l_Name = p_Auction.Template->Name1->Get(p_Locale);
+    if (l_Name.empty())
+        return;
+
+    if (p_Auction.Suffix)
+    {
+        l_Name += ' ';
+        l_Name += p_Auction.Suffix;
+    }
+
+    std::wstring l_SearchName;
+    if (!Utf8toWStr(l_Name, l_SearchName))
+        return;
+
+    wstrToLower(l_SearchName);
+
+    std::vector<uint64> l_Trigrams;
+    GetTrigrams(l_SearchName, l_Trigrams);
+
+    for (uint64 l_Trigram : l_Trigrams)
+        AddPosting(m_ByTrigram[p_Locale][l_Trigram], p_AuctionID);
+
+    m_SearchNames[p_Locale][p_AuctionID] = l_SearchName;
+}
+
+bool AuctionSearchIndex::Match(uint32 p_AuctionID, IndexedAuction const& p_Auction, AuctionSearchQuery const& p_Query) const
+{
+    ItemTemplate const* l_Template = p_Auction.Template;
+
+    if (p_Query.ItemClass != 0xFFFFFFFF && l_Template->Class != p_Query.ItemClass)
+        return false;
+
+    if (p_Query.ItemSubClass != 0xFFFFFFFF && l_Template->SubClass != p_Query.ItemSubClass)
+        return false;
+
+    if (p_Query.InventoryType != 0xFFFFFFFF && l_Template->InventoryType != p_Query.InventoryType)
+        return false;
+
+    if (p_Query.Quality != 0xFFFFFFFF && l_Template->Quality != p_Query.Quality)
+        return false;
+
+    if (p_Query.LevelMin != 0 && (l_Template->RequiredLevel < p_Query.LevelMin || (p_Query.LevelMax != 0 && l_Template->RequiredLevel > p_Query.LevelMax)))
+        return false;
+
+    if (!p_Query.Name.empty())
+    {
+        std::unordered_map<uint32, std::wstring>::const_iterator l_Name = m_SearchNames[p_Query.Locale].find(p_AuctionID);
+        if (l_Name == m_SearchNames[p_Query.Locale].end() || l_Name->second.find(p_Query.Name) == std::wstring::npos)
+            return false;
+    }
+
+    return true;
+}
+#endif
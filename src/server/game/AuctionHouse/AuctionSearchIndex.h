@@ -0,0 +1,99 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+//  MILLENIUM-STUDIO
+//  Copyright 2016 Millenium-studio SARL
+//  All Rights Reserved.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef CROSS
+#ifndef _AUCTION_SEARCH_INDEX_H
+#define _AUCTION_SEARCH_INDEX_H
+
+#include "Common.h"
+
+struct AuctionEntry;
+struct ItemTemplate;
+class Item;
+
+/// Max cached browse results per auction house, the whole cache is dropped when it's full
+#define AUCTION_SEARCH_CACHE_SIZE 512
+
+/// Browse query key, the "usable" filter depends on the player and is applied on the result
+struct AuctionSearchQuery
+{
+    AuctionSearchQuery(std::wstring const& p_Name, LocaleConstant p_Locale, uint8 p_LevelMin, uint8 p_LevelMax,
+        uint32 p_InventoryType, uint32 p_ItemClass, uint32 p_ItemSubClass, uint32 p_Quality)
+        : Name(p_Name), Locale(p_Locale), LevelMin(p_LevelMin), LevelMax(p_LevelMax),
+        InventoryType(p_InventoryType), ItemClass(p_ItemClass), ItemSubClass(p_ItemSubClass), Quality(p_Quality) { }
+
+    bool operator<(AuctionSearchQuery const& p_Other) const;
+
+    std::wstring   Name;                                    ///< Lower case, empty if no name filter
+    LocaleConstant Locale;
+    uint8          LevelMin;
+    uint8          LevelMax;
+    uint32         InventoryType;                           ///< 0xFFFFFFFF if no filter, same for the fields below
+    uint32         ItemClass;
+    uint32         ItemSubClass;
+    uint32         Quality;
+};
+
+/// Secondary indexes of an auction house, only used by browse queries
+/// - Every posting list is a sorted vector of auction ids, so results keep the AuctionsMap order
+/// - The query is driven by the smallest posting list matching one of its filters, the other filters are checked on cached item data
+/// - Names are indexed by trigrams, per locale, the first search done in a locale builds its index
+class AuctionSearchIndex
+{
+    public:
+        typedef std::vector<uint32> AuctionIdList;
+
+        AuctionSearchIndex();
+
+        void Insert(AuctionEntry const* p_Auction, Item const* p_Item);
+        void Remove(uint32 p_AuctionID);
+
+        /// Return the ids of the auctions matching the query, ordered by id
+        /// The result is cached until the next Insert / Remove call
+        AuctionIdList const& Search(AuctionSearchQuery const& p_Query);
+
+        uint64 GetCacheHits() const { return m_CacheHits; }
+        uint64 GetCacheMisses() const { return m_CacheMisses; }
+
+    private:
+        struct IndexedAuction
+        {
+            ItemTemplate const* Template;
+            char const*         Suffix;                     ///< Random property suffix (ie: of the Monkey), can be NULL
+        };
+
+        typedef std::unordered_map<uint32, AuctionIdList> PostingMap;
+
+        static uint64 MakeTrigram(wchar_t const* p_Chars);
+        static void GetTrigrams(std::wstring const& p_Name, std::vector<uint64>& p_Trigrams);
+
+        void BuildNameIndex(LocaleConstant p_Locale);
+        void IndexName(uint32 p_AuctionID, IndexedAuction const& p_Auction, LocaleConstant p_Locale);
+
+        bool Match(uint32 p_AuctionID, IndexedAuction const& p_Auction, AuctionSearchQuery const& p_Query) const;
+
+        std::unordered_map<uint32, IndexedAuction> m_Auctions;
+        AuctionIdList                              m_AllAuctions;
+
+        PostingMap                                 m_ByClass;
+        std::unordered_map<uint64, AuctionIdList>  m_BySubClass;   ///< Key is class << 32 | subclass
+        PostingMap                                 m_ByInventoryType;
+        PostingMap                                 m_ByQuality;
+        std::map<uint32, AuctionIdList>            m_ByRequiredLevel;
+
+        std::unordered_map<uint64, AuctionIdList>  m_ByTrigram[TOTAL_LOCALES];
+        std::unordered_map<uint32, std::wstring>   m_SearchNames[TOTAL_LOCALES];   ///< Lower case name + suffix
+        bool                                       m_NameIndexBuilt[TOTAL_LOCALES];
+
+        std::map<AuctionSearchQuery, AuctionIdList> m_Cache;
+        uint64                                     m_CacheHits;
+        uint64                                     m_CacheMisses;
+};
+
+#endif
+#endif
@@ -15,6 +15,7 @@
 #include "World.h"
 #include "DatabaseEnv.h"
 #include "AccountMgr.h"
+#include "SharedWorldPacket.h"
 
 Channel::Channel(const std::string& name, uint32 channel_id, uint32 Team)
  : m_announce(true), _special(false), m_ownership(true), m_name(name), m_password(""), m_flags(0), m_channelId(channel_id), m_ownerGUID(0), m_Team(Team)
@@ -856,6 +857,8 @@ void Channel::SetOwner(uint64 guid, bool exclaim)
 
 void Channel::SendToAll(WorldPacket* data, uint64 p, uint64 p_SenderGUID)
 {
+    SharedWorldPacket l_Packet(*data);
+
     m_Lock.acquire();
     for (PlayerList::const_iterator i = m_Players.begin(); i != m_Players.end(); ++i)
     {
@@ -866,13 +869,13 @@ void Channel::SendToAll(WorldPacket* data, uint64 p, uint64 p_SenderGUID)
             if (!p || !player->GetSocial()->HasIgnore(GUID_LOPART(p)))
             {
                 if (IsWorld() || IsConstant())
-                    player->GetSession()->SendPacket(data);
+                    player->GetSession()->SendPacket(l_Packet);
                 else if (!(IsWorld() || IsConstant()))
-                    player->GetSession()->SendPacket(data);
+                    player->GetSession()->SendPacket(l_Packet);
             }
 #else /* CROSS */
             if (!p || !player->GetSocial() || !player->GetSocial()->HasIgnore(GUID_LOPART(p)))
-                player->GetSession()->SendPacket(data);
+                player->GetSession()->SendPacket(l_Packet);
 #endif /* CROSS */
         }
     }
@@ -881,6 +884,8 @@ void Channel::SendToAll(WorldPacket* data, uint64 p, uint64 p_SenderGUID)
 
 void Channel::SendToAllButOne(WorldPacket* data, uint64 who)
 {
+    SharedWorldPacket l_Packet(*data);
+
     m_Lock.acquire();
     for (PlayerList::const_iterator i = m_Players.begin(); i != m_Players.end(); ++i)
     {
@@ -888,7 +893,7 @@ void Channel::SendToAllButOne(WorldPacket* data, uint64 who)
         {
             Player* player = ObjectAccessor::FindPlayer(i->first);
             if (player)
-                player->GetSession()->SendPacket(data);
+                player->GetSession()->SendPacket(l_Packet);
         }
     }
     m_Lock.release();
@@ -184,95 +184,166 @@ bool LexicsCutter::ReadInnormativeWords(std::string& FileName)
 
 void LexicsCutter::MapInnormativeWords()
 {
-    // process all the words in the vector
+    // build the trie with an edge list per node, words with the same letter sets share their path
+    std::vector< std::vector< LC_Edge > > nodeEdges(1);
+    std::vector< bool > wordEnds(1, false);
+
     for (unsigned int i = 0; i < WordList.size(); i++)
     {
-        // parse all analogs in the first word letter
-        for (LC_LetterSet::iterator itr = (*WordList[i].begin()).begin(); itr != (*WordList[i].begin()).end(); itr++)
+        if (WordList[i].empty())
+            continue;
+
+        unsigned int node = 0;
+        for (LC_WordVector::const_iterator letter = WordList[i].begin(); letter != WordList[i].end(); letter++)
         {
-            // map the word to its first letter variants
-            WordMap.insert(std::pair< std::string, unsigned int >(*itr, i));
+            LC_PackedLetterSet letters;
+            for (LC_LetterSet::const_iterator itr = letter->begin(); itr != letter->end(); itr++)
+                letters.push_back(PackLetter(*itr));
+
+            std::sort(letters.begin(), letters.end());
+            letters.erase(std::unique(letters.begin(), letters.end()), letters.end());
+
+            unsigned int next = 0;
+            for (unsigned int j = 0; j < nodeEdges[node].size() && !next; j++)
+            {
+                if (nodeEdges[node][j].Letters == letters)
+                    next = nodeEdges[node][j].Node;
+            }
+
+            if (!next)
+            {
+                next = nodeEdges.size();
+                nodeEdges.push_back(std::vector< LC_Edge >());
+                wordEnds.push_back(false);
+
+                LC_Edge edge;
+                edge.Letters = letters;
+                edge.Node = next;
+                nodeEdges[node].push_back(edge);
+            }
+
+            node = next;
         }
+
+        wordEnds[node] = true;
+    }
+
+    // store the edges of a node contiguously
+    Nodes.assign(nodeEdges.size(), LC_Node());
+    Edges.clear();
+
+    for (unsigned int i = 0; i < nodeEdges.size(); i++)
+    {
+        Nodes[i].FirstEdge = Edges.size();
+        Nodes[i].EdgeCount = nodeEdges[i].size();
+        Nodes[i].WordEnd = wordEnds[i];
+        Edges.insert(Edges.end(), nodeEdges[i].begin(), nodeEdges[i].end());
     }
 }
 
-bool LexicsCutter::CompareWord(std::string& str, unsigned int pos, LC_WordVector word)
+uint64 LexicsCutter::PackLetter(std::string const& letter)
 {
-    std::string lchar_prev;
-    std::string lchar;
-
-    // read first letter of the word into lchar_prev
-    ReadUTF8(str, lchar, pos);
+    // UTF-8 letters have at most 6 bytes, they fit in an integer compared without any allocation
+    uint64 packed = 0;
+    for (unsigned int i = 0; i < letter.size(); i++)
+        packed = (packed << 8) | (unsigned char)letter[i];
 
-    // okay, here we go, comparing word
-    // first letter is already okay, we do begin from second and go on
-    LC_WordVector::iterator i = word.begin();
-    i++;
-    while (i != word.end())
-    {
-        // get letter from word, return false if the string is shorter
-        if (!ReadUTF8(str, lchar, pos))
-            return false;
+    return packed;
+}
 
-        // check, if the letter is in the set
-        LC_LetterSet ls = *i;
-        if (ls.count(lchar) == 0)
-        {
-            // letter is not in set, but we must check, if it is not space or repeat
-            if ((!(IgnoreMiddleSpaces && (lchar == " "))) &&
-                (!(IgnoreLetterRepeat && (lchar == lchar_prev))))
-            {
-                return false;
-            }
-        }
-        else
-        {
-            if (CheckLetterContains)
-                if (str.size() == pos)
-                    return true;
+bool LexicsCutter::ReadPackedLetter(std::string const& in, uint64& out, unsigned int& pos)
+{
+    if (pos >= in.length()) return false;
 
-            // next word letter
-            i++;
-        }
-        // set previous string letter to compare if needed (this check can really conserve time)
-        if (IgnoreLetterRepeat)
-            lchar_prev = lchar;
+    unsigned char c = in[pos++];
+    out = c;
+    int toread = trailingBytesForUTF8[(int)c];
+    while ((pos < in.length()) && (toread > 0))
+    {
+        out = (out << 8) | (unsigned char)in[pos++];
+        toread--;
     }
 
     return true;
 }
 
-bool LexicsCutter::CheckLexics(std::string& Phrase)
+void LexicsCutter::AddMatches(unsigned int node, bool first, std::vector< LC_Match >& matches) const
 {
-    std::string lchar;
-    LC_WordMap::iterator i;
-    std::pair< LC_WordMap::iterator, LC_WordMap::iterator > ii;
+    for (unsigned int i = 0; i < Nodes[node].EdgeCount; i++)
+    {
+        LC_Match match;
+        match.Edge = Nodes[node].FirstEdge + i;
+        match.First = first;
 
-    if (Phrase.size() == 0)
+        if (std::find(matches.begin(), matches.end(), match) == matches.end())
+            matches.push_back(match);
+    }
+}
+
+bool LexicsCutter::CheckLexics(std::string& Phrase)
+{
+    if (Phrase.size() == 0 || Nodes.empty())
         return false;
 
-    // first, convert the string, adding spaces and removing invalid characters
-    // also create fast position vector for the new positions
+    // a word may start on the space added before the phrase
     std::string str = " ";
+    str.append(Phrase);
+
+    // read the string once, following every word started at a previous letter
+    std::vector< LC_Match > matches;
+    std::vector< LC_Match > nextMatches;
+    uint64 lchar;
+    uint64 lchar_prev = 0;
     unsigned int pos = 0;
-    while (ReadUTF8(Phrase, lchar, pos))
-        str.append(lchar);
 
-    // string prepared, now parse it and scan for all the words
-    unsigned int pos_prev = 0;
-    pos = 0;
-    while (ReadUTF8(str, lchar, pos))
+    while (ReadPackedLetter(str, lchar, pos))
     {
-        // got character, now try to find wordmap for it
-        ii = WordMap.equal_range(lchar);
-        for (i = ii.first; i != ii.second; i++)
+        nextMatches.clear();
+
+        for (unsigned int i = 0; i < matches.size(); i++)
+        {
+            LC_Edge const& edge = Edges[matches[i].Edge];
+
+            if (std::binary_search(edge.Letters.begin(), edge.Letters.end(), lchar))
+            {
+                if (CheckLetterContains && str.size() == pos)
+                    return true;
+
+                // word fully read
+                if (Nodes[edge.Node].WordEnd)
+                    return true;
+
+                AddMatches(edge.Node, false, nextMatches);
+            }
+            // letter is not in set, but the word goes on if it is a space or a repeat
+            else if ((IgnoreMiddleSpaces && lchar == ' ') ||
+                (IgnoreLetterRepeat && !matches[i].First && lchar == lchar_prev))
+            {
+                LC_Match match;
+                match.Edge = matches[i].Edge;
+                match.First = false;
+
+                if (std::find(nextMatches.begin(), nextMatches.end(), match) == nextMatches.end())
+                    nextMatches.push_back(match);
+            }
+        }
+
+        // words starting with this letter
+        for (unsigned int i = 0; i < Nodes[0].EdgeCount; i++)
         {
-            // compare word at initial position
-            if (CompareWord(str, pos_prev, WordList[i->second]))
+            LC_Edge const& edge = Edges[Nodes[0].FirstEdge + i];
+            if (!std::binary_search(edge.Letters.begin(), edge.Letters.end(), lchar))
+                continue;
+
+            if (Nodes[edge.Node].WordEnd)
                 return true;
+
+            // the letter read before the word start is not a repeat of its first letter
+            AddMatches(edge.Node, true, nextMatches);
         }
-        // set initial position to the current position
-        pos_prev = pos;
+
+        matches.swap(nextMatches);
+        lchar_prev = lchar;
     }
 
     return false;
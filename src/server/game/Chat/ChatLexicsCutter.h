@@ -6,7 +6,7 @@ typedef std::map< std::string, LC_AnalogVector > LC_AnalogMap;
 typedef std::set< std::string > LC_LetterSet;
 typedef std::vector< LC_LetterSet > LC_WordVector;
 typedef std::vector< LC_WordVector > LC_WordList;
-typedef std::multimap< std::string, unsigned int > LC_WordMap;
+typedef std::vector< uint64 > LC_PackedLetterSet;
 
 static int trailingBytesForUTF8[256] = {
     0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0, 0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
@@ -22,12 +22,43 @@ static int trailingBytesForUTF8[256] = {
 class LexicsCutter
 {
     protected:
+        /// Word list compiled into a trie, words starting with the same letter sets share their nodes
+        /// A chat line is then read once, all the words being matched at the same time
+        struct LC_Node
+        {
+            LC_Node() : FirstEdge(0), EdgeCount(0), WordEnd(false) { }
+
+            unsigned int FirstEdge;
+            unsigned int EdgeCount;
+            bool WordEnd;
+        };
+
+        struct LC_Edge
+        {
+            LC_PackedLetterSet Letters;     ///< Sorted letter and its analogs, see PackLetter
+            unsigned int Node;
+        };
+
+        /// Word being matched: next letter set expected, the letter read before is ignored as repeat only after the first one
+        struct LC_Match
+        {
+            bool operator==(LC_Match const& other) const { return Edge == other.Edge && First == other.First; }
+
+            unsigned int Edge;
+            bool First;
+        };
+
         LC_AnalogMap AnalogMap;
         LC_WordList WordList;
-        LC_WordMap WordMap;
+        std::vector< LC_Node > Nodes;
+        std::vector< LC_Edge > Edges;
 
         std::string InvalidChars;
 
+        static uint64 PackLetter(std::string const& letter);
+        static bool ReadPackedLetter(std::string const& in, uint64& out, unsigned int& pos);
+        void AddMatches(unsigned int node, bool first, std::vector< LC_Match >& matches) const;
+
     public:
         LexicsCutter();
 
@@ -38,10 +69,8 @@ class LexicsCutter
         bool ReadLetterAnalogs(std::string& FileName);
         bool ReadInnormativeWords(std::string& FileName);
         void MapInnormativeWords();
-        bool CompareWord(std::string& str, unsigned int pos, LC_WordVector word);
         bool CheckLexics(std::string& Phrase);
-        
-        std::vector< std::pair< unsigned int, unsigned int > > Found;
+
         bool IgnoreMiddleSpaces;
         bool IgnoreLetterRepeat;
         bool CheckLetterContains;
@@ -2328,9 +2328,8 @@ void GameObject::UpdateModelPosition()
 
     if (GetMap()->ContainsGameObjectModel(*m_model))
     {
-        GetMap()->RemoveGameObjectModel(*m_model);
         m_model->Relocate(*this);
-        GetMap()->InsertGameObjectModel(*m_model);
+        GetMap()->RelocateGameObjectModel(*m_model);
     }
 }
 
@@ -885,19 +885,24 @@ void Object::BuildDynamicValuesUpdate(uint8 p_UpdateType, ByteBuffer* p_Data, Pl
     if (!p_Target)
         return;
 
+    uint32* l_Flags = nullptr;
+    uint32 l_VisibleFlags = GetDynamicUpdateFieldData(p_Target, l_Flags);
+
+    BuildDynamicValuesUpdateForVisibility(p_UpdateType, p_Data, l_VisibleFlags, l_Flags);
+}
+
+void Object::BuildDynamicValuesUpdateForVisibility(uint8 p_UpdateType, ByteBuffer* p_Data, uint32 p_VisibleFlags, uint32 const* p_Flags) const
+{
     ByteBuffer l_FieldBuffer;
     UpdateMask l_UpdateMask;
     l_UpdateMask.SetCount(_dynamicValuesCount);
 
-    uint32* l_Flags = nullptr;
-    uint32 l_VisibleFlags = GetDynamicUpdateFieldData(p_Target, l_Flags);
-
     for (uint16 l_Index = 0; l_Index < _dynamicValuesCount; ++l_Index)
     {
         ByteBuffer l_Buffer;
         std::vector<uint32> const& l_Values = _dynamicValues[l_Index];
-        if (_fieldNotifyFlags & l_Flags[l_Index] ||
-            ((p_UpdateType == UPDATETYPE_VALUES ? _dynamicChangesMask.GetBit(l_Index) : !l_Values.empty()) && (l_Flags[l_Index] & l_VisibleFlags)))
+        if (_fieldNotifyFlags & p_Flags[l_Index] ||
+            ((p_UpdateType == UPDATETYPE_VALUES ? _dynamicChangesMask.GetBit(l_Index) : !l_Values.empty()) && (p_Flags[l_Index] & p_VisibleFlags)))
         {
             l_UpdateMask.SetBit(l_Index);
 
@@ -938,7 +943,7 @@ void Object::ClearUpdateMask(bool remove)
     }
 }
 
-void Object::BuildFieldsUpdate(Player* player, UpdateDataMapType& data_map) const
+void Object::BuildFieldsUpdate(Player* player, UpdateDataMapType& data_map, ValuesUpdateCache* p_Cache) const
 {
     UpdateDataMapType::iterator iter = data_map.find(player);
 
@@ -949,7 +954,60 @@ void Object::BuildFieldsUpdate(Player* player, UpdateDataMapType& data_map) cons
         iter = p.first;
     }
 
-    BuildValuesUpdateBlockForPlayer(&iter->second, iter->first);
+    if (p_Cache != nullptr && CanShareValuesUpdate())
+        BuildValuesUpdateBlockForPlayerWithCache(&iter->second, iter->first, *p_Cache);
+    else
+        BuildValuesUpdateBlockForPlayer(&iter->second, iter->first);
+}
+
+void Object::BuildValuesUpdateBlockForPlayerWithCache(UpdateData* p_Data, Player* p_Target, ValuesUpdateCache& p_Cache) const
+{
+    uint32* l_Flags = nullptr;
+    uint32 l_VisibleFlag = GetUpdateFieldData(p_Target, l_Flags);
+
+    uint32* l_DynamicFlags = nullptr;
+    uint32 l_DynamicVisibleFlag = GetDynamicUpdateFieldData(p_Target, l_DynamicFlags);
+
+    ValuesUpdateCache::Entry* l_Entry = nullptr;
+    for (ValuesUpdateCache::Entry& l_Itr : p_Cache.Entries)
+    {
+        if (l_Itr.VisibleFlag == l_VisibleFlag && l_Itr.DynamicVisibleFlag == l_DynamicVisibleFlag)
+        {
+            l_Entry = &l_Itr;
+            break;
+        }
+    }
+
+    if (l_Entry != nullptr)
+        ++p_Cache.Hits;
+    else
+    {
+        ++p_Cache.Misses;
+
+        p_Cache.Entries.emplace_back();
+        l_Entry = &p_Cache.Entries.back();
+
+        l_Entry->VisibleFlag        = l_VisibleFlag;
+        l_Entry->DynamicVisibleFlag = l_DynamicVisibleFlag;
+
+        l_Entry->Block << uint8(UPDATETYPE_VALUES);
+        l_Entry->Block.append(GetPackGUID());
+
+        BuildValuesUpdateForVisibility(UPDATETYPE_VALUES, &l_Entry->Block, l_VisibleFlag, l_Flags, nullptr, &l_Entry->Patches);
+        BuildDynamicValuesUpdateForVisibility(UPDATETYPE_VALUES, &l_Entry->Block, l_DynamicVisibleFlag, l_DynamicFlags);
+    }
+
+    if (l_Entry->Patches.empty())
+    {
+        p_Data->AddUpdateBlock(l_Entry->Block);
+        return;
+    }
+
+    ByteBuffer l_Block(l_Entry->Block);
+    for (auto const& l_Patch : l_Entry->Patches)
+        l_Block.put<uint32>(l_Patch.first, GetViewerDependentFieldValue(l_Patch.second, p_Target));
+
+    p_Data->AddUpdateBlock(l_Block);
 }
 
 void Object::_LoadIntoDataField(char const* p_Data, uint32 p_StartOffset, uint32 p_Count, bool p_Force)
@@ -1877,7 +1935,7 @@ bool WorldObject::_IsWithinDist(WorldObject const* obj, float dist2compare, bool
     return distsq < maxdist * maxdist;
 }
 
-bool WorldObject::IsWithinLOSInMap(const WorldObject* obj) const
+bool WorldObject::IsWithinLOSInMap(const WorldObject* obj, bool const* p_LineOfSight /*= nullptr*/) const
 {
     if (!IsInMap(obj))
         return false;
@@ -1912,6 +1970,9 @@ bool WorldObject::IsWithinLOSInMap(const WorldObject* obj) const
             return true;
     }
 
+    if (p_LineOfSight)
+        return *p_LineOfSight;
+
     return IsWithinLOS(ox, oy, oz);
 }
 
@@ -3970,8 +4031,9 @@ struct WorldObjectChangeAccumulator
 {
     UpdateDataMapType& i_updateDatas;
     WorldObject& i_object;
+    ValuesUpdateCache& i_cache;
     std::set<uint64> plr_list;
-    WorldObjectChangeAccumulator(WorldObject &obj, UpdateDataMapType &d) : i_updateDatas(d), i_object(obj) {}
+    WorldObjectChangeAccumulator(WorldObject &obj, UpdateDataMapType &d, ValuesUpdateCache& c) : i_updateDatas(d), i_object(obj), i_cache(c) {}
     void Visit(PlayerMapType &m)
     {
         Player* source = NULL;
@@ -4028,7 +4090,7 @@ struct WorldObjectChangeAccumulator
         // Only send update once to a player
         if (plr_list.find(player->GetGUID()) == plr_list.end() && player->HaveAtClient(&i_object))
         {
-            i_object.BuildFieldsUpdate(player, i_updateDatas);
+            i_object.BuildFieldsUpdate(player, i_updateDatas, &i_cache);
             plr_list.insert(player->GetGUID());
         }
     }
@@ -4038,24 +4100,28 @@ struct WorldObjectChangeAccumulator
 
 void WorldObject::BuildUpdate(UpdateDataMapType& data_map)
 {
+    ValuesUpdateCache l_Cache;
+
     if (ToGameObject() && ToGameObject()->IsTransport())
     {
         Map::PlayerList const& players = GetMap()->GetPlayers();
         for (Map::PlayerList::const_iterator itr = players.begin(); itr != players.end(); ++itr)
-            BuildFieldsUpdate(itr->getSource(), data_map);
+            BuildFieldsUpdate(itr->getSource(), data_map, &l_Cache);
     }
     else
     {
         CellCoord p = JadeCore::ComputeCellCoord(GetPositionX(), GetPositionY());
         Cell cell(p);
         cell.SetNoCreate();
-        WorldObjectChangeAccumulator notifier(*this, data_map);
+        WorldObjectChangeAccumulator notifier(*this, data_map, l_Cache);
         TypeContainerVisitor<WorldObjectChangeAccumulator, WorldTypeMapContainer > player_notifier(notifier);
         Map& map = *GetMap();
         //we must build packets for all visible players
         cell.Visit(p, player_notifier, map, *this, GetVisibilityRange());
     }
 
+    sObjectAccessor->AddValuesUpdateCacheStats(l_Cache.Hits, l_Cache.Misses);
+
     ClearUpdateMask(false);
 }
 
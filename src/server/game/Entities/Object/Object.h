@@ -375,7 +375,7 @@ class Object
         virtual bool hasQuest(uint32 /* quest_id */) const { return false; }
         virtual bool hasInvolvedQuest(uint32 /* quest_id */) const { return false; }
         virtual void BuildUpdate(UpdateDataMapType&) {}
-        void BuildFieldsUpdate(Player*, UpdateDataMapType &) const;
+        void BuildFieldsUpdate(Player*, UpdateDataMapType &, ValuesUpdateCache* p_Cache = nullptr) const;
 
         void SetFieldNotifyFlag(uint16 flag) { _fieldNotifyFlags |= flag; }
         void RemoveFieldNotifyFlag(uint16 flag) { _fieldNotifyFlags &= ~flag; }
@@ -422,6 +422,14 @@ class Object
         void BuildMovementUpdate(ByteBuffer * data, uint32 flags) const;
         virtual void BuildValuesUpdate(uint8 updatetype, ByteBuffer* data, Player* target) const;
         virtual void BuildDynamicValuesUpdate(uint8 updateType, ByteBuffer* data, Player* target) const;
+        void BuildDynamicValuesUpdateForVisibility(uint8 p_UpdateType, ByteBuffer* p_Data, uint32 p_VisibleFlags, uint32 const* p_Flags) const;
+
+        /// Values update shared between viewers, see ValuesUpdateCache
+        /// Without target, fields depending on the viewer are written as 0 and added to p_Patches
+        virtual bool CanShareValuesUpdate() const { return false; }
+        virtual void BuildValuesUpdateForVisibility(uint8 /*p_UpdateType*/, ByteBuffer* /*p_Data*/, uint32 /*p_VisibleFlag*/, uint32 const* /*p_Flags*/, Player* /*p_Target*/, ValuesUpdateCache::PatchList* /*p_Patches*/) const { }
+        virtual uint32 GetViewerDependentFieldValue(uint16 p_Index, Player* /*p_Target*/) const { return m_uint32Values[p_Index]; }
+        void BuildValuesUpdateBlockForPlayerWithCache(UpdateData* p_Data, Player* p_Target, ValuesUpdateCache& p_Cache) const;
 
         uint16 m_objectType;
 
@@ -1005,7 +1013,8 @@ class WorldObject : public Object, public WorldLocation
             return obj && IsInMap(obj) && InSamePhase(obj) && _IsWithinDist(obj, dist2compare, is3D);
         }
         bool IsWithinLOS(float x, float y, float z) const;
-        bool IsWithinLOSInMap(const WorldObject* obj) const;
+        /// @p_LineOfSight : Line of sight already computed between both positions, by a batched Map::isInLineOfSight
+        bool IsWithinLOSInMap(const WorldObject* obj, bool const* p_LineOfSight = nullptr) const;
         bool GetDistanceOrder(WorldObject const* obj1, WorldObject const* obj2, bool is3D = true) const;
         bool IsInRange(WorldObject const* obj, float minRange, float maxRange, bool is3D = true, bool useSizeFactor = true) const;
         bool IsInRange2d(float x, float y, float minRange, float maxRange) const;
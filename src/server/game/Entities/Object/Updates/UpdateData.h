@@ -69,5 +69,27 @@ class UpdateData
         UpdateData(UpdateData const& right) = delete;
         UpdateData& operator=(UpdateData const& right) = delete;
 };
+
+/// Values update blocks of one object, built once per tick for each visibility class (public, party, owner...)
+/// and shared by all the viewers of that class, fields depending on the viewer are patched afterward
+struct ValuesUpdateCache
+{
+    /// Offset of the field in Block, update field index
+    typedef std::vector<std::pair<uint32, uint16>> PatchList;
+
+    struct Entry
+    {
+        uint32 VisibleFlag;
+        uint32 DynamicVisibleFlag;
+        ByteBuffer Block;
+        PatchList Patches;
+    };
+
+    ValuesUpdateCache() : Hits(0), Misses(0) { }
+
+    std::vector<Entry> Entries;
+    uint32 Hits;
+    uint32 Misses;
+};
 #endif
 
@@ -86,6 +86,10 @@
 
 #define ZONE_UPDATE_INTERVAL (1*IN_MILLISECONDS)
 
+std::atomic<uint64> gPlayerSaveCount(0);
+std::atomic<uint64> gPlayerSaveStatementCount(0);
+std::atomic<uint64> gPlayerSaveMaxStatementCount(0);
+
 enum SkillFieldOffset
 {
     SKILL_OFFSET_LINEID     = 0 * 64,
@@ -518,6 +522,7 @@ Player::Player(WorldSession* session) : Unit(true), m_achievementMgr(this), m_re
     m_emote = 0;
 
     memset(_voidStorageItems, 0, VOID_STORAGE_MAX_SLOT * sizeof(VoidStorageItem*));
+    ResetSaveFingerprints();
 
     for (uint8 i = 0; i < MAX_PVP_SLOT; ++i)
     {
@@ -5839,10 +5844,6 @@ void Player::_LoadChargesCooldowns(PreparedQueryResult p_Result)
 
 void Player::_SaveSpellCooldowns(SQLTransaction& trans)
 {
-    PreparedStatement* stmt = RealmDatabase.GetPreparedStatement(CHAR_DEL_CHAR_SPELL_COOLDOWN);
-    stmt->setUInt32(0, GetRealGUIDLow());
-    trans->Append(stmt);
-
     uint64 curTime = 0;
     ACE_OS::gettimeofday().msec(curTime);
     uint64 infTime = curTime + infinityCooldownDelayCheck;
@@ -5871,6 +5872,13 @@ void Player::_SaveSpellCooldowns(SQLTransaction& trans)
         else
             ++itr;
     }
+    if (!UpdateSaveFingerprint(m_SaveFingerprints[SAVE_FINGERPRINT_SPELL_COOLDOWNS], ss.str()))
+        return;
+
+    PreparedStatement* stmt = RealmDatabase.GetPreparedStatement(CHAR_DEL_CHAR_SPELL_COOLDOWN);
+    stmt->setUInt32(0, GetRealGUIDLow());
+    trans->Append(stmt);
+
     // if something changed execute
     if (!first_round)
         trans->Append(ss.str().c_str());
@@ -5884,22 +5892,29 @@ void Player::_SaveChargesCooldowns(SQLTransaction& p_Transaction)
     auto l_Database = &CharacterDatabase;
 #endif
 
-    PreparedStatement* l_Statement = l_Database->GetPreparedStatement(CHAR_DEL_CHARGES_COOLDOWN);
-    l_Statement->setUInt32(0, GetRealGUIDLow());
-    p_Transaction->Append(l_Statement);
+    std::ostringstream l_Rows;
 
     for (auto const& p : m_CategoryCharges)
     {
         for (ChargeEntry const& l_Charge : p.second)
         {
-            PreparedStatement* l_Statement = l_Database->GetPreparedStatement(CHAR_INS_CHARGES_COOLDOWN);
-            l_Statement->setUInt32(0, GetRealGUIDLow());
-            l_Statement->setUInt32(1, p.first);
-            l_Statement->setUInt32(2, uint32(Clock::to_time_t(l_Charge.RechargeStart)));
-            l_Statement->setUInt32(3, uint32(Clock::to_time_t(l_Charge.RechargeEnd)));
-            p_Transaction->Append(l_Statement);
+            if (l_Rows.tellp() > 0)
+                l_Rows << ',';
+
+            l_Rows << '(' << GetRealGUIDLow() << ',' << p.first << ',' << uint32(Clock::to_time_t(l_Charge.RechargeStart)) << ',' << uint32(Clock::to_time_t(l_Charge.RechargeEnd)) << ')';
         }
     }
+
+    std::string l_RowsStr = l_Rows.str();
+    if (!UpdateSaveFingerprint(m_SaveFingerprints[SAVE_FINGERPRINT_CHARGES_COOLDOWNS], l_RowsStr))
+        return;
+
+    PreparedStatement* l_Statement = l_Database->GetPreparedStatement(CHAR_DEL_CHARGES_COOLDOWN);
+    l_Statement->setUInt32(0, GetRealGUIDLow());
+    p_Transaction->Append(l_Statement);
+
+    if (!l_RowsStr.empty())
+        p_Transaction->Append(("INSERT INTO character_spell_charges (guid, categoryId, rechargeStart, rechargeEnd) VALUES " + l_RowsStr).c_str());
 }
 
 uint32 Player::GetNextResetSpecializationCost() const
@@ -23924,6 +23939,10 @@ void Player::SaveToDB(bool create /*=false*/, MS::Utilities::CallBackPtr p_Callb
         stmt->setUInt32(index++, GetRealGUIDLow());
     }
 
+    /// Fingerprints describe the rows in database only if the save which recorded them was committed
+    if (m_LastSaveCallback != nullptr && m_LastSaveCallback->m_State != MS::Utilities::CallBackState::Success)
+        ResetSaveFingerprints();
+
     SQLTransaction trans = RealmDatabase.BeginTransaction();
     SQLTransaction accountTrans = LoginDatabase.BeginTransaction();
 
@@ -23980,6 +23999,19 @@ void Player::SaveToDB(bool create /*=false*/, MS::Utilities::CallBackPtr p_Callb
         l_Pet->Save(accountTrans);
     }
 
+    uint64 l_StatementCount = trans->GetSize() + accountTrans->GetSize();
+    uint64 l_MaxStatementCount = gPlayerSaveMaxStatementCount.load();
+    while (l_StatementCount > l_MaxStatementCount && !gPlayerSaveMaxStatementCount.compare_exchange_weak(l_MaxStatementCount, l_StatementCount));
+
+    ++gPlayerSaveCount;
+    gPlayerSaveStatementCount += l_StatementCount;
+
+    /// Its state is checked by the next save
+    if (p_Callback == nullptr)
+        p_Callback = std::make_shared<MS::Utilities::Callback>([](bool /*p_Success*/) -> void { });
+
+    m_LastSaveCallback = p_Callback;
+
     CommitTransaction(RealmDatabase, trans, p_Callback);
     LoginDatabase.CommitTransaction(accountTrans);
 
@@ -23998,6 +24030,9 @@ void Player::SaveInventoryAndGoldToDB(SQLTransaction& trans)
     _SaveCurrency(trans);
     _SaveVoidStorage(trans);
     SaveGoldToDB(trans);
+
+    /// The caller commits the transaction, nothing tells if the slots written by it are saved
+    memset(m_VoidStorageSaveFingerprints, 0, sizeof(m_VoidStorageSaveFingerprints));
 }
 
 void Player::SaveGoldToDB(SQLTransaction& trans)
@@ -24008,6 +24043,24 @@ void Player::SaveGoldToDB(SQLTransaction& trans)
     trans->Append(stmt);
 }
 
+void Player::ResetSaveFingerprints()
+{
+    memset(m_SaveFingerprints, 0, sizeof(m_SaveFingerprints));
+    memset(m_VoidStorageSaveFingerprints, 0, sizeof(m_VoidStorageSaveFingerprints));
+}
+
+bool Player::UpdateSaveFingerprint(size_t& p_Fingerprint, std::string const& p_Rows)
+{
+    /// Never 0, an unknown fingerprint must always be different
+    size_t l_Fingerprint = std::hash<std::string>()(p_Rows) | 1;
+
+    if (l_Fingerprint == p_Fingerprint)
+        return false;
+
+    p_Fingerprint = l_Fingerprint;
+    return true;
+}
+
 void Player::_SaveActions(SQLTransaction& trans)
 {
     PreparedStatement* stmt = NULL;
@@ -24058,12 +24111,8 @@ void Player::_SaveActions(SQLTransaction& trans)
 
 void Player::_SaveAuras(SQLTransaction& trans)
 {
-    PreparedStatement* stmt = RealmDatabase.GetPreparedStatement(CHAR_DEL_CHAR_AURA);
-    stmt->setUInt32(0, GetRealGUIDLow());
-    trans->Append(stmt);
-    stmt = RealmDatabase.GetPreparedStatement(CHAR_DEL_CHAR_AURA_EFFECT);
-    stmt->setUInt32(0, GetRealGUIDLow());
-    trans->Append(stmt);
+    std::ostringstream l_AuraRows;
+    std::ostringstream l_EffectRows;
 
     for (AuraMap::const_iterator itr = m_ownedAuras.begin(); itr != m_ownedAuras.end(); ++itr)
     {
@@ -24077,7 +24126,6 @@ void Player::_SaveAuras(SQLTransaction& trans)
             continue;
 
 
-        uint8 index = 0;
         int32 damage[SpellEffIndex::MAX_EFFECTS];
         int32 baseDamage[SpellEffIndex::MAX_EFFECTS];
         uint32 effMask = 0;
@@ -24086,15 +24134,10 @@ void Player::_SaveAuras(SQLTransaction& trans)
         {
             if (AuraEffect const* effect = aura->GetEffect(i))
             {
-                index = 0;
-                stmt = RealmDatabase.GetPreparedStatement(CHAR_INS_AURA_EFFECT);
-                stmt->setUInt32(index++, GetRealGUIDLow());
-                stmt->setUInt8(index++, foundAura->GetSlot());
-                stmt->setUInt8(index++, i);
-                stmt->setInt32(index++, effect->GetBaseAmount());
-                stmt->setInt32(index++, effect->GetAmount());
+                if (l_EffectRows.tellp() > 0)
+                    l_EffectRows << ',';
 
-                trans->Append(stmt);
+                l_EffectRows << '(' << GetRealGUIDLow() << ',' << uint32(foundAura->GetSlot()) << ',' << uint32(i) << ',' << effect->GetBaseAmount() << ',' << effect->GetAmount() << ')';
 
                 baseDamage[i] = effect->GetBaseAmount();
                 damage[i] = effect->GetAmount();
@@ -24109,22 +24152,33 @@ void Player::_SaveAuras(SQLTransaction& trans)
             }
         }
 
-        index = 0;
-        stmt = RealmDatabase.GetPreparedStatement(CHAR_INS_AURA);
-        stmt->setUInt32(index++, GetRealGUIDLow());
-        stmt->setUInt8(index++, foundAura->GetSlot());
-        stmt->setUInt64(index++, itr->second->GetCasterGUID());
-        stmt->setUInt64(index++, itr->second->GetCastItemGUID());
-        stmt->setUInt32(index++, itr->second->GetId());
-        stmt->setUInt32(index++, effMask);
-        stmt->setUInt32(index++, recalculateMask);
-        stmt->setUInt8(index++, itr->second->GetStackAmount());
-        stmt->setInt32(index++, itr->second->GetMaxDuration());
-        stmt->setInt32(index++, itr->second->GetDuration());
-        stmt->setUInt8(index++, itr->second->GetCharges());
-        stmt->setInt32(index++, aura->GetCastItemLevel());
-        trans->Append(stmt);
+        if (l_AuraRows.tellp() > 0)
+            l_AuraRows << ',';
+
+        l_AuraRows << '(' << GetRealGUIDLow() << ',' << uint32(foundAura->GetSlot()) << ',' << aura->GetCasterGUID() << ',' << aura->GetCastItemGUID() << ',' << aura->GetId() << ','
+            << effMask << ',' << recalculateMask << ',' << uint32(aura->GetStackAmount()) << ',' << aura->GetMaxDuration() << ',' << aura->GetDuration() << ','
+            << uint32(aura->GetCharges()) << ',' << aura->GetCastItemLevel() << ')';
     }
+
+    std::string l_AuraRowsStr   = l_AuraRows.str();
+    std::string l_EffectRowsStr = l_EffectRows.str();
+
+    /// Most characters have no saved aura, or only permanent ones
+    if (!UpdateSaveFingerprint(m_SaveFingerprints[SAVE_FINGERPRINT_AURAS], l_AuraRowsStr + '|' + l_EffectRowsStr))
+        return;
+
+    PreparedStatement* stmt = RealmDatabase.GetPreparedStatement(CHAR_DEL_CHAR_AURA);
+    stmt->setUInt32(0, GetRealGUIDLow());
+    trans->Append(stmt);
+    stmt = RealmDatabase.GetPreparedStatement(CHAR_DEL_CHAR_AURA_EFFECT);
+    stmt->setUInt32(0, GetRealGUIDLow());
+    trans->Append(stmt);
+
+    if (!l_AuraRowsStr.empty())
+        trans->Append(("INSERT INTO character_aura (guid, slot, caster_guid, item_guid, spell, effect_mask, recalculate_mask, stackcount, maxduration, remaintime, remaincharges, castItemLevel) VALUES " + l_AuraRowsStr).c_str());
+
+    if (!l_EffectRowsStr.empty())
+        trans->Append(("INSERT INTO character_aura_effect (guid, slot, effect, baseamount, amount) VALUES " + l_EffectRowsStr).c_str());
 }
 
 void Player::_SaveInventory(SQLTransaction& trans)
@@ -24238,44 +24292,55 @@ void Player::_SaveVoidStorage(SQLTransaction& trans)
     if (!m_VoidStorageLoaded)
         return;
 
-    PreparedStatement* stmt = NULL;
     uint32 lowGuid = GetRealGUIDLow();
 
+    std::ostringstream l_DeletedSlots;
+    std::ostringstream l_ReplacedRows;
+
     for (uint8 i = 0; i < VOID_STORAGE_MAX_SLOT; ++i)
     {
-        if (!_voidStorageItems[i]) // unused item
+        std::ostringstream l_Row;
+
+        if (VoidStorageItem const* l_Item = _voidStorageItems[i])
         {
-            // DELETE FROM void_storage WHERE slot = ? AND playerGuid = ?
-            stmt = RealmDatabase.GetPreparedStatement(CHAR_DEL_CHAR_VOID_STORAGE_ITEM_BY_SLOT);
-            stmt->setUInt8(0, i);
-            stmt->setUInt32(1, lowGuid);
+            l_Row << '(' << l_Item->ItemId << ',' << lowGuid << ',' << l_Item->ItemEntry << ',' << uint32(i) << ',' << l_Item->CreatorGuid << ','
+                << l_Item->ItemRandomPropertyId << ',' << l_Item->ItemSuffixFactor << ",'";
+
+            for (uint32 l_I = 0; l_I < l_Item->Bonuses.size(); l_I++)
+                l_Row << l_Item->Bonuses[l_I] << ' ';
+
+            l_Row << "')";
         }
-        else
-        {
-            // REPLACE INTO character_inventory (itemId, playerGuid, itemEntry, slot, creatorGuid) VALUES (?, ?, ?, ?, ?)
-            stmt = RealmDatabase.GetPreparedStatement(CHAR_REP_CHAR_VOID_STORAGE_ITEM);
-            stmt->setUInt64(0, _voidStorageItems[i]->ItemId);
-            stmt->setUInt32(1, lowGuid);
-            stmt->setUInt32(2, _voidStorageItems[i]->ItemEntry);
-            stmt->setUInt8(3, i);
-            stmt->setUInt32(4, _voidStorageItems[i]->CreatorGuid);
-            stmt->setUInt32(5, _voidStorageItems[i]->ItemRandomPropertyId);
-            stmt->setUInt32(6, _voidStorageItems[i]->ItemSuffixFactor);
 
-            std::ostringstream l_Bonuses;
+        /// Only the slots changed since the last save are written
+        if (!UpdateSaveFingerprint(m_VoidStorageSaveFingerprints[i], l_Row.str()))
+            continue;
 
-            for (uint32 l_I = 0; l_I < _voidStorageItems[i]->Bonuses.size(); l_I++)
-            {
-                if (_voidStorageItems[i])
-                    l_Bonuses << _voidStorageItems[i]->Bonuses[l_I] << ' ';
-            }
+        if (!_voidStorageItems[i]) // unused item
+        {
+            if (l_DeletedSlots.tellp() > 0)
+                l_DeletedSlots << ',';
 
-            stmt->setString(7, l_Bonuses.str());
+            l_DeletedSlots << uint32(i);
+        }
+        else
+        {
+            if (l_ReplacedRows.tellp() > 0)
+                l_ReplacedRows << ',';
 
+            l_ReplacedRows << l_Row.str();
         }
+    }
 
-        trans->Append(stmt);
+    if (l_DeletedSlots.tellp() > 0)
+    {
+        std::ostringstream ss;
+        ss << "DELETE FROM character_void_storage WHERE playerGuid = " << lowGuid << " AND slot IN (" << l_DeletedSlots.str() << ')';
+        trans->Append(ss.str().c_str());
     }
+
+    if (l_ReplacedRows.tellp() > 0)
+        trans->Append(("REPLACE INTO character_void_storage (itemId, playerGuid, itemEntry, slot, creatorGuid, randomProperty, suffixFactor, bonuses) VALUES " + l_ReplacedRows.str()).c_str());
 }
 
 void Player::_SaveMail(SQLTransaction& trans)
@@ -24467,26 +24532,26 @@ void Player::_SaveDailyQuestStatus(SQLTransaction& trans)
     stmt->setUInt32(0, GetRealGUIDLow());
     trans->Append(stmt);
 
+    std::ostringstream ss;
+
     for (auto id : m_dailyQuestStorage)
     {
-        stmt = RealmDatabase.GetPreparedStatement(CHAR_INS_CHARACTER_DAILYQUESTSTATUS);
-        stmt->setUInt32(0, GetRealGUIDLow());
-        stmt->setUInt32(1, id);
-        stmt->setUInt64(2, uint64(m_lastDailyQuestTime));
-        trans->Append(stmt);
+        if (ss.tellp() > 0)
+            ss << ',';
+
+        ss << '(' << GetRealGUIDLow() << ',' << id << ',' << uint64(m_lastDailyQuestTime) << ')';
     }
 
-    if (!m_DFQuests.empty())
+    for (DFQuestsDoneList::iterator itr = m_DFQuests.begin(); itr != m_DFQuests.end(); ++itr)
     {
-        for (DFQuestsDoneList::iterator itr = m_DFQuests.begin(); itr != m_DFQuests.end(); ++itr)
-        {
-            stmt = RealmDatabase.GetPreparedStatement(CHAR_INS_CHARACTER_DAILYQUESTSTATUS);
-            stmt->setUInt32(0, GetRealGUIDLow());
-            stmt->setUInt32(1, (*itr));
-            stmt->setUInt64(2, uint64(m_lastDailyQuestTime));
-            trans->Append(stmt);
-        }
+        if (ss.tellp() > 0)
+            ss << ',';
+
+        ss << '(' << GetRealGUIDLow() << ',' << (*itr) << ',' << uint64(m_lastDailyQuestTime) << ')';
     }
+
+    if (ss.tellp() > 0)
+        trans->Append(("INSERT INTO character_queststatus_daily (guid, quest, time) VALUES " + ss.str()).c_str());
 }
 
 void Player::_SaveWeeklyQuestStatus(SQLTransaction& trans)
@@ -24499,16 +24564,18 @@ void Player::_SaveWeeklyQuestStatus(SQLTransaction& trans)
     stmt->setUInt32(0, GetRealGUIDLow());
     trans->Append(stmt);
 
+    std::ostringstream ss;
+
     for (QuestSet::const_iterator iter = m_weeklyquests.begin(); iter != m_weeklyquests.end(); ++iter)
     {
-        uint32 quest_id  = *iter;
+        if (iter != m_weeklyquests.begin())
+            ss << ',';
 
-        stmt = RealmDatabase.GetPreparedStatement(CHAR_INS_CHARACTER_WEEKLYQUESTSTATUS);
-        stmt->setUInt32(0, GetRealGUIDLow());
-        stmt->setUInt32(1, quest_id);
-        trans->Append(stmt);
+        ss << '(' << GetRealGUIDLow() << ',' << *iter << ')';
     }
 
+    trans->Append(("INSERT INTO character_queststatus_weekly (guid, quest) VALUES " + ss.str()).c_str());
+
     m_WeeklyQuestChanged = false;
 }
 
@@ -24522,21 +24589,23 @@ void Player::_SaveSeasonalQuestStatus(SQLTransaction& trans)
     stmt->setUInt32(0, GetRealGUIDLow());
     trans->Append(stmt);
 
+    std::ostringstream ss;
+
     for (SeasonalEventQuestMap::const_iterator iter = m_seasonalquests.begin(); iter != m_seasonalquests.end(); ++iter)
     {
         uint16 event_id = iter->first;
         for (SeasonalQuestSet::const_iterator itr = iter->second.begin(); itr != iter->second.end(); ++itr)
         {
-            uint32 quest_id = (*itr);
+            if (ss.tellp() > 0)
+                ss << ',';
 
-            stmt = RealmDatabase.GetPreparedStatement(CHAR_INS_CHARACTER_SEASONALQUESTSTATUS);
-            stmt->setUInt32(0, GetRealGUIDLow());
-            stmt->setUInt32(1, quest_id);
-            stmt->setUInt32(2, event_id);
-            trans->Append(stmt);
+            ss << '(' << GetRealGUIDLow() << ',' << (*itr) << ',' << uint32(event_id) << ')';
         }
     }
 
+    if (ss.tellp() > 0)
+        trans->Append(("INSERT INTO character_queststatus_seasonal (guid, quest, event) VALUES " + ss.str()).c_str());
+
     m_SeasonalQuestChanged = false;
 }
 
@@ -24550,15 +24619,18 @@ void Player::_SaveMonthlyQuestStatus(SQLTransaction& trans)
     stmt->setUInt32(0, GetRealGUIDLow());
     trans->Append(stmt);
 
+    std::ostringstream ss;
+
     for (QuestSet::const_iterator iter = m_monthlyquests.begin(); iter != m_monthlyquests.end(); ++iter)
     {
-        uint32 quest_id = *iter;
-        stmt = RealmDatabase.GetPreparedStatement(CHAR_INS_CHARACTER_MONTHLYQUESTSTATUS);
-        stmt->setUInt32(0, GetRealGUIDLow());
-        stmt->setUInt32(1, quest_id);
-        trans->Append(stmt);
+        if (iter != m_monthlyquests.begin())
+            ss << ',';
+
+        ss << '(' << GetRealGUIDLow() << ',' << *iter << ')';
     }
 
+    trans->Append(("INSERT INTO character_queststatus_monthly (guid, quest) VALUES " + ss.str()).c_str());
+
     m_MonthlyQuestChanged = false;
 }
 
@@ -24633,6 +24705,10 @@ void Player::_SaveSpells(SQLTransaction& charTrans, SQLTransaction& accountTrans
     uint32 l_ShopGroupRealmMask = sWorld->getIntConfig(WorldIntConfigs::CONFIG_ACCOUNT_BIND_SHOP_GROUP_MASK);
     PreparedStatement* stmt = NULL;
 
+    /// Character spells are coalesced in one DELETE and one REPLACE, the REPLACE is done last so a changed spell is still saved
+    std::ostringstream l_DeletedSpells;
+    std::ostringstream l_ReplacedSpells;
+
     for (PlayerSpellMap::iterator itr = m_spells.begin(); itr != m_spells.end();)
     {
         if (!itr->second)
@@ -24653,10 +24729,10 @@ void Player::_SaveSpells(SQLTransaction& charTrans, SQLTransaction& accountTrans
                 }
                 else
                 {
-                    stmt = RealmDatabase.GetPreparedStatement(CHAR_DEL_CHAR_SPELL_BY_SPELL);
-                    stmt->setUInt32(0, itr->first);
-                    stmt->setUInt32(1, GetRealGUIDLow());
-                    charTrans->Append(stmt);
+                    if (l_DeletedSpells.tellp() > 0)
+                        l_DeletedSpells << ',';
+
+                    l_DeletedSpells << itr->first;
                 }
             }
         }
@@ -24683,13 +24759,10 @@ void Player::_SaveSpells(SQLTransaction& charTrans, SQLTransaction& accountTrans
                 }
                 else
                 {
-                    stmt = RealmDatabase.GetPreparedStatement(CHAR_INS_CHAR_SPELL);
-                    stmt->setUInt32(0, GetRealGUIDLow());
-                    stmt->setUInt32(1, itr->first);
-                    stmt->setBool(2, itr->second->active);
-                    stmt->setBool(3, itr->second->disabled);
-                    stmt->setBool(4, itr->second->IsMountFavorite);
-                    charTrans->Append(stmt);
+                    if (l_ReplacedSpells.tellp() > 0)
+                        l_ReplacedSpells << ',';
+
+                    l_ReplacedSpells << '(' << GetRealGUIDLow() << ',' << itr->first << ',' << uint32(itr->second->active) << ',' << uint32(itr->second->disabled) << ',' << uint32(itr->second->IsMountFavorite) << ')';
                 }
             }
         }
@@ -24705,6 +24778,16 @@ void Player::_SaveSpells(SQLTransaction& charTrans, SQLTransaction& accountTrans
             ++itr;
         }
     }
+
+    if (l_DeletedSpells.tellp() > 0)
+    {
+        std::ostringstream ss;
+        ss << "DELETE FROM character_spell WHERE guid = " << GetRealGUIDLow() << " AND spell IN (" << l_DeletedSpells.str() << ')';
+        charTrans->Append(ss.str().c_str());
+    }
+
+    if (l_ReplacedSpells.tellp() > 0)
+        charTrans->Append(("REPLACE INTO character_spell (guid, spell, active, disabled, IsMountFavorite) VALUES " + l_ReplacedSpells.str()).c_str());
 }
 
 // save player stats -- only for external usage
@@ -24762,13 +24845,18 @@ void Player::_SaveCharacterGarrisonDailyTavernDatas(SQLTransaction& p_Transactio
     l_Stmt->setUInt32(0, GetGUIDLow());
     p_Transaction->Append(l_Stmt);
 
+    std::ostringstream l_Rows;
+
     for (uint32 l_TavernData : l_GarrisonMgr->GetGarrisonDailyTavernDatas())
     {
-        l_Stmt = CharacterDatabase.GetPreparedStatement(CHAR_ADD_GARRISON_DAILY_TAVERN_DATA_CHAR);
-        l_Stmt->setUInt32(0, GetGUIDLow());
-        l_Stmt->setUInt32(1, l_TavernData);
-        p_Transaction->Append(l_Stmt);
+        if (l_Rows.tellp() > 0)
+            l_Rows << ',';
+
+        l_Rows << '(' << GetGUIDLow() << ',' << l_TavernData << ')';
     }
+
+    if (l_Rows.tellp() > 0)
+        p_Transaction->Append(("INSERT INTO character_garrison_daily_tavern_data (CharacterGuid, NpcEntry) VALUES " + l_Rows.str()).c_str());
 }
 
 void Player::_SaveCharacterGarrisonWeeklyTavernDatas(SQLTransaction& p_Transaction)
@@ -24782,25 +24870,28 @@ void Player::_SaveCharacterGarrisonWeeklyTavernDatas(SQLTransaction& p_Transacti
     l_Stmt->setUInt32(0, GetGUIDLow());
     p_Transaction->Append(l_Stmt);
 
+    std::ostringstream l_Rows;
+
     for (MS::Garrison::WeeklyTavernData l_TavernData : l_GarrisonMgr->GetGarrisonWeeklyTavernDatas())
     {
-        l_Stmt = CharacterDatabase.GetPreparedStatement(CHAR_ADD_GARRISON_WEEKLY_TAVERN_DATA_CHAR);
-        l_Stmt->setUInt32(0, GetGUIDLow());
-        l_Stmt->setUInt32(1, l_TavernData.FollowerID);
+        if (l_Rows.tellp() > 0)
+            l_Rows << ',';
 
-        std::ostringstream l_Abilities;
+        l_Rows << '(' << GetGUIDLow() << ',' << l_TavernData.FollowerID << ",'";
 
         for (uint32 l_Ability : l_TavernData.Abilities)
         {
             if (l_Ability != l_TavernData.Abilities.back())
-                l_Abilities << l_Ability << ' ';
+                l_Rows << l_Ability << ' ';
             else
-                l_Abilities << l_Ability;
+                l_Rows << l_Ability;
         }
 
-        l_Stmt->setString(2, l_Abilities.str());
-        p_Transaction->Append(l_Stmt);
+        l_Rows << "')";
     }
+
+    if (l_Rows.tellp() > 0)
+        p_Transaction->Append(("REPLACE INTO character_garrison_weekly_tavern_data (CharacterGuid, FollowerID, Abilities) VALUES " + l_Rows.str()).c_str());
 }
 
 #endif /* not CROSS */
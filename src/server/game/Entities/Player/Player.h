@@ -43,6 +43,7 @@
 // for template
 #include "SpellMgr.h"
 #include <ace/Stack_Trace.h>
+#include <atomic>
 #include <chrono>
 #include <deque>
 
@@ -71,6 +72,10 @@ typedef std::set<uint32> DailyLootsCooldowns;
 
 typedef std::chrono::system_clock Clock;
 
+extern std::atomic<uint64> gPlayerSaveCount;            ///< Player::SaveToDB calls that reached the database
+extern std::atomic<uint64> gPlayerSaveStatementCount;   ///< Statements queued by these saves, character and account transactions
+extern std::atomic<uint64> gPlayerSaveMaxStatementCount;
+
 #define PLAYER_MAX_SKILLS           128
 #define DEFAULT_MAX_PRIMARY_TRADE_SKILL 2
 #define PLAYER_EXPLORED_ZONES_SIZE  256
@@ -2112,6 +2117,9 @@ class Player : public Unit, public GridObject<Player>
 
         void SaveToDB(bool create = false, MS::Utilities::CallBackPtr p_Callback = nullptr);
         void SaveInventoryAndGoldToDB(SQLTransaction& trans);                    // fast save function for item/money cheating preventing
+        /// Forget what the last save wrote, the next save rewrites every fingerprinted block
+        /// Must be called when the character rows may have been written by someone else (ie: cross realm)
+        void ResetSaveFingerprints();
         void SaveGoldToDB(SQLTransaction& trans);
 
         static void SetUInt32ValueInArray(Tokenizer& data, uint16 index, uint32 value);
@@ -3947,6 +3955,22 @@ class Player : public Unit, public GridObject<Player>
         void _SaveCharacterGarrisonWeeklyTavernDatas(SQLTransaction& p_Transaction);
 #endif /* not CROSS */
 
+        /// Blocks fully rewritten (delete + insert) at each save, skipped when their rows didn't change
+        enum SaveFingerprint
+        {
+            SAVE_FINGERPRINT_AURAS,
+            SAVE_FINGERPRINT_SPELL_COOLDOWNS,
+            SAVE_FINGERPRINT_CHARGES_COOLDOWNS,
+            SAVE_FINGERPRINT_MAX
+        };
+
+        /// Store the fingerprint of the rows and return true if they differ from the last saved ones
+        static bool UpdateSaveFingerprint(size_t& p_Fingerprint, std::string const& p_Rows);
+
+        size_t m_SaveFingerprints[SAVE_FINGERPRINT_MAX];                    ///< 0 if unknown
+        size_t m_VoidStorageSaveFingerprints[VOID_STORAGE_MAX_SLOT];       ///< 0 if unknown
+        MS::Utilities::CallBackPtr m_LastSaveCallback;                      ///< Transaction of the last save, which recorded the fingerprints
+
         /*********************************************************/
         /***              ENVIRONMENTAL SYSTEM                 ***/
         /*********************************************************/
@@ -339,20 +339,16 @@ void Transport::LoadStaticPassengers()
 {
     if (uint32 mapId = GetGOInfo()->moTransport.mapID)
     {
-        CellObjectGuidsMap const& cells = sObjectMgr->GetMapObjectGuids(mapId, GetMap()->GetSpawnMode());
-        CellGuidSet::const_iterator guidEnd;
-        for (CellObjectGuidsMap::const_iterator cellItr = cells.begin(); cellItr != cells.end(); ++cellItr)
-        {
-            // Creatures on transport
-            guidEnd = cellItr->second.creatures.end();
-            for (CellGuidSet::const_iterator guidItr = cellItr->second.creatures.begin(); guidItr != guidEnd; ++guidItr)
-                CreateNPCPassenger(*guidItr, sObjectMgr->GetCreatureData(*guidItr));
-
-            // GameObjects on transport
-            guidEnd = cellItr->second.gameobjects.end();
-            for (CellGuidSet::const_iterator guidItr = cellItr->second.gameobjects.begin(); guidItr != guidEnd; ++guidItr)
-                CreateGOPassenger(*guidItr, sObjectMgr->GetGOData(*guidItr));
-        }
+        CellObjectGuids guids;
+        sObjectMgr->GetMapObjectGuids(mapId, GetMap()->GetSpawnMode(), guids);
+
+        // Creatures on transport
+        for (std::vector<uint32>::const_iterator guidItr = guids.creatures.begin(); guidItr != guids.creatures.end(); ++guidItr)
+            CreateNPCPassenger(*guidItr, sObjectMgr->GetCreatureData(*guidItr));
+
+        // GameObjects on transport
+        for (std::vector<uint32>::const_iterator guidItr = guids.gameobjects.begin(); guidItr != guids.gameobjects.end(); ++guidItr)
+            CreateGOPassenger(*guidItr, sObjectMgr->GetGOData(*guidItr));
     }
 }
 
@@ -2284,7 +2284,7 @@ SpellSchoolMask Unit::CalcAbsorbResist(Unit* victim, SpellSchoolMask schoolMask,
     // We're going to call functions which can modify content of the list during iteration over it's elements
     // Let's copy the list so we can prevent iterator invalidation
     AuraEffectList vSchoolAbsorbCopy(victim->GetAuraEffectsByType(SPELL_AURA_SCHOOL_ABSORB));
-    vSchoolAbsorbCopy.sort(JadeCore::AbsorbAuraOrderPred());
+    std::stable_sort(vSchoolAbsorbCopy.begin(), vSchoolAbsorbCopy.end(), JadeCore::AbsorbAuraOrderPred());
 
     // absorb without mana cost
     for (AuraEffectList::iterator itr = vSchoolAbsorbCopy.begin(); (itr != vSchoolAbsorbCopy.end()) && (dmgInfo.GetDamage() > 0); ++itr)
@@ -4154,10 +4154,19 @@ void Unit::_RemoveNoStackAurasDueToAura(Aura* aura)
 
 void Unit::_RegisterAuraEffect(AuraEffect* aurEff, bool apply)
 {
+    AuraEffectList& effects = m_modAuras[aurEff->GetAuraType()];
+
     if (apply)
-        m_modAuras[aurEff->GetAuraType()].push_back(aurEff);
+        effects.push_back(aurEff);
     else
-        m_modAuras[aurEff->GetAuraType()].remove(aurEff);
+    {
+        // Keep the application order, absorb and proc handling rely on it
+        AuraEffectList::iterator itr = std::find(effects.begin(), effects.end(), aurEff);
+        if (itr != effects.end())
+            effects.erase(itr);
+    }
+
+    InvalidateAuraModifierCache(aurEff->GetAuraType());
 }
 
 // All aura base removes should go threw this function!
@@ -4444,45 +4453,50 @@ void Unit::RemoveAurasDueToItemSpell(Item* castItem, uint32 spellId)
 
 void Unit::RemoveAurasByType(AuraType auraType, uint64 casterGUID, Aura* exceptAura, uint32 exceptAuraId, bool negative, bool positive)
 {
-    for (AuraEffectList::iterator iter = m_modAuras[auraType].begin(); iter != m_modAuras[auraType].end();)
+    // Index based, removing an aura shifts the following effects of the vector
+    for (size_t i = 0; i < m_modAuras[auraType].size();)
     {
-        Aura* aura = (*iter)->GetBase();
+        AuraEffect* aurEff = m_modAuras[auraType][i];
+        Aura* aura = aurEff->GetBase();
         AuraApplication * aurApp = aura->GetApplicationOfTarget(GetGUID());
 
         if (!aurApp)
         {
-            ++iter;
+            ++i;
             continue;
         }
 
-        ++iter;
-
         if (aura != exceptAura && aura->GetId() != exceptAuraId && (!casterGUID || aura->GetCasterGUID() == casterGUID)
             && ((negative && !aurApp->IsPositive()) || (positive && aurApp->IsPositive())))
         {
             uint32 removedAuras = m_removedAurasCount;
             RemoveAura(aurApp);
             if (m_removedAurasCount > removedAuras + 1)
-                iter = m_modAuras[auraType].begin();
+                i = 0;
+            else if (i < m_modAuras[auraType].size() && m_modAuras[auraType][i] == aurEff)
+                ++i;
+            continue;
         }
+
+        ++i;
     }
 }
 
 void Unit::RemoveEffectsByType(AuraType auraType, uint64 casterGUID, Aura* exceptAura, uint32 exceptAuraId, bool negative, bool positive)
 {
-    for (AuraEffectList::iterator iter = m_modAuras[auraType].begin(); iter != m_modAuras[auraType].end();)
+    // Index based, removing an aura shifts the following effects of the vector
+    for (size_t i = 0; i < m_modAuras[auraType].size();)
     {
-        Aura* aura = (*iter)->GetBase();
+        AuraEffect* aurEff = m_modAuras[auraType][i];
+        Aura* aura = aurEff->GetBase();
         AuraApplication * aurApp = aura->GetApplicationOfTarget(GetGUID());
 
         if (!aurApp)
         {
-            ++iter;
+            ++i;
             continue;
         }
 
-        ++iter;
-
         if (aura != exceptAura && aura->GetId() != exceptAuraId && (!casterGUID || aura->GetCasterGUID() == casterGUID)
             && ((negative && !aurApp->IsPositive()) || (positive && aurApp->IsPositive())))
         {
@@ -4506,9 +4520,15 @@ void Unit::RemoveEffectsByType(AuraType auraType, uint64 casterGUID, Aura* excep
             {
                 RemoveAura(aurApp);
                 if (m_removedAurasCount > removedAuras + 1)
-                    iter = m_modAuras[auraType].begin();
+                {
+                    i = 0;
+                    continue;
+                }
             }
         }
+
+        if (i < m_modAuras[auraType].size() && m_modAuras[auraType][i] == aurEff)
+            ++i;
     }
 }
 
@@ -5008,7 +5028,7 @@ void Unit::_ApplyAllAuraStatMods()
         (*i).second->GetBase()->HandleAllEffects(i->second, AURA_EFFECT_HANDLE_STAT, true);
 }
 
-std::list<AuraEffect*> Unit::GetAuraEffectsByMechanic(uint32 mechanic_mask) const
+Unit::AuraEffectList Unit::GetAuraEffectsByMechanic(uint32 mechanic_mask) const
 {
     AuraEffectList list;
     for (AuraApplicationMap::const_iterator iter = m_appliedAuras.begin(); iter != m_appliedAuras.end(); ++iter)
@@ -5332,18 +5352,20 @@ uint32 Unit::GetDiseasesByCaster(uint64 casterGUID, bool remove)
     uint32 diseases = 0;
     for (AuraType const* itr = &diseaseAuraTypes[0]; itr && itr[0] != SPELL_AURA_NONE; ++itr)
     {
-        for (AuraEffectList::iterator i = m_modAuras[*itr].begin(); i != m_modAuras[*itr].end();)
+        for (size_t i = 0; i < m_modAuras[*itr].size();)
         {
+            AuraEffect* aurEff = m_modAuras[*itr][i];
+
             // Get auras with disease dispel type by caster
-            if ((*i)->GetSpellInfo()->Dispel == DISPEL_DISEASE
-                && (*i)->GetCasterGUID() == casterGUID)
+            if (aurEff->GetSpellInfo()->Dispel == DISPEL_DISEASE
+                && aurEff->GetCasterGUID() == casterGUID)
             {
                 ++diseases;
 
                 if (remove)
                 {
-                    RemoveAura((*i)->GetId(), (*i)->GetCasterGUID());
-                    i = m_modAuras[*itr].begin();
+                    RemoveAura(aurEff->GetId(), aurEff->GetCasterGUID());
+                    i = 0;
                     continue;
                 }
             }
@@ -5386,6 +5408,9 @@ uint32 Unit::GetDoTsByCaster(uint64 casterGUID) const
 
 int32 Unit::GetTotalAuraModifier(AuraType auratype, AuraEffect const* excludeAura /* nullptr*/, AuraEffect* includeAura /* nullptr*/) const
 {
+    if (!excludeAura && !includeAura)
+        return GetAuraModifierTotals(auratype).Total;
+
     std::map<SpellGroup, int32> SameEffectSpellGroup;
     int32 modifier = 0;
 
@@ -5410,59 +5435,24 @@ int32 Unit::GetTotalAuraModifier(AuraType auratype, AuraEffect const* excludeAur
 
 float Unit::GetTotalAuraMultiplier(AuraType auratype) const
 {
-    float multiplier = 1.0f;
-
-    std::map<SpellGroup, int32> SameEffectSpellGroup;
-    AuraEffectList const& mTotalAuraList = GetAuraEffectsByType(auratype);
-    for (AuraEffectList::const_iterator i = mTotalAuraList.begin(); i != mTotalAuraList.end(); ++i)
-    {
-        /// Check if the Aura Effect has a the Same Effect Stack Rule and if so, use the highest amount of that SpellGroupSameEffectSpellGrou
-        /// If the Aura Effect does not have this Stack Rule, it returns false so we can add to the multiplier as usual
-        if (!sSpellMgr->AddSameEffectStackRuleSpellGroups((*i)->GetSpellInfo(), (*i)->GetAmount(), SameEffectSpellGroup))
-            AddPct(multiplier, (*i)->GetAmount());
-    }
-    /// Add the highest of the Same Effect Stack Rule SpellGroups to the multiplier
-    for (std::map<SpellGroup, int32>::const_iterator itr = SameEffectSpellGroup.begin(); itr != SameEffectSpellGroup.end(); ++itr)
-        AddPct(multiplier, itr->second);
-
-    return multiplier;
+    return GetAuraModifierTotals(auratype).Multiplier;
 }
 
 int32 Unit::GetMaxPositiveAuraModifier(AuraType auratype)
 {
-    int32 modifier = 0;
-
-    AuraEffectList const& mTotalAuraList = GetAuraEffectsByType(auratype);
-    for (AuraEffectList::const_iterator i = mTotalAuraList.begin(); i != mTotalAuraList.end(); ++i)
-    {
-        if ((*i)->GetAmount() > modifier)
-            modifier = (*i)->GetAmount();
-    }
-
-    return modifier;
+    return GetAuraModifierTotals(auratype).MaxPositive;
 }
 
 int32 Unit::GetMaxNegativeAuraModifier(AuraType auratype) const
 {
-    int32 modifier = 0;
-
-    AuraEffectList const& mTotalAuraList = GetAuraEffectsByType(auratype);
-    for (AuraEffectList::const_iterator i = mTotalAuraList.begin(); i != mTotalAuraList.end(); ++i)
-    {
-        if ((*i)->GetAmount() < modifier)
-        {
-            if ((*i)->GetBase()->GetId() == 116 && auratype == SPELL_AURA_MOD_DECREASE_SPEED) // Frostbolt speed reduction is always at 50%
-                modifier = (*i)->GetBaseAmount();
-            else
-                modifier = (*i)->GetAmount();
-        }
-    }
-
-    return modifier;
+    return GetAuraModifierTotals(auratype).MaxNegative;
 }
 
 int32 Unit::GetTotalAuraModifierByMiscMask(AuraType auratype, uint32 misc_mask, AuraEffect const* excludeAura /* nullptr*/, AuraEffect* includeAura /* nullptr*/) const
 {
+    if (!excludeAura && !includeAura)
+        return GetAuraModifierTotals(auratype, AURA_MODIFIER_FILTER_MISC_MASK, misc_mask).Total;
+
     std::map<SpellGroup, int32> SameEffectSpellGroup;
     int32 modifier = 0;
 
@@ -5512,29 +5502,14 @@ int32 Unit::GetTotalAuraModifierByMiscBMask(AuraType auratype, uint32 misc_mask,
 
 float Unit::GetTotalAuraMultiplierByMiscMask(AuraType auratype, uint32 misc_mask) const
 {
-    std::map<SpellGroup, int32> SameEffectSpellGroup;
-    float multiplier = 1.0f;
-
-    AuraEffectList const& mTotalAuraList = GetAuraEffectsByType(auratype);
-    for (AuraEffectList::const_iterator i = mTotalAuraList.begin(); i != mTotalAuraList.end(); ++i)
-    {
-        if (((*i)->GetMiscValue() & misc_mask))
-        {
-            // Check if the Aura Effect has a the Same Effect Stack Rule and if so, use the highest amount of that SpellGroup
-            // If the Aura Effect does not have this Stack Rule, it returns false so we can add to the multiplier as usual
-            if (!sSpellMgr->AddSameEffectStackRuleSpellGroups((*i)->GetSpellInfo(), (*i)->GetAmount(), SameEffectSpellGroup))
-                AddPct(multiplier, (*i)->GetAmount());
-        }
-    }
-    // Add the highest of the Same Effect Stack Rule SpellGroups to the multiplier
-    for (std::map<SpellGroup, int32>::const_iterator itr = SameEffectSpellGroup.begin(); itr != SameEffectSpellGroup.end(); ++itr)
-        AddPct(multiplier, itr->second);
-
-    return multiplier;
+    return GetAuraModifierTotals(auratype, AURA_MODIFIER_FILTER_MISC_MASK, misc_mask).Multiplier;
 }
 
 int32 Unit::GetMaxPositiveAuraModifierByMiscMask(AuraType auratype, uint32 misc_mask, AuraEffect const* except) const
 {
+    if (!except)
+        return GetAuraModifierTotals(auratype, AURA_MODIFIER_FILTER_MISC_MASK, misc_mask).MaxPositive;
+
     int32 modifier = 0;
 
     AuraEffectList const& mTotalAuraList = GetAuraEffectsByType(auratype);
@@ -5549,82 +5524,100 @@ int32 Unit::GetMaxPositiveAuraModifierByMiscMask(AuraType auratype, uint32 misc_
 
 int32 Unit::GetMaxNegativeAuraModifierByMiscMask(AuraType auratype, uint32 misc_mask) const
 {
-    int32 modifier = 0;
-
-    AuraEffectList const& mTotalAuraList = GetAuraEffectsByType(auratype);
-    for (AuraEffectList::const_iterator i = mTotalAuraList.begin(); i != mTotalAuraList.end(); ++i)
-    {
-        if ((*i)->GetMiscValue()& misc_mask && (*i)->GetAmount() < modifier)
-            modifier = (*i)->GetAmount();
-    }
-
-    return modifier;
+    return GetAuraModifierTotals(auratype, AURA_MODIFIER_FILTER_MISC_MASK, misc_mask).MaxNegative;
 }
 
 int32 Unit::GetTotalAuraModifierByMiscValue(AuraType auratype, int32 misc_value) const
 {
-    std::map<SpellGroup, int32> SameEffectSpellGroup;
-    int32 modifier = 0;
-
-    AuraEffectList const& mTotalAuraList = GetAuraEffectsByType(auratype);
-    for (AuraEffectList::const_iterator i = mTotalAuraList.begin(); i != mTotalAuraList.end(); ++i)
-    {
-        if ((*i)->GetMiscValue() == misc_value)
-            if (!sSpellMgr->AddSameEffectStackRuleSpellGroups((*i)->GetSpellInfo(), (*i)->GetAmount(), SameEffectSpellGroup))
-                modifier += (*i)->GetAmount();
-    }
+    return GetAuraModifierTotals(auratype, AURA_MODIFIER_FILTER_MISC_VALUE, uint32(misc_value)).Total;
+}
 
-    for (std::map<SpellGroup, int32>::const_iterator itr = SameEffectSpellGroup.begin(); itr != SameEffectSpellGroup.end(); ++itr)
-        modifier += itr->second;
+float Unit::GetTotalAuraMultiplierByMiscValue(AuraType auratype, int32 misc_value) const
+{
+    return GetAuraModifierTotals(auratype, AURA_MODIFIER_FILTER_MISC_VALUE, uint32(misc_value)).Multiplier;
+}
 
-    return modifier;
+int32 Unit::GetMaxPositiveAuraModifierByMiscValue(AuraType auratype, int32 misc_value) const
+{
+    return GetAuraModifierTotals(auratype, AURA_MODIFIER_FILTER_MISC_VALUE, uint32(misc_value)).MaxPositive;
 }
 
-float Unit::GetTotalAuraMultiplierByMiscValue(AuraType auratype, int32 misc_value) const
+int32 Unit::GetMaxNegativeAuraModifierByMiscValue(AuraType auratype, int32 misc_value) const
 {
-    std::map<SpellGroup, int32> SameEffectSpellGroup;
-    float multiplier = 1.0f;
+    return GetAuraModifierTotals(auratype, AURA_MODIFIER_FILTER_MISC_VALUE, uint32(misc_value)).MaxNegative;
+}
 
-    AuraEffectList const& mTotalAuraList = GetAuraEffectsByType(auratype);
-    for (AuraEffectList::const_iterator i = mTotalAuraList.begin(); i != mTotalAuraList.end(); ++i)
+Unit::AuraModifierTotals Unit::GetAuraModifierTotals(AuraType p_AuraType, AuraModifierFilter p_Filter, uint32 p_FilterValue) const
+{
+    if (m_modAuras[p_AuraType].empty())
     {
-        if ((*i)->GetMiscValue() == misc_value)
-            if (!sSpellMgr->AddSameEffectStackRuleSpellGroups((*i)->GetSpellInfo(), (*i)->GetAmount(), SameEffectSpellGroup))
-                AddPct(multiplier, (*i)->GetAmount());
+        AuraModifierTotals l_Empty = { 0, 1.0f, 0, 0 };
+        return l_Empty;
     }
 
-    for (std::map<SpellGroup, int32>::const_iterator itr = SameEffectSpellGroup.begin(); itr != SameEffectSpellGroup.end(); ++itr)
-        AddPct(multiplier, itr->second);
+    uint64 l_Key = (uint64(p_Filter) << 32) | p_FilterValue;
 
-    return multiplier;
+    AuraModifierTotalsMap& l_TypeCache = m_auraModifierCache[p_AuraType];
+
+    AuraModifierTotalsMap::const_iterator l_Itr = l_TypeCache.find(l_Key);
+    if (l_Itr != l_TypeCache.end())
+        return l_Itr->second;
+
+    AuraModifierTotals& l_Totals = l_TypeCache[l_Key];
+    ComputeAuraModifierTotals(p_AuraType, p_Filter, p_FilterValue, l_Totals);
+    return l_Totals;
 }
 
-int32 Unit::GetMaxPositiveAuraModifierByMiscValue(AuraType auratype, int32 misc_value) const
+void Unit::ComputeAuraModifierTotals(AuraType p_AuraType, AuraModifierFilter p_Filter, uint32 p_FilterValue, AuraModifierTotals& p_Totals) const
 {
-    int32 modifier = 0;
+    p_Totals.Total       = 0;
+    p_Totals.Multiplier  = 1.0f;
+    p_Totals.MaxPositive = 0;
+    p_Totals.MaxNegative = 0;
 
-    AuraEffectList const& mTotalAuraList = GetAuraEffectsByType(auratype);
-    for (AuraEffectList::const_iterator i = mTotalAuraList.begin(); i != mTotalAuraList.end(); ++i)
+    /// Effects sharing a Same Effect Stack Rule spell group only count for the highest amount of the group
+    std::map<SpellGroup, int32> l_TotalGroups;
+    std::map<SpellGroup, int32> l_MultiplierGroups;
+
+    for (AuraEffect const* l_Effect : m_modAuras[p_AuraType])
     {
-        if ((*i)->GetMiscValue() == misc_value && (*i)->GetAmount() > modifier)
-            modifier = (*i)->GetAmount();
-    }
+        if (p_Filter == AURA_MODIFIER_FILTER_MISC_VALUE && l_Effect->GetMiscValue() != int32(p_FilterValue))
+            continue;
 
-    return modifier;
-}
+        if (p_Filter == AURA_MODIFIER_FILTER_MISC_MASK && !(l_Effect->GetMiscValue() & p_FilterValue))
+            continue;
 
-int32 Unit::GetMaxNegativeAuraModifierByMiscValue(AuraType auratype, int32 misc_value) const
-{
-    int32 modifier = 0;
+        int32 l_Amount = l_Effect->GetAmount();
 
-    AuraEffectList const& mTotalAuraList = GetAuraEffectsByType(auratype);
-    for (AuraEffectList::const_iterator i = mTotalAuraList.begin(); i != mTotalAuraList.end(); ++i)
-    {
-        if ((*i)->GetMiscValue() == misc_value && (*i)->GetAmount() < modifier)
-            modifier = (*i)->GetAmount();
+        if (!sSpellMgr->AddSameEffectStackRuleSpellGroups(l_Effect->GetSpellInfo(), l_Amount, l_TotalGroups))
+            p_Totals.Total += l_Amount;
+
+        if (!sSpellMgr->AddSameEffectStackRuleSpellGroups(l_Effect->GetSpellInfo(), l_Amount, l_MultiplierGroups))
+            AddPct(p_Totals.Multiplier, l_Amount);
+
+        if (l_Amount > p_Totals.MaxPositive)
+            p_Totals.MaxPositive = l_Amount;
+
+        if (l_Amount < p_Totals.MaxNegative)
+        {
+            /// Frostbolt speed reduction is always at 50%
+            if (p_Filter == AURA_MODIFIER_FILTER_NONE && p_AuraType == SPELL_AURA_MOD_DECREASE_SPEED && l_Effect->GetBase()->GetId() == 116)
+                p_Totals.MaxNegative = l_Effect->GetBaseAmount();
+            else
+                p_Totals.MaxNegative = l_Amount;
+        }
     }
 
-    return modifier;
+    for (std::map<SpellGroup, int32>::const_iterator l_Itr = l_TotalGroups.begin(); l_Itr != l_TotalGroups.end(); ++l_Itr)
+        p_Totals.Total += l_Itr->second;
+
+    for (std::map<SpellGroup, int32>::const_iterator l_Itr = l_MultiplierGroups.begin(); l_Itr != l_MultiplierGroups.end(); ++l_Itr)
+        AddPct(p_Totals.Multiplier, l_Itr->second);
+}
+
+void Unit::InvalidateAuraModifierCache(AuraType p_AuraType)
+{
+    m_auraModifierCache.erase(p_AuraType);
 }
 
 int32 Unit::GetTotalAuraModifierByAffectMask(AuraType auratype, SpellInfo const* affectedSpell) const
@@ -22598,38 +22591,40 @@ void Unit::BuildValuesUpdate(uint8 updateType, ByteBuffer* data, Player* target)
     if (!target)
         return;
 
+    uint32* flags;
+    uint32 visibleFlag = GetUpdateFieldData(target, flags);
+
+    BuildValuesUpdateForVisibility(updateType, data, visibleFlag, flags, target, nullptr);
+}
+
+void Unit::BuildValuesUpdateForVisibility(uint8 p_UpdateType, ByteBuffer* p_Data, uint32 p_VisibleFlag, uint32 const* p_Flags, Player* p_Target, ValuesUpdateCache::PatchList* p_Patches) const
+{
     ByteBuffer fieldBuffer;
 
     UpdateMask updateMask;
     updateMask.SetCount(m_valuesCount);
 
-    uint32* flags;
-    uint32 visibleFlag = GetUpdateFieldData(target, flags);
+    size_t l_FirstPatch = p_Patches ? p_Patches->size() : 0;
 
-    Creature const* creature = ToCreature();
     for (uint16 index = 0; index < m_valuesCount; ++index)
     {
-        if (_fieldNotifyFlags & flags[index] ||
-            ((flags[index] & visibleFlag) & UF_FLAG_SPECIAL_INFO) ||
-            ((updateType == UPDATETYPE_VALUES ? _changesMask.GetBit(index) : m_uint32Values[index]) && (flags[index] & visibleFlag)) ||
+        if (_fieldNotifyFlags & p_Flags[index] ||
+            ((p_Flags[index] & p_VisibleFlag) & UF_FLAG_SPECIAL_INFO) ||
+            ((p_UpdateType == UPDATETYPE_VALUES ? _changesMask.GetBit(index) : m_uint32Values[index]) && (p_Flags[index] & p_VisibleFlag)) ||
             (index == UNIT_FIELD_AURA_STATE && HasFlag(UNIT_FIELD_AURA_STATE, PER_CASTER_AURA_STATE_MASK)))
         {
             updateMask.SetBit(index);
 
-            if (index == UNIT_FIELD_NPC_FLAGS)
+            if (IsViewerDependentField(index))
             {
-                uint32 appendValue = m_uint32Values[UNIT_FIELD_NPC_FLAGS];
-
-                if (creature)
-                    if (!target->canSeeSpellClickOn(creature))
-                        appendValue &= ~UNIT_NPC_FLAG_SPELLCLICK;
-
-                fieldBuffer << uint32(appendValue);
-            }
-            else if (index == UNIT_FIELD_AURA_STATE)
-            {
-                // Check per caster aura states to not enable using a spell in client if specified aura is not by target
-                fieldBuffer << BuildAuraStateUpdateForTarget(target);
+                /// Shared block, the value is written per viewer later
+                if (!p_Target)
+                {
+                    p_Patches->push_back(std::make_pair(uint32(fieldBuffer.wpos()), index));
+                    fieldBuffer << uint32(0);
+                }
+                else
+                    fieldBuffer << GetViewerDependentFieldValue(index, p_Target);
             }
             // FIXME: Some values at server stored in float format but must be sent to client in uint32 format
             else if (index >= UNIT_FIELD_ATTACK_ROUND_BASE_TIME && index <= UNIT_FIELD_RANGED_ATTACK_ROUND_BASE_TIME)
@@ -22645,116 +22640,162 @@ void Unit::BuildValuesUpdate(uint8 updateType, ByteBuffer* data, Player* target)
             {
                 fieldBuffer << uint32(m_floatValues[index]);
             }
-            // Gamemasters should be always able to select units - remove not selectable flag
-            else if (index == UNIT_FIELD_FLAGS)
+            else
             {
-                uint32 appendValue = m_uint32Values[UNIT_FIELD_FLAGS];
-                if (target->isGameMaster())
-                    appendValue &= ~UNIT_FLAG_NOT_SELECTABLE;
-
-                fieldBuffer << uint32(appendValue);
+                // send in current format (float as float, uint32 as uint32)
+                fieldBuffer << m_uint32Values[index];
             }
-            // use modelid_a if not gm, _h if gm for CREATURE_FLAG_EXTRA_TRIGGER creatures
-            else if (index == UNIT_FIELD_DISPLAY_ID)
-            {
-                uint32 displayId = m_uint32Values[UNIT_FIELD_DISPLAY_ID];
-                if (creature)
-                {
-                    CreatureTemplate const* cinfo = creature->GetCreatureTemplate();
+        }
+    }
 
-                    // this also applies for transform auras
-                    if (SpellInfo const* transform = sSpellMgr->GetSpellInfo(getTransForm()))
-                        for (uint8 i = 0; i < transform->EffectCount; ++i)
-                            if (transform->Effects[i].IsAura(SPELL_AURA_TRANSFORM))
-                                if (CreatureTemplate const* transformInfo = sObjectMgr->GetCreatureTemplate(transform->Effects[i].MiscValue))
-                                {
-                                    cinfo = transformInfo;
-                                    break;
-                                }
+    *p_Data << uint8(updateMask.GetBlockCount());
+    updateMask.AppendToPacket(p_Data);
 
-                    if (cinfo->flags_extra & CREATURE_FLAG_EXTRA_TRIGGER)
-                    {
-                        if (target->isGameMaster())
-                        {
-                            if (cinfo->Modelid1)
-                                displayId = cinfo->Modelid1; // Modelid1 is a visible model for gms
-                            else
-                                displayId = 17519; // world visible trigger's model
-                        }
-                        else
-                        {
-                            if (cinfo->Modelid2)
-                                displayId = cinfo->Modelid2; // Modelid2 is an invisible model for players
-                            else
-                                displayId = 11686; // world invisible trigger's model
-                        }
-                    }
-                }
+    /// Patch offsets are relative to the field buffer until it's appended
+    if (p_Patches)
+    {
+        for (size_t l_I = l_FirstPatch; l_I < p_Patches->size(); ++l_I)
+            (*p_Patches)[l_I].first += uint32(p_Data->wpos());
+    }
 
-                fieldBuffer << uint32(displayId);
-            }
-            // hide lootable animation for unallowed players
-            else if (index == OBJECT_FIELD_DYNAMIC_FLAGS)
-            {
-                uint32 dynamicFlags = m_uint32Values[OBJECT_FIELD_DYNAMIC_FLAGS] & ~(UNIT_DYNFLAG_TAPPED | UNIT_DYNFLAG_TAPPED_BY_PLAYER);
+    p_Data->append(fieldBuffer);
+}
 
-                if (creature)
-                {
-                    if (creature->hasLootRecipient())
-                    {
-                        dynamicFlags |= UNIT_DYNFLAG_TAPPED;
-                        if (creature->isTappedBy(target))
-                            dynamicFlags |= UNIT_DYNFLAG_TAPPED_BY_PLAYER;
-                    }
+bool Unit::IsViewerDependentField(uint16 p_Index)
+{
+    switch (p_Index)
+    {
+        case UNIT_FIELD_NPC_FLAGS:
+        case UNIT_FIELD_AURA_STATE:
+        case UNIT_FIELD_FLAGS:
+        case UNIT_FIELD_DISPLAY_ID:
+        case OBJECT_FIELD_DYNAMIC_FLAGS:
+        case UNIT_FIELD_SHAPESHIFT_FORM:
+        case UNIT_FIELD_FACTION_TEMPLATE:
+            return true;
+        default:
+            return false;
+    }
+}
 
-                    if (!target->isAllowedToLoot(creature))
-                        dynamicFlags &= ~UNIT_DYNFLAG_LOOTABLE;
-                }
+uint32 Unit::GetViewerDependentFieldValue(uint16 index, Player* target) const
+{
+    Creature const* creature = ToCreature();
 
-                // unit UNIT_DYNFLAG_TRACK_UNIT should only be sent to caster of SPELL_AURA_MOD_STALKED auras
-                if (dynamicFlags & UNIT_DYNFLAG_TRACK_UNIT)
-                    if (!HasAuraTypeWithCaster(SPELL_AURA_MOD_STALKED, target->GetGUID()))
-                        dynamicFlags &= ~UNIT_DYNFLAG_TRACK_UNIT;
+    if (index == UNIT_FIELD_NPC_FLAGS)
+    {
+        uint32 appendValue = m_uint32Values[UNIT_FIELD_NPC_FLAGS];
 
-                fieldBuffer << dynamicFlags;
-            }
-            // FG: pretend that OTHER players in own group are friendly ("blue")
-            else if (index == UNIT_FIELD_SHAPESHIFT_FORM || index == UNIT_FIELD_FACTION_TEMPLATE)
-            {
-                uint32 l_Value = m_uint32Values[index];
-                if (index == UNIT_FIELD_FACTION_TEMPLATE && creature && creature->IsAIEnabled)
-                    creature->AI()->OnSendFactionTemplate(l_Value, target);
+        if (creature)
+            if (!target->canSeeSpellClickOn(creature))
+                appendValue &= ~UNIT_NPC_FLAG_SPELLCLICK;
+
+        return appendValue;
+    }
+    else if (index == UNIT_FIELD_AURA_STATE)
+    {
+        // Check per caster aura states to not enable using a spell in client if specified aura is not by target
+        return BuildAuraStateUpdateForTarget(target);
+    }
+    // Gamemasters should be always able to select units - remove not selectable flag
+    else if (index == UNIT_FIELD_FLAGS)
+    {
+        uint32 appendValue = m_uint32Values[UNIT_FIELD_FLAGS];
+        if (target->isGameMaster())
+            appendValue &= ~UNIT_FLAG_NOT_SELECTABLE;
 
-                if (IsControlledByPlayer() && target != this && sWorld->getBoolConfig(CONFIG_ALLOW_TWO_SIDE_INTERACTION_GROUP) && IsInRaidWith(target))
+        return appendValue;
+    }
+    // use modelid_a if not gm, _h if gm for CREATURE_FLAG_EXTRA_TRIGGER creatures
+    else if (index == UNIT_FIELD_DISPLAY_ID)
+    {
+        uint32 displayId = m_uint32Values[UNIT_FIELD_DISPLAY_ID];
+        if (creature)
+        {
+            CreatureTemplate const* cinfo = creature->GetCreatureTemplate();
+
+            // this also applies for transform auras
+            if (SpellInfo const* transform = sSpellMgr->GetSpellInfo(getTransForm()))
+                for (uint8 i = 0; i < transform->EffectCount; ++i)
+                    if (transform->Effects[i].IsAura(SPELL_AURA_TRANSFORM))
+                        if (CreatureTemplate const* transformInfo = sObjectMgr->GetCreatureTemplate(transform->Effects[i].MiscValue))
+                        {
+                            cinfo = transformInfo;
+                            break;
+                        }
+
+            if (cinfo->flags_extra & CREATURE_FLAG_EXTRA_TRIGGER)
+            {
+                if (target->isGameMaster())
                 {
-                    FactionTemplateEntry const* ft1 = getFactionTemplateEntry();
-                    FactionTemplateEntry const* ft2 = target->getFactionTemplateEntry();
-                    if (ft1 && ft2 && !ft1->IsFriendlyTo(*ft2))
-                    {
-                        if (index == UNIT_FIELD_SHAPESHIFT_FORM)
-                            // Allow targetting opposite faction in party when enabled in config
-                            fieldBuffer << (m_uint32Values[UNIT_FIELD_SHAPESHIFT_FORM] & ((UNIT_BYTE2_FLAG_SANCTUARY /*| UNIT_BYTE2_FLAG_AURAS | UNIT_BYTE2_FLAG_UNK5*/) << 8)); // this flag is at uint8 offset 1 !!
-                        else
-                            // pretend that all other HOSTILE players have own faction, to allow follow, heal, rezz (trade wont work)
-                            fieldBuffer << uint32(target->getFaction());
-                    }
+                    if (cinfo->Modelid1)
+                        displayId = cinfo->Modelid1; // Modelid1 is a visible model for gms
                     else
-                        fieldBuffer << l_Value;
+                        displayId = 17519; // world visible trigger's model
                 }
                 else
-                    fieldBuffer << l_Value;
+                {
+                    if (cinfo->Modelid2)
+                        displayId = cinfo->Modelid2; // Modelid2 is an invisible model for players
+                    else
+                        displayId = 11686; // world invisible trigger's model
+                }
             }
-            else
+        }
+
+        return displayId;
+    }
+    // hide lootable animation for unallowed players
+    else if (index == OBJECT_FIELD_DYNAMIC_FLAGS)
+    {
+        uint32 dynamicFlags = m_uint32Values[OBJECT_FIELD_DYNAMIC_FLAGS] & ~(UNIT_DYNFLAG_TAPPED | UNIT_DYNFLAG_TAPPED_BY_PLAYER);
+
+        if (creature)
+        {
+            if (creature->hasLootRecipient())
             {
-                // send in current format (float as float, uint32 as uint32)
-                fieldBuffer << m_uint32Values[index];
+                dynamicFlags |= UNIT_DYNFLAG_TAPPED;
+                if (creature->isTappedBy(target))
+                    dynamicFlags |= UNIT_DYNFLAG_TAPPED_BY_PLAYER;
             }
+
+            if (!target->isAllowedToLoot(creature))
+                dynamicFlags &= ~UNIT_DYNFLAG_LOOTABLE;
         }
+
+        // unit UNIT_DYNFLAG_TRACK_UNIT should only be sent to caster of SPELL_AURA_MOD_STALKED auras
+        if (dynamicFlags & UNIT_DYNFLAG_TRACK_UNIT)
+            if (!HasAuraTypeWithCaster(SPELL_AURA_MOD_STALKED, target->GetGUID()))
+                dynamicFlags &= ~UNIT_DYNFLAG_TRACK_UNIT;
+
+        return dynamicFlags;
+    }
+    // FG: pretend that OTHER players in own group are friendly ("blue")
+    else if (index == UNIT_FIELD_SHAPESHIFT_FORM || index == UNIT_FIELD_FACTION_TEMPLATE)
+    {
+        uint32 l_Value = m_uint32Values[index];
+        if (index == UNIT_FIELD_FACTION_TEMPLATE && creature && creature->IsAIEnabled)
+            creature->AI()->OnSendFactionTemplate(l_Value, target);
+
+        if (IsControlledByPlayer() && target != this && sWorld->getBoolConfig(CONFIG_ALLOW_TWO_SIDE_INTERACTION_GROUP) && IsInRaidWith(target))
+        {
+            FactionTemplateEntry const* ft1 = getFactionTemplateEntry();
+            FactionTemplateEntry const* ft2 = target->getFactionTemplateEntry();
+            if (ft1 && ft2 && !ft1->IsFriendlyTo(*ft2))
+            {
+                if (index == UNIT_FIELD_SHAPESHIFT_FORM)
+                    // Allow targetting opposite faction in party when enabled in config
+                    return (m_uint32Values[UNIT_FIELD_SHAPESHIFT_FORM] & ((UNIT_BYTE2_FLAG_SANCTUARY /*| UNIT_BYTE2_FLAG_AURAS | UNIT_BYTE2_FLAG_UNK5*/) << 8)); // this flag is at uint8 offset 1 !!
+                else
+                    // pretend that all other HOSTILE players have own faction, to allow follow, heal, rezz (trade wont work)
+                    return uint32(target->getFaction());
+            }
+        }
+
+        return l_Value;
     }
 
-    *data << uint8(updateMask.GetBlockCount());
-    updateMask.AppendToPacket(data);
-    data->append(fieldBuffer);
+    return m_uint32Values[index];
 }
 
 float Unit::CalculateDamageDealtFactor(Unit* p_Unit, Creature* p_Creature)
@@ -1508,7 +1508,7 @@ class Unit : public WorldObject
         typedef std::multimap<uint32,  Aura*> AuraMap;
         typedef std::multimap<uint32,  AuraApplication*> AuraApplicationMap;
         typedef std::multimap<uint32,  AuraApplication*> AuraStateAurasMap;
-        typedef std::list<AuraEffect*> AuraEffectList;
+        typedef std::vector<AuraEffect*> AuraEffectList;
         typedef std::list<Aura*> AuraList;
         typedef std::list<AuraApplication *> AuraApplicationList;
         typedef std::map<uint32, StackOnDuration> AuraStackOnDurationMap;
@@ -2202,6 +2202,9 @@ class Unit : public WorldObject
         uint32 GetDiseasesByCaster(uint64 casterGUID, bool remove = false);
         uint32 GetDoTsByCaster(uint64 casterGUID) const;
 
+        /// Must be called when the amount of a registered aura effect changes, apply / remove are handled by _RegisterAuraEffect
+        void InvalidateAuraModifierCache(AuraType p_AuraType);
+
         int32 GetTotalAuraModifier(AuraType auratype, AuraEffect const* excludeAura = nullptr, AuraEffect* includeAura = nullptr) const;
         float GetTotalAuraMultiplier(AuraType auratype) const;
         int32 GetMaxPositiveAuraModifier(AuraType auratype);
@@ -2790,6 +2793,10 @@ class Unit : public WorldObject
         explicit Unit (bool isWorldObject);
 
         void BuildValuesUpdate(uint8 updatetype, ByteBuffer* data, Player* target) const;
+        bool CanShareValuesUpdate() const override { return true; }
+        void BuildValuesUpdateForVisibility(uint8 p_UpdateType, ByteBuffer* p_Data, uint32 p_VisibleFlag, uint32 const* p_Flags, Player* p_Target, ValuesUpdateCache::PatchList* p_Patches) const override;
+        uint32 GetViewerDependentFieldValue(uint16 index, Player* target) const override;
+        static bool IsViewerDependentField(uint16 p_Index);
 
         UnitAI* i_AI, *i_disabledAI;
 
@@ -2831,6 +2838,29 @@ class Unit : public WorldObject
         uint32 m_removedAurasCount;
         AuraStackOnDurationMap m_StackOnDurationMap;
         AuraEffectList m_modAuras[TOTAL_AURAS];
+
+        /// Aggregated amounts of the registered effects of one aura type, optionally filtered by misc value or misc mask
+        struct AuraModifierTotals
+        {
+            int32 Total;                                    ///< Same effect stack rules applied, like GetTotalAuraModifier
+            float Multiplier;
+            int32 MaxPositive;
+            int32 MaxNegative;
+        };
+
+        enum AuraModifierFilter
+        {
+            AURA_MODIFIER_FILTER_NONE       = 0,
+            AURA_MODIFIER_FILTER_MISC_VALUE = 1,
+            AURA_MODIFIER_FILTER_MISC_MASK  = 2
+        };
+
+        /// Totals are computed on first read and dropped on aura effect apply, remove or amount change
+        typedef std::unordered_map<uint64, AuraModifierTotals> AuraModifierTotalsMap;
+        mutable std::unordered_map<uint32, AuraModifierTotalsMap> m_auraModifierCache;
+
+        AuraModifierTotals GetAuraModifierTotals(AuraType p_AuraType, AuraModifierFilter p_Filter = AURA_MODIFIER_FILTER_NONE, uint32 p_FilterValue = 0) const;
+        void ComputeAuraModifierTotals(AuraType p_AuraType, AuraModifierFilter p_Filter, uint32 p_FilterValue, AuraModifierTotals& p_Totals) const;
         AuraList m_scAuras;                        // casted singlecast auras
         AuraApplicationList m_interruptableAuras;             // auras which have interrupt mask applied on unit
         AuraStateAurasMap m_auraStateAuras;        // Used for improve performance of aura state checks on aura apply/remove
@@ -35,6 +35,7 @@ uint32 ObjectAccessor::k_CreaturesCacheMaxGuid;
 Creature** ObjectAccessor::m_CreaturesCache;
 
 ObjectAccessor::ObjectAccessor()
+    : m_ValuesUpdateCacheHits(0), m_ValuesUpdateCacheMisses(0)
 {
     k_PlayerCacheMaxGuid    = ConfigMgr::GetIntDefault("PlayersCache.Size",    1000000);
     k_CreaturesCacheMaxGuid = ConfigMgr::GetIntDefault("CreaturesCache.Size", 30000000);
@@ -207,21 +208,17 @@ Unit* ObjectAccessor::FindUnit(uint64 guid)
 
 Player* ObjectAccessor::FindPlayerByName(const char* name)
 {
-    TRINITY_READ_GUARD(HashMapHolder<Player>::LockType, *HashMapHolder<Player>::GetLock());
     std::string nameStr = name;
     std::transform(nameStr.begin(), nameStr.end(), nameStr.begin(), ::tolower);
-    HashMapHolder<Player>::MapType const& m = GetPlayers();
-    for (HashMapHolder<Player>::MapType::const_iterator iter = m.begin(); iter != m.end(); ++iter)
+
+    return HashMapHolder<Player>::FindIf([&nameStr](Player* p_Player) -> bool
     {
-        if (!iter->second->IsInWorld())
-            continue;
-        std::string currentName = iter->second->GetName();
+        if (!p_Player->IsInWorld())
+            return false;
+        std::string currentName = p_Player->GetName();
         std::transform(currentName.begin(), currentName.end(), currentName.begin(), ::tolower);
-        if (nameStr.compare(currentName) == 0)
-            return iter->second;
-    }
-
-    return NULL;
+        return nameStr.compare(currentName) == 0;
+    });
 }
 
 #ifndef CROSS
@@ -235,37 +232,31 @@ Player* ObjectAccessor::FindPlayerByNameInOrOutOfWorld(const char* name)
 Player* ObjectAccessor::FindPlayerByNameAndRealmId(std::string const& name, uint32 realmId)
 #endif /* CROSS */
 {
-    TRINITY_READ_GUARD(HashMapHolder<Player>::LockType, *HashMapHolder<Player>::GetLock());
-#ifdef CROSS
-    
-#endif /* CROSS */
     std::string nameStr = name;
     std::transform(nameStr.begin(), nameStr.end(), nameStr.begin(), ::tolower);
-#ifdef CROSS
-     
+
+#ifndef CROSS
+    return HashMapHolder<Player>::FindIf([&nameStr](Player* p_Player) -> bool
+#else /* CROSS */
+    return HashMapHolder<Player>::FindIf([&nameStr, realmId](Player* p_Player) -> bool
 #endif /* CROSS */
-    HashMapHolder<Player>::MapType const& m = GetPlayers();
-    for (HashMapHolder<Player>::MapType::const_iterator iter = m.begin(); iter != m.end(); ++iter)
     {
 #ifdef CROSS
-        if (!iter->second->IsInWorld())
-            continue;
+        if (!p_Player->IsInWorld())
+            return false;
 
-        if (!iter->second->GetSession())
-            continue;
+        if (!p_Player->GetSession())
+            return false;
 
 #endif /* CROSS */
-        std::string currentName = iter->second->GetName();
+        std::string currentName = p_Player->GetName();
         std::transform(currentName.begin(), currentName.end(), currentName.begin(), ::tolower);
 #ifndef CROSS
-        if (nameStr.compare(currentName) == 0)
+        return nameStr.compare(currentName) == 0;
 #else /* CROSS */
-        if (nameStr.compare(currentName) == 0 && iter->second->GetSession()->GetInterRealmNumber() == realmId)
+        return nameStr.compare(currentName) == 0 && p_Player->GetSession()->GetInterRealmNumber() == realmId;
 #endif /* CROSS */
-            return iter->second;
-    }
-
-    return NULL;
+    });
 }
 
 #ifdef CROSS
@@ -277,7 +268,6 @@ GameObject* ObjectAccessor::FindGameObject(uint64 p_Guid)
 #endif /* CROSS */
 void ObjectAccessor::SaveAllPlayers()
 {
-    TRINITY_READ_GUARD(HashMapHolder<Player>::LockType, *HashMapHolder<Player>::GetLock());
     HashMapHolder<Player>::MapType const& m = GetPlayers();
     for (HashMapHolder<Player>::MapType::const_iterator itr = m.begin(); itr != m.end(); ++itr)
         itr->second->SaveToDB();
@@ -486,8 +476,185 @@ void ObjectAccessor::UnloadAll()
 
 /// Define the static members of HashMapHolder
 
-template <class T> std::unordered_map< uint64, T* > HashMapHolder<T>::m_objectMap;
-template <class T> typename HashMapHolder<T>::LockType HashMapHolder<T>::i_lock;
+template <class T> typename HashMapHolder<T>::Shard HashMapHolder<T>::s_Shards[HashMapHolder<T>::k_ShardCount];
+
+template <class T> HashMapHolder<T>::Table::Table(uint32 p_Capacity) : Mask(p_Capacity - 1), Slots(new Slot[p_Capacity])
+{
+    for (uint32 l_I = 0; l_I < p_Capacity; ++l_I)
+    {
+        Slots[l_I].Key.store(k_EmptyKey, std::memory_order_relaxed);
+        Slots[l_I].Value.store(NULL, std::memory_order_relaxed);
+    }
+}
+
+template <class T> HashMapHolder<T>::Shard::~Shard()
+{
+    delete Current.load();
+
+    for (auto const& l_Retired : Retired)
+        delete l_Retired.second;
+}
+
+template <class T> void HashMapHolder<T>::Insert(T* o)
+{
+    uint64 l_Guid = o->GetGUID();
+    ASSERT(l_Guid != k_EmptyKey && l_Guid != k_RemovedKey);
+
+    Shard& l_Shard = GetShard(l_Guid);
+    std::lock_guard<std::mutex> l_Lock(l_Shard.WriteLock);
+
+    /// Keep at least half of the slots empty, probe sequences stay short
+    Table* l_Table = l_Shard.Current.load(std::memory_order_relaxed);
+    if (!l_Table || (l_Shard.UsedSlots + 1) * 2 > l_Table->Mask + 1)
+    {
+        Grow(l_Shard);
+        l_Table = l_Shard.Current.load(std::memory_order_relaxed);
+    }
+
+    Slot* l_FreeSlot = NULL;
+
+    for (uint32 l_Index = uint32(Hash(l_Guid) >> 24) & l_Table->Mask;; l_Index = (l_Index + 1) & l_Table->Mask)
+    {
+        Slot& l_Slot = l_Table->Slots[l_Index];
+        uint64 l_Key = l_Slot.Key.load(std::memory_order_relaxed);
+
+        if (l_Key == l_Guid)
+        {
+            l_Slot.Value.store(o, std::memory_order_release);
+            return;
+        }
+
+        if (l_Key == k_RemovedKey && !l_FreeSlot)
+            l_FreeSlot = &l_Slot;
+
+        if (l_Key == k_EmptyKey)
+        {
+            if (!l_FreeSlot)
+            {
+                l_FreeSlot = &l_Slot;
+                ++l_Shard.UsedSlots;
+            }
+
+            break;
+        }
+    }
+
+    /// Value first, a lookup matching the key always reads this object
+    l_FreeSlot->Value.store(o, std::memory_order_release);
+    l_FreeSlot->Key.store(l_Guid, std::memory_order_release);
+    ++l_Shard.Count;
+}
+
+template <class T> void HashMapHolder<T>::Remove(T* o)
+{
+    uint64 l_Guid = o->GetGUID();
+    if (l_Guid == k_EmptyKey || l_Guid == k_RemovedKey)
+        return;
+
+    Shard& l_Shard = GetShard(l_Guid);
+    std::lock_guard<std::mutex> l_Lock(l_Shard.WriteLock);
+
+    Table* l_Table = l_Shard.Current.load(std::memory_order_relaxed);
+    if (!l_Table)
+        return;
+
+    for (uint32 l_Probe = 0, l_Index = uint32(Hash(l_Guid) >> 24) & l_Table->Mask; l_Probe <= l_Table->Mask; ++l_Probe, l_Index = (l_Index + 1) & l_Table->Mask)
+    {
+        Slot& l_Slot = l_Table->Slots[l_Index];
+        uint64 l_Key = l_Slot.Key.load(std::memory_order_relaxed);
+
+        if (l_Key == k_EmptyKey)
+            return;
+
+        if (l_Key != l_Guid)
+            continue;
+
+        l_Slot.Value.store(NULL, std::memory_order_release);
+        l_Slot.Key.store(k_RemovedKey, std::memory_order_release);
+        --l_Shard.Count;
+
+        /// Removed keys right before an empty slot end no probe sequence, they can be emptied again
+        if (l_Table->Slots[(l_Index + 1) & l_Table->Mask].Key.load(std::memory_order_relaxed) == k_EmptyKey)
+        {
+            while (l_Table->Slots[l_Index].Key.load(std::memory_order_relaxed) == k_RemovedKey)
+            {
+                l_Table->Slots[l_Index].Key.store(k_EmptyKey, std::memory_order_release);
+                --l_Shard.UsedSlots;
+                l_Index = (l_Index - 1) & l_Table->Mask;
+            }
+        }
+
+        return;
+    }
+}
+
+template <class T> void HashMapHolder<T>::Grow(Shard& p_Shard)
+{
+    /// Replaced tables may still be read by lookups started before, they are freed once no lookup can last that long
+    for (auto l_Itr = p_Shard.Retired.begin(); l_Itr != p_Shard.Retired.end();)
+    {
+        if (GetMSTimeDiffToNow(l_Itr->first) > 60 * IN_MILLISECONDS)
+        {
+            delete l_Itr->second;
+            l_Itr = p_Shard.Retired.erase(l_Itr);
+        }
+        else
+            ++l_Itr;
+    }
+
+    uint32 l_Capacity = 64;
+    while (l_Capacity < p_Shard.Count * 4)
+        l_Capacity *= 2;
+
+    Table* l_NewTable = new Table(l_Capacity);
+    Table* l_OldTable = p_Shard.Current.load(std::memory_order_relaxed);
+
+    if (l_OldTable)
+    {
+        for (uint32 l_I = 0; l_I <= l_OldTable->Mask; ++l_I)
+        {
+            uint64 l_Key = l_OldTable->Slots[l_I].Key.load(std::memory_order_relaxed);
+            if (l_Key == k_EmptyKey || l_Key == k_RemovedKey)
+                continue;
+
+            uint32 l_Index = uint32(Hash(l_Key) >> 24) & l_NewTable->Mask;
+            while (l_NewTable->Slots[l_Index].Key.load(std::memory_order_relaxed) != k_EmptyKey)
+                l_Index = (l_Index + 1) & l_NewTable->Mask;
+
+            l_NewTable->Slots[l_Index].Value.store(l_OldTable->Slots[l_I].Value.load(std::memory_order_relaxed), std::memory_order_relaxed);
+            l_NewTable->Slots[l_Index].Key.store(l_Key, std::memory_order_relaxed);
+        }
+
+        p_Shard.Retired.push_back(std::make_pair(getMSTime(), l_OldTable));
+    }
+
+    p_Shard.UsedSlots = p_Shard.Count;
+    p_Shard.Current.store(l_NewTable, std::memory_order_release);
+}
+
+template <class T> typename HashMapHolder<T>::MapType HashMapHolder<T>::GetContainer()
+{
+    MapType l_Objects;
+
+    for (uint32 l_I = 0; l_I < k_ShardCount; ++l_I)
+    {
+        Shard& l_Shard = s_Shards[l_I];
+        std::lock_guard<std::mutex> l_Lock(l_Shard.WriteLock);
+
+        Table* l_Table = l_Shard.Current.load(std::memory_order_relaxed);
+        if (!l_Table)
+            continue;
+
+        for (uint32 l_Index = 0; l_Index <= l_Table->Mask; ++l_Index)
+        {
+            uint64 l_Key = l_Table->Slots[l_Index].Key.load(std::memory_order_relaxed);
+            if (l_Key != k_EmptyKey && l_Key != k_RemovedKey)
+                l_Objects[l_Key] = l_Table->Slots[l_Index].Value.load(std::memory_order_relaxed);
+        }
+    }
+
+    return l_Objects;
+}
 
 /// Global definitions for the hashmap storage
 
@@ -17,6 +17,9 @@
 #include "Player.h"
 #include "Transport.h"
 
+#include <atomic>
+#include <mutex>
+
 class Creature;
 class Corpse;
 class Unit;
@@ -28,44 +31,116 @@ class Map;
 class WorldRunnable;
 class Transport;
 
+/// Global registry of the objects of a type, by GUID
+/// - Find is lock-free: the objects are spread over shards, each being an open addressing table read with atomics
+/// - Insert and Remove only lock the shard of the GUID, a table replaced when growing is freed a while after
+/// - GetContainer copies the registry, the copy can be iterated while objects are added or removed
 template <class T>
 class HashMapHolder
 {
     public:
 
         typedef std::unordered_map<uint64, T*> MapType;
-        typedef ACE_RW_Thread_Mutex LockType;
 
-        static void Insert(T* o)
-        {
-            TRINITY_WRITE_GUARD(LockType, i_lock);
-            m_objectMap[o->GetGUID()] = o;
-        }
-
-        static void Remove(T* o)
-        {
-            TRINITY_WRITE_GUARD(LockType, i_lock);
-            m_objectMap.erase(o->GetGUID());
-        }
+        static void Insert(T* o);
+        static void Remove(T* o);
 
         static T* Find(uint64 guid)
         {
-            TRINITY_READ_GUARD(LockType, i_lock);
-            typename MapType::iterator itr = m_objectMap.find(guid);
-            return (itr != m_objectMap.end()) ? itr->second : NULL;
+            if (guid == k_EmptyKey || guid == k_RemovedKey)
+                return NULL;
+
+            uint64 l_Hash = Hash(guid);
+            Table const* l_Table = s_Shards[l_Hash >> (64 - k_ShardBits)].Current.load(std::memory_order_acquire);
+            if (!l_Table)
+                return NULL;
+
+            for (uint32 l_Probe = 0, l_Index = uint32(l_Hash >> 24) & l_Table->Mask; l_Probe <= l_Table->Mask; ++l_Probe, l_Index = (l_Index + 1) & l_Table->Mask)
+            {
+                Slot const& l_Slot = l_Table->Slots[l_Index];
+
+                uint64 l_Key = l_Slot.Key.load(std::memory_order_acquire);
+                if (l_Key == k_EmptyKey)
+                    return NULL;
+
+                if (l_Key != guid)
+                    continue;
+
+                /// The slot may have been freed and reused meanwhile, the object is then already removed
+                T* l_Object = l_Slot.Value.load(std::memory_order_acquire);
+                return l_Slot.Key.load(std::memory_order_acquire) == guid ? l_Object : NULL;
+            }
+
+            return NULL;
         }
 
-        static MapType& GetContainer() { return m_objectMap; }
+        static MapType GetContainer();
+
+        /// First object matching p_Predicate, lock-free like Find
+        template<class Predicate> static T* FindIf(Predicate p_Predicate)
+        {
+            for (uint32 l_I = 0; l_I < k_ShardCount; ++l_I)
+            {
+                Table const* l_Table = s_Shards[l_I].Current.load(std::memory_order_acquire);
+                if (!l_Table)
+                    continue;
+
+                for (uint32 l_Index = 0; l_Index <= l_Table->Mask; ++l_Index)
+                {
+                    uint64 l_Key = l_Table->Slots[l_Index].Key.load(std::memory_order_acquire);
+                    if (l_Key == k_EmptyKey || l_Key == k_RemovedKey)
+                        continue;
+
+                    T* l_Object = l_Table->Slots[l_Index].Value.load(std::memory_order_acquire);
+                    if (l_Object && p_Predicate(l_Object))
+                        return l_Object;
+                }
+            }
 
-        static LockType* GetLock() { return &i_lock; }
+            return NULL;
+        }
 
     private:
 
         //Non instanceable only static
         HashMapHolder() {}
 
-        static LockType i_lock;
-        static MapType  m_objectMap;
+        static const uint64 k_EmptyKey   = 0;
+        static const uint64 k_RemovedKey = UI64LIT(0xFFFFFFFFFFFFFFFF);
+        static const uint32 k_ShardBits  = 4;
+        static const uint32 k_ShardCount = 1 << k_ShardBits;
+
+        struct Slot
+        {
+            std::atomic<uint64> Key;
+            std::atomic<T*>     Value;
+        };
+
+        struct Table
+        {
+            explicit Table(uint32 p_Capacity);
+
+            uint32                  Mask;               ///< Capacity - 1, capacity is a power of 2
+            std::unique_ptr<Slot[]> Slots;
+        };
+
+        struct Shard
+        {
+            Shard() : Current(NULL), UsedSlots(0), Count(0) { }
+            ~Shard();
+
+            std::mutex                              WriteLock;
+            std::atomic<Table*>                     Current;
+            uint32                                  UsedSlots;      ///< Objects and removed keys of Current
+            uint32                                  Count;
+            std::vector<std::pair<uint32, Table*>>  Retired;        ///< Replaced tables and when, lookups may still read them
+        };
+
+        static uint64 Hash(uint64 p_Guid) { return p_Guid * UI64LIT(0x9E3779B97F4A7C15); }
+        static Shard& GetShard(uint64 p_Guid) { return s_Shards[Hash(p_Guid) >> (64 - k_ShardBits)]; }
+        static void Grow(Shard& p_Shard);
+
+        static Shard s_Shards[k_ShardCount];
 };
 
 class ObjectAccessor
@@ -214,20 +289,20 @@ class ObjectAccessor
 
         static Player* FindPlayerByNameAndRealmId(std::string const& name, uint32 realmId);
 
-        // when using this, you must use the hashmapholder's lock
-        static HashMapHolder<Player>::MapType const& GetPlayers()
+        /// Copy of the registry, see HashMapHolder::GetContainer
+        static HashMapHolder<Player>::MapType GetPlayers()
         {
             return HashMapHolder<Player>::GetContainer();
         }
 
-        // when using this, you must use the hashmapholder's lock
-        static HashMapHolder<Creature>::MapType const& GetCreatures()
+        /// Copy of the registry, see HashMapHolder::GetContainer
+        static HashMapHolder<Creature>::MapType GetCreatures()
         {
             return HashMapHolder<Creature>::GetContainer();
         }
 
-        // when using this, you must use the hashmapholder's lock
-        static HashMapHolder<GameObject>::MapType const& GetGameObjects()
+        /// Copy of the registry, see HashMapHolder::GetContainer
+        static HashMapHolder<GameObject>::MapType GetGameObjects()
         {
             return HashMapHolder<GameObject>::GetContainer();
         }
@@ -296,6 +371,16 @@ class ObjectAccessor
         void AddCorpsesToGrid(GridCoord const& gridpair, GridType& grid, Map* map);
         Corpse* ConvertCorpseForPlayer(uint64 player_guid, bool insignia = false);
 
+        /// Shared values update blocks statistics, see ValuesUpdateCache
+        void AddValuesUpdateCacheStats(uint32 p_Hits, uint32 p_Misses)
+        {
+            m_ValuesUpdateCacheHits   += p_Hits;
+            m_ValuesUpdateCacheMisses += p_Misses;
+        }
+
+        uint64 GetValuesUpdateCacheHits() const { return m_ValuesUpdateCacheHits; }
+        uint64 GetValuesUpdateCacheMisses() const { return m_ValuesUpdateCacheMisses; }
+
         //Thread unsafe
         void Update(uint32 diff);
         void RemoveOldCorpses();
@@ -312,6 +397,9 @@ class ObjectAccessor
         std::set<Object*> i_objects;
         Player2CorpsesMapType i_player2corpse;
 
+        std::atomic<uint64> m_ValuesUpdateCacheHits;
+        std::atomic<uint64> m_ValuesUpdateCacheMisses;
+
         ACE_Thread_Mutex i_objectLock;
         ACE_RW_Thread_Mutex i_corpseLock;
 
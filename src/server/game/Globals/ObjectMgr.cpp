@@ -34,6 +34,7 @@
 #include "ScriptMgr.h"
 #include "SpellScript.h"
 #include "PoolMgr.h"
+#include "QuerySnapshot.h"
 #include "DB2Structure.h"
 #include "DB2Stores.h"
 #include "Configuration/Config.h"
@@ -314,7 +315,7 @@ void ObjectMgr::LoadCreatureLocales()
 
     _creatureLocaleStore.clear();                              // need for reload case
 
-    QueryResult result = WorldDatabase.Query("SELECT entry, name_loc1, femaleName_loc1, subname_loc1, name_loc2, femaleName_loc2, subname_loc2, name_loc3, femaleName_loc3, subname_loc3, name_loc4, femaleName_loc4, subname_loc4, name_loc5, femaleName_loc5, subname_loc5, name_loc6, femaleName_loc6, subname_loc6, name_loc7, femaleName_loc7, subname_loc7, name_loc8, femaleName_loc8, subname_loc8, name_loc9, femaleName_loc9, subname_loc9, name_loc10, femaleName_loc10, subname_loc10 FROM locales_creature");
+    QueryResult result = QuerySnapshot::Query("SELECT entry, name_loc1, femaleName_loc1, subname_loc1, name_loc2, femaleName_loc2, subname_loc2, name_loc3, femaleName_loc3, subname_loc3, name_loc4, femaleName_loc4, subname_loc4, name_loc5, femaleName_loc5, subname_loc5, name_loc6, femaleName_loc6, subname_loc6, name_loc7, femaleName_loc7, subname_loc7, name_loc8, femaleName_loc8, subname_loc8, name_loc9, femaleName_loc9, subname_loc9, name_loc10, femaleName_loc10, subname_loc10 FROM locales_creature", { "locales_creature" });
 
     if (!result)
         return;
@@ -410,7 +411,7 @@ void ObjectMgr::LoadCreatureTemplates()
     uint32 oldMSTime = getMSTime();
 
     //                                                 0           1          2           3          4       5
-    QueryResult result = WorldDatabase.Query("SELECT entry, KillCredit1, KillCredit2, modelid1, modelid2, modelid3, "
+    QueryResult result = QuerySnapshot::Query("SELECT entry, KillCredit1, KillCredit2, modelid1, modelid2, modelid3, "
     //                                           6        7      8           9       10           11            12       13      14     15       16       17         18        19        20
                                              "modelid4, name, femaleName, subname, IconName, gossip_menu_id, minlevel, maxlevel, exp, exp_req, faction, npcflag, npcflag2, speed_walk, speed_run, "
     //                                             21       22   23      24            25           26               27               28          29             30
@@ -425,7 +426,7 @@ void ObjectMgr::LoadCreatureTemplates()
                                              "InhabitType, HoverHeight, Health_mod, Mana_mod, Mana_mod_extra, Armor_mod, RacialLeader, questItem1, questItem2, questItem3, questItem4, questItem5, "
     //                                            78           79         80          81               82               83              84            85
                                              "questItem6, movementId, VignetteID, TrackingQuestID,  RegenHealth, mechanic_immune_mask, flags_extra, ScriptName "
-                                             "FROM creature_template;");
+                                             "FROM creature_template;", { "creature_template" });
 
     if (!result)
     {
@@ -1618,7 +1619,7 @@ void ObjectMgr::LoadCreatures()
         l_Query += l_TempQueryEnding;
     }
 
-    QueryResult result = WorldDatabase.Query(l_Query.c_str());
+    QueryResult result = QuerySnapshot::Query(l_Query, { "creature", "game_event_creature", "pool_creature" });
 
     if (!result)
     {
@@ -1776,8 +1777,7 @@ void ObjectMgr::AddCreatureToGrid(uint32 guid, CreatureData const* data)
         if (mask & 1)
         {
             CellCoord cellCoord = JadeCore::ComputeCellCoord(data->posX, data->posY);
-            CellObjectGuids& cell_guids = _mapObjectGuidsStore[MAKE_PAIR32(data->mapid, i)][cellCoord.GetId()];
-            cell_guids.creatures.insert(guid);
+            _spawnIndex.Add(data->mapid, i, cellCoord.GetId(), SpawnIndex::SPAWN_CREATURE, guid);
         }
     }
 }
@@ -1790,8 +1790,7 @@ void ObjectMgr::RemoveCreatureFromGrid(uint32 guid, CreatureData const* data)
         if (mask & 1)
         {
             CellCoord cellCoord = JadeCore::ComputeCellCoord(data->posX, data->posY);
-            CellObjectGuids& cell_guids = _mapObjectGuidsStore[MAKE_PAIR32(data->mapid, i)][cellCoord.GetId()];
-            cell_guids.creatures.erase(guid);
+            _spawnIndex.Remove(data->mapid, i, cellCoord.GetId(), SpawnIndex::SPAWN_CREATURE, guid);
         }
     }
 }
@@ -1975,7 +1974,7 @@ void ObjectMgr::LoadGameobjects()
         l_Query += l_TempQueryEnding;
     }
 
-    QueryResult result = WorldDatabase.Query(l_Query.c_str());
+    QueryResult result = QuerySnapshot::Query(l_Query, { "gameobject", "game_event_gameobject", "pool_gameobject" });
 
     if (!result)
     {
@@ -2126,8 +2125,7 @@ void ObjectMgr::AddGameobjectToGrid(uint32 guid, GameObjectData const* data)
         if (mask & 1)
         {
             CellCoord cellCoord = JadeCore::ComputeCellCoord(data->posX, data->posY);
-            CellObjectGuids& cell_guids = _mapObjectGuidsStore[MAKE_PAIR32(data->mapid, i)][cellCoord.GetId()];
-            cell_guids.gameobjects.insert(guid);
+            _spawnIndex.Add(data->mapid, i, cellCoord.GetId(), SpawnIndex::SPAWN_GAMEOBJECT, guid);
         }
     }
 }
@@ -2140,8 +2138,7 @@ void ObjectMgr::RemoveGameobjectFromGrid(uint32 guid, GameObjectData const* data
         if (mask & 1)
         {
             CellCoord cellCoord = JadeCore::ComputeCellCoord(data->posX, data->posY);
-            CellObjectGuids& cell_guids = _mapObjectGuidsStore[MAKE_PAIR32(data->mapid, i)][cellCoord.GetId()];
-            cell_guids.gameobjects.erase(guid);
+            _spawnIndex.Remove(data->mapid, i, cellCoord.GetId(), SpawnIndex::SPAWN_GAMEOBJECT, guid);
         }
     }
 }
@@ -7116,14 +7113,14 @@ void ObjectMgr::LoadGameObjectTemplate()
     uint32 oldMSTime = getMSTime();
 
     //                                                 0      1      2        3       4             5          6      7       8     9        10         11          12
-    QueryResult result = WorldDatabase.Query("SELECT entry, type, displayId, name, IconName, castBarCaption, unk1, faction, flags, size, questItem1, questItem2, questItem3, "
+    QueryResult result = QuerySnapshot::Query("SELECT entry, type, displayId, name, IconName, castBarCaption, unk1, faction, flags, size, questItem1, questItem2, questItem3, "
     //                                            13          14          15       16     17     18     19     20     21     22     23     24     25      26      27      28
                                              "questItem4, questItem5, questItem6, data0, data1, data2, data3, data4, data5, data6, data7, data8, data9, data10, data11, data12, "
     //                                          29      30      31      32      33      34      35      36      37      38      39      40      41      42      43      44
                                              "data13, data14, data15, data16, data17, data18, data19, data20, data21, data22, data23, data24, data25, data26, data27, data28, "
     //                                          45      46      47       48       49        50            51        52
                                              "data29, data30, data31,  data32, unkInt32, WorldEffectID, AIName, ScriptName "
-                                             "FROM gameobject_template");
+                                             "FROM gameobject_template", { "gameobject_template" });
 
     if (!result)
     {
@@ -8165,15 +8162,32 @@ void ObjectMgr::DeleteGOData(uint32 guid)
 void ObjectMgr::AddCorpseCellData(uint32 mapid, uint32 cellid, uint32 player_guid, uint32 instance)
 {
     // corpses are always added to spawn mode 0 and they are spawned by their instance id
-    CellObjectGuids& cell_guids = _mapObjectGuidsStore[MAKE_PAIR32(mapid, 0)][cellid];
-    cell_guids.corpses[player_guid] = instance;
+    std::lock_guard<std::mutex> lock(_cellCorpsesLock);
+    _cellCorpsesStore[(uint64(mapid) << 32) | cellid][player_guid] = instance;
 }
 
 void ObjectMgr::DeleteCorpseCellData(uint32 mapid, uint32 cellid, uint32 player_guid)
 {
-    // corpses are always added to spawn mode 0 and they are spawned by their instance id
-    CellObjectGuids& cell_guids = _mapObjectGuidsStore[MAKE_PAIR32(mapid, 0)][cellid];
-    cell_guids.corpses.erase(player_guid);
+    std::lock_guard<std::mutex> lock(_cellCorpsesLock);
+
+    CellCorpsesMap::iterator itr = _cellCorpsesStore.find((uint64(mapid) << 32) | cellid);
+    if (itr == _cellCorpsesStore.end())
+        return;
+
+    itr->second.erase(player_guid);
+    if (itr->second.empty())
+        _cellCorpsesStore.erase(itr);
+}
+
+CellCorpseSet ObjectMgr::GetCellCorpses(uint32 mapid, uint32 cellid) const
+{
+    std::lock_guard<std::mutex> lock(_cellCorpsesLock);
+
+    CellCorpsesMap::const_iterator itr = _cellCorpsesStore.find((uint64(mapid) << 32) | cellid);
+    if (itr == _cellCorpsesStore.end())
+        return CellCorpseSet();
+
+    return itr->second;
 }
 
 void ObjectMgr::LoadQuestRelationsHelper(QuestRelations& map, std::string table, bool starter, bool go)
@@ -31,6 +31,7 @@
 #include "ConditionMgr.h"
 #include <functional>
 #include "PhaseMgr.h"
+#include "SpawnIndex.h"
 #include <ace/Thread_Mutex.h>
 #include <unordered_set>
 
@@ -389,16 +390,8 @@ struct AreaTriggerStruct
     float  target_Orientation;
 };
 
-typedef std::set<uint32> CellGuidSet;
 typedef std::map<uint32/*player guid*/, uint32/*instance*/> CellCorpseSet;
-struct CellObjectGuids
-{
-    CellGuidSet creatures;
-    CellGuidSet gameobjects;
-    CellCorpseSet corpses;
-};
-typedef ACE_Based::LockedMap<uint32/*cell_id*/, CellObjectGuids> CellObjectGuidsMap;
-typedef ACE_Based::LockedMap<uint32/*(mapid, spawnMode) pair*/, CellObjectGuidsMap> MapObjectGuids;
+typedef std::unordered_map<uint64/*(mapid, cell_id) pair*/, CellCorpseSet> CellCorpsesMap;
 
 // Trinity string ranges
 #define MIN_TRINITY_STRING_ID           1                    // 'trinity_string'
@@ -1411,16 +1404,25 @@ class ObjectMgr
             return NULL;
         }
 
-        CellObjectGuids const& GetCellObjectGuids(uint16 mapid, uint8 spawnMode, uint32 cell_id)
+        void GetCellObjectGuids(uint16 mapid, uint8 spawnMode, uint32 cell_id, CellObjectGuids& guids) const
         {
-            return _mapObjectGuidsStore[MAKE_PAIR32(mapid, spawnMode)][cell_id];
+            _spawnIndex.GetCellGuids(mapid, spawnMode, cell_id, guids);
         }
 
-        CellObjectGuidsMap const& GetMapObjectGuids(uint16 mapid, uint8 spawnMode)
+        void GetMapObjectGuids(uint16 mapid, uint8 spawnMode, CellObjectGuids& guids) const
         {
-            return _mapObjectGuidsStore[MAKE_PAIR32(mapid, spawnMode)];
+            _spawnIndex.GetMapGuids(mapid, spawnMode, guids);
         }
 
+        /// Changed each time a creature or gameobject spawn is added to or removed from a cell
+        uint32 GetCellObjectGuidsGeneration() const { return _spawnIndex.GetGeneration(); }
+
+        /// Move the spawns loaded so far into the flat arrays of the spawn index, called once the world is loaded
+        void FreezeSpawnIndex() { _spawnIndex.Freeze(); }
+
+        /// Corpses of the cell, spawned in spawn mode 0 by their instance id
+        CellCorpseSet GetCellCorpses(uint32 mapid, uint32 cellid) const;
+
        /**
         * Gets temp summon data for all creatures of specified group.
         *
@@ -1952,7 +1954,9 @@ class ObjectMgr
         HalfNameContainer _petHalfName0;
         HalfNameContainer _petHalfName1;
 
-        MapObjectGuids _mapObjectGuidsStore;
+        SpawnIndex _spawnIndex;
+        CellCorpsesMap _cellCorpsesStore;
+        mutable std::mutex _cellCorpsesLock;
         CreatureDataContainer _creatureDataStore;
 
         CreatureTemplate** m_CreatureTemplateStore;
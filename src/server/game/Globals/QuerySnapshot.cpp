@@ -0,0 +1,206 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+//  MILLENIUM-STUDIO
+//  Copyright 2016 Millenium-studio SARL
+//  All Rights Reserved.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+#include "QuerySnapshot.h"
+#include "MappedFile.h"
+#include "Timer.h"
+
+#include <cstdio>
+#include <fstream>
+
+#define QUERY_SNAPSHOT_MAGIC    0x50414E53                  ///< "SNAP"
+#define QUERY_SNAPSHOT_VERSION  1
+
+/// Followed by the query, the field types (uint32 each) and the rows
+struct QuerySnapshotHeader
+{
+    uint32 Magic;
+    uint32 Version;
+    uint64 Checksum;
+    uint64 RowCount;
+    uint64 RowsSize;
+    uint32 FieldCount;
+    uint32 SqlLength;
+};
+
+std::string         QuerySnapshot::s_Directory;
+std::atomic<uint32> QuerySnapshot::s_HitCount(0);
+std::atomic<uint32> QuerySnapshot::s_MissCount(0);
+
+void QuerySnapshot::SetDirectory(std::string const& p_Directory)
+{
+    s_Directory = p_Directory;
+
+    if (!s_Directory.empty() && s_Directory[s_Directory.size() - 1] != '/' && s_Directory[s_Directory.size() - 1] != '\\')
+        s_Directory += '/';
+}
+
+QueryResult QuerySnapshot::Query(std::string const& p_Sql, std::initializer_list<char const*> p_Tables)
+{
+    uint64 l_Checksum = 0;
+
+    if (s_Directory.empty() || !GetTablesChecksum(p_Tables, l_Checksum))
+        return WorldDatabase.Query(p_Sql.c_str());
+
+    std::ostringstream l_Path;
+    l_Path << s_Directory << std::hex << std::hash<std::string>()(p_Sql) << ".snapshot";
+
+    uint32 l_StartTime = getMSTime();
+
+    QueryResult l_Result;
+    if (Load(l_Path.str(), p_Sql, l_Checksum, l_Result))
+    {
+        ++s_HitCount;
+        sLog->outInfo(LOG_FILTER_SERVER_LOADING, ">> Query snapshot %s used (" UI64FMTD " rows) in %u ms", l_Path.str().c_str(), l_Result ? l_Result->GetRowCount() : 0, GetMSTimeDiffToNow(l_StartTime));
+        return l_Result;
+    }
+
+    ++s_MissCount;
+    return Build(l_Path.str(), p_Sql, l_Checksum);
+}
+
+bool QuerySnapshot::GetTablesChecksum(std::initializer_list<char const*> p_Tables, uint64& p_Checksum)
+{
+    std::string l_Sql = "CHECKSUM TABLE ";
+
+    for (char const* l_Table : p_Tables)
+    {
+        if (l_Sql.size() > 15)
+            l_Sql += ", ";
+
+        l_Sql += l_Table;
+    }
+
+    QueryResult l_Result = WorldDatabase.Query(l_Sql.c_str());
+    if (!l_Result)
+        return false;
+
+    /// The checksum of a missing table is NULL, the snapshot is then never valid
+    p_Checksum = QUERY_SNAPSHOT_VERSION;
+
+    do
+    {
+        Field* l_Fields = l_Result->Fetch();
+
+        if (l_Fields[1].IsNull())
+            return false;
+
+        p_Checksum = (p_Checksum * 1099511628211ULL) ^ std::hash<std::string>()(l_Fields[0].GetString());
+        p_Checksum = (p_Checksum * 1099511628211ULL) ^ l_Fields[1].GetUInt64();
+    }
+    while (l_Result->NextRow());
+
+    return true;
+}
+
+bool QuerySnapshot::Load(std::string const& p_Path, std::string const& p_Sql, uint64 p_Checksum, QueryResult& p_Result)
+{
+    std::shared_ptr<MappedFile> l_File = std::make_shared<MappedFile>();
+    if (!l_File->Open(p_Path))
+        return false;
+
+    char const* l_Data = l_File->GetData();
+    size_t      l_Size = l_File->GetSize();
+
+    if (l_Size < sizeof(QuerySnapshotHeader))
+        return false;
+
+    QuerySnapshotHeader l_Header;
+    memcpy(&l_Header, l_Data, sizeof(l_Header));
+
+    if (l_Header.Magic != QUERY_SNAPSHOT_MAGIC || l_Header.Version != QUERY_SNAPSHOT_VERSION || l_Header.Checksum != p_Checksum)
+        return false;
+
+    size_t l_RowsOffset = sizeof(l_Header) + l_Header.SqlLength + l_Header.FieldCount * sizeof(uint32);
+    if (l_Size != l_RowsOffset + l_Header.RowsSize || p_Sql.compare(0, std::string::npos, l_Data + sizeof(l_Header), l_Header.SqlLength) != 0)
+        return false;
+
+    if (!l_Header.RowCount)
+    {
+        p_Result = QueryResult(NULL);
+        return true;
+    }
+
+    std::vector<enum_field_types> l_Types(l_Header.FieldCount);
+    for (uint32 l_I = 0; l_I < l_Header.FieldCount; ++l_I)
+    {
+        uint32 l_Type;
+        memcpy(&l_Type, l_Data + sizeof(l_Header) + l_Header.SqlLength + l_I * sizeof(uint32), sizeof(l_Type));
+        l_Types[l_I] = enum_field_types(l_Type);
+    }
+
+    p_Result = QueryResult(new ResultSet(l_File, l_Data + l_RowsOffset, l_Header.RowCount, l_Types));
+    p_Result->NextRow();
+    return true;
+}
+
+QueryResult QuerySnapshot::Build(std::string const& p_Path, std::string const& p_Sql, uint64 p_Checksum)
+{
+    QueryResult l_Result = WorldDatabase.Query(p_Sql.c_str());
+
+    QuerySnapshotHeader l_Header;
+    l_Header.Magic      = QUERY_SNAPSHOT_MAGIC;
+    l_Header.Version    = QUERY_SNAPSHOT_VERSION;
+    l_Header.Checksum   = p_Checksum;
+    l_Header.RowCount   = l_Result ? l_Result->GetRowCount() : 0;
+    l_Header.RowsSize   = 0;
+    l_Header.FieldCount = l_Result ? l_Result->GetFieldCount() : 0;
+    l_Header.SqlLength  = p_Sql.size();
+
+    std::shared_ptr<std::string> l_Buffer = std::make_shared<std::string>();
+    l_Buffer->append(reinterpret_cast<char const*>(&l_Header), sizeof(l_Header));
+    l_Buffer->append(p_Sql);
+
+    std::vector<enum_field_types> l_Types(l_Header.FieldCount);
+    for (uint32 l_I = 0; l_I < l_Header.FieldCount; ++l_I)
+    {
+        l_Types[l_I] = l_Result->GetFieldType(l_I);
+
+        uint32 l_Type = l_Types[l_I];
+        l_Buffer->append(reinterpret_cast<char const*>(&l_Type), sizeof(l_Type));
+    }
+
+    size_t l_RowsOffset = l_Buffer->size();
+
+    if (l_Result)
+    {
+        do
+            l_Result->AppendSnapshotRow(*l_Buffer);
+        while (l_Result->NextRow());
+    }
+
+    l_Header.RowsSize = l_Buffer->size() - l_RowsOffset;
+    memcpy(&(*l_Buffer)[0], &l_Header, sizeof(l_Header));
+
+    /// Written aside then renamed, a crash never leaves a truncated snapshot
+    std::string l_TempPath = p_Path + ".tmp";
+    bool l_Written;
+    {
+        std::ofstream l_Stream(l_TempPath.c_str(), std::ios::binary | std::ios::trunc);
+        l_Stream.write(l_Buffer->data(), l_Buffer->size());
+        l_Written = l_Stream.good();
+    }
+
+    std::remove(p_Path.c_str());
+
+    if (l_Written)
+        std::rename(l_TempPath.c_str(), p_Path.c_str());
+    else
+    {
+        sLog->outError(LOG_FILTER_SERVER_LOADING, "QuerySnapshot: can't write %s, check the Startup.SnapshotDir directory", l_TempPath.c_str());
+        std::remove(l_TempPath.c_str());
+    }
+
+    if (!l_Header.RowCount)
+        return QueryResult(NULL);
+
+    /// The MySQL rows are consumed, the loader reads the encoded copy
+    QueryResult l_SnapshotResult(new ResultSet(l_Buffer, l_Buffer->data() + l_RowsOffset, l_Header.RowCount, l_Types));
+    l_SnapshotResult->NextRow();
+    return l_SnapshotResult;
+}
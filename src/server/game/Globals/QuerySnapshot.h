@@ -0,0 +1,44 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+//  MILLENIUM-STUDIO
+//  Copyright 2016 Millenium-studio SARL
+//  All Rights Reserved.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef _QUERY_SNAPSHOT_H
+#define _QUERY_SNAPSHOT_H
+
+#include "Common.h"
+#include "DatabaseEnv.h"
+#include <initializer_list>
+
+/// On-disk snapshots of the large world database queries run by the startup loaders
+/// - A snapshot is keyed by its query and by the CHECKSUM TABLE of every table the query reads
+/// - While these tables don't change, the rows are mapped from the snapshot instead of being sent again by MySQL
+/// - Rows are kept as MySQL text, loaders read them exactly like a WorldDatabase.Query result
+class QuerySnapshot
+{
+    public:
+        /// Snapshots are disabled if the directory is empty
+        static void SetDirectory(std::string const& p_Directory);
+
+        /// Same result as WorldDatabase.Query(p_Sql)
+        /// @p_Tables : Every table read by the query, a change in one of them invalidates the snapshot
+        static QueryResult Query(std::string const& p_Sql, std::initializer_list<char const*> p_Tables);
+
+        static uint32 GetHitCount() { return s_HitCount.load(); }
+        static uint32 GetMissCount() { return s_MissCount.load(); }
+
+    private:
+        static bool GetTablesChecksum(std::initializer_list<char const*> p_Tables, uint64& p_Checksum);
+        /// Return false if there is no valid snapshot for this query and checksum
+        static bool Load(std::string const& p_Path, std::string const& p_Sql, uint64 p_Checksum, QueryResult& p_Result);
+        static QueryResult Build(std::string const& p_Path, std::string const& p_Sql, uint64 p_Checksum);
+
+        static std::string         s_Directory;
+        static std::atomic<uint32> s_HitCount;
+        static std::atomic<uint32> s_MissCount;
+};
+
+#endif
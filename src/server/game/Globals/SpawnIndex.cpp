@@ -0,0 +1,375 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+//  MILLENIUM-STUDIO
+//  Copyright 2016 Millenium-studio SARL
+//  All Rights Reserved.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+#include "SpawnIndex.h"
+#include "Errors.h"
+#include "Log.h"
+#include "Timer.h"
+
+#include <chrono>
+
+void SpawnIndex::Add(uint16 p_MapId, uint8 p_SpawnMode, uint32 p_CellId, SpawnType p_Type, uint32 p_Guid)
+{
+    uint32 l_MapKey  = MakeMapKey(p_MapId, p_SpawnMode);
+    uint64 l_CellKey = MakeCellKey(l_MapKey, p_CellId);
+
+    {
+        TRINITY_WRITE_GUARD(ACE_RW_Thread_Mutex, m_OverlayLock);
+
+        bool l_HadChanges = m_Overlay.find(l_CellKey) != m_Overlay.end();
+        OverlayCell& l_Cell = m_Overlay[l_CellKey];
+
+        std::vector<uint32>& l_Removed = l_Cell.Removed[p_Type];
+        std::vector<uint32>& l_Added   = l_Cell.Added[p_Type];
+
+        auto l_Itr = std::find(l_Removed.begin(), l_Removed.end(), p_Guid);
+        if (l_Itr != l_Removed.end())
+            l_Removed.erase(l_Itr);
+        else if (!IsFrozen(l_MapKey, p_CellId, p_Type, p_Guid) && std::find(l_Added.begin(), l_Added.end(), p_Guid) == l_Added.end())
+            l_Added.push_back(p_Guid);
+
+        PruneOverlayCell(l_CellKey, l_HadChanges);
+    }
+
+    ++m_Generation;
+}
+
+void SpawnIndex::Remove(uint16 p_MapId, uint8 p_SpawnMode, uint32 p_CellId, SpawnType p_Type, uint32 p_Guid)
+{
+    uint32 l_MapKey  = MakeMapKey(p_MapId, p_SpawnMode);
+    uint64 l_CellKey = MakeCellKey(l_MapKey, p_CellId);
+
+    {
+        TRINITY_WRITE_GUARD(ACE_RW_Thread_Mutex, m_OverlayLock);
+
+        auto l_CellItr    = m_Overlay.find(l_CellKey);
+        bool l_HadChanges = l_CellItr != m_Overlay.end();
+
+        if (l_HadChanges)
+        {
+            std::vector<uint32>& l_Added = l_CellItr->second.Added[p_Type];
+
+            auto l_Itr = std::find(l_Added.begin(), l_Added.end(), p_Guid);
+            if (l_Itr != l_Added.end())
+                l_Added.erase(l_Itr);
+        }
+
+        if (IsFrozen(l_MapKey, p_CellId, p_Type, p_Guid))
+        {
+            std::vector<uint32>& l_Removed = m_Overlay[l_CellKey].Removed[p_Type];
+
+            if (std::find(l_Removed.begin(), l_Removed.end(), p_Guid) == l_Removed.end())
+                l_Removed.push_back(p_Guid);
+        }
+
+        PruneOverlayCell(l_CellKey, l_HadChanges);
+    }
+
+    ++m_Generation;
+}
+
+void SpawnIndex::Freeze()
+{
+    uint32 l_StartTime = getMSTime();
+
+    /// Cell id, spawn type and guid of every spawn, grouped by map
+    std::map<uint32, std::vector<uint64>> l_Spawns;
+
+    for (size_t l_I = 0; l_I < m_FrozenMapKeys.size(); ++l_I)
+    {
+        FrozenMap const& l_Map = m_FrozenMaps[l_I];
+        std::vector<uint64>& l_MapSpawns = l_Spawns[m_FrozenMapKeys[l_I]];
+
+        for (size_t l_Cell = 0; l_Cell < l_Map.CellIds.size(); ++l_Cell)
+        {
+            for (uint32 l_Type = 0; l_Type < MAX_SPAWN_TYPE; ++l_Type)
+            {
+                uint32 const* l_Begin;
+                uint32 const* l_End;
+                GetFrozenGuids(&l_Map, l_Map.CellIds[l_Cell], SpawnType(l_Type), l_Begin, l_End);
+
+                OverlayCell const* l_Overlay = nullptr;
+                auto l_Itr = m_Overlay.find(MakeCellKey(m_FrozenMapKeys[l_I], l_Map.CellIds[l_Cell]));
+                if (l_Itr != m_Overlay.end())
+                    l_Overlay = &l_Itr->second;
+
+                for (uint32 const* l_Guid = l_Begin; l_Guid != l_End; ++l_Guid)
+                {
+                    if (!l_Overlay || std::find(l_Overlay->Removed[l_Type].begin(), l_Overlay->Removed[l_Type].end(), *l_Guid) == l_Overlay->Removed[l_Type].end())
+                        l_MapSpawns.push_back((uint64(l_Map.CellIds[l_Cell]) << 33) | (uint64(l_Type) << 32) | *l_Guid);
+                }
+            }
+        }
+    }
+
+    for (auto const& l_Pair : m_Overlay)
+    {
+        uint32 l_MapKey = uint32(l_Pair.first >> 32);
+        uint32 l_CellId = uint32(l_Pair.first);
+
+        for (uint32 l_Type = 0; l_Type < MAX_SPAWN_TYPE; ++l_Type)
+        {
+            for (uint32 l_Guid : l_Pair.second.Added[l_Type])
+                l_Spawns[l_MapKey].push_back((uint64(l_CellId) << 33) | (uint64(l_Type) << 32) | l_Guid);
+        }
+    }
+
+    m_FrozenMapKeys.clear();
+    m_FrozenMaps.clear();
+    m_FrozenMapKeys.reserve(l_Spawns.size());
+    m_FrozenMaps.reserve(l_Spawns.size());
+
+    uint32 l_SpawnCount = 0;
+    uint32 l_CellCount  = 0;
+    size_t l_MemorySize = 0;
+
+    for (auto& l_Pair : l_Spawns)
+    {
+        std::vector<uint64>& l_MapSpawns = l_Pair.second;
+        if (l_MapSpawns.empty())
+            continue;
+
+        /// Sorted by cell, then creatures before gameobjects, then guid
+        std::sort(l_MapSpawns.begin(), l_MapSpawns.end());
+
+        m_FrozenMapKeys.push_back(l_Pair.first);
+        m_FrozenMaps.push_back(FrozenMap());
+
+        FrozenMap& l_Map = m_FrozenMaps.back();
+        l_Map.Guids.reserve(l_MapSpawns.size());
+
+        for (uint64 l_Spawn : l_MapSpawns)
+        {
+            uint32 l_CellId = uint32(l_Spawn >> 33);
+            uint32 l_Type   = uint32(l_Spawn >> 32) & 1;
+
+            if (l_Map.CellIds.empty() || l_Map.CellIds.back() != l_CellId)
+            {
+                l_Map.CellIds.push_back(l_CellId);
+                l_Map.Offsets.push_back(l_Map.Guids.size());
+                l_Map.Offsets.push_back(l_Map.Guids.size());
+            }
+
+            /// Gameobjects start after the last creature of the cell
+            if (l_Type == SPAWN_CREATURE)
+                ++l_Map.Offsets.back();
+
+            l_Map.Guids.push_back(uint32(l_Spawn));
+        }
+
+        l_Map.Offsets.push_back(l_Map.Guids.size());
+
+        l_Map.CellIds.shrink_to_fit();
+        l_Map.Offsets.shrink_to_fit();
+
+        l_SpawnCount += l_Map.Guids.size();
+        l_CellCount  += l_Map.CellIds.size();
+        l_MemorySize += sizeof(FrozenMap) + sizeof(uint32) + (l_Map.CellIds.size() + l_Map.Offsets.size() + l_Map.Guids.size()) * sizeof(uint32);
+    }
+
+    {
+        TRINITY_WRITE_GUARD(ACE_RW_Thread_Mutex, m_OverlayLock);
+        m_Overlay.clear();
+        m_OverlayCellCount = 0;
+
+        m_FrozenMapOverlayCells.reset(new std::atomic<uint32>[m_FrozenMaps.size()]);
+        for (size_t l_I = 0; l_I < m_FrozenMaps.size(); ++l_I)
+            m_FrozenMapOverlayCells[l_I] = 0;
+    }
+
+    ++m_Generation;
+
+    /// A std::set node is about 40 bytes per guid, a cell of the nested maps about 200 bytes
+    sLog->outInfo(LOG_FILTER_SERVER_LOADING, ">> Spawn index : %u spawns in %u cells of %u maps and spawn modes, %u KB (about %u KB with std::set cells) in %u ms",
+        l_SpawnCount, l_CellCount, uint32(m_FrozenMaps.size()), uint32(l_MemorySize / 1024), uint32((uint64(l_SpawnCount) * 40 + uint64(l_CellCount) * 200) / 1024), GetMSTimeDiffToNow(l_StartTime));
+
+    /// Look up every cell once, as grid loading does
+    CellObjectGuids l_Guids;
+    auto l_LookupStart = std::chrono::steady_clock::now();
+
+    for (size_t l_I = 0; l_I < m_FrozenMapKeys.size(); ++l_I)
+    {
+        for (uint32 l_CellId : m_FrozenMaps[l_I].CellIds)
+            GetCellGuids(uint16(m_FrozenMapKeys[l_I] & 0xFFFF), uint8(m_FrozenMapKeys[l_I] >> 16), l_CellId, l_Guids);
+    }
+
+    uint64 l_LookupTime = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - l_LookupStart).count();
+    sLog->outInfo(LOG_FILTER_SERVER_LOADING, ">> Spawn index : %u cell lookups in " UI64FMTD " us", l_CellCount, l_LookupTime);
+}
+
+void SpawnIndex::GetCellGuids(uint16 p_MapId, uint8 p_SpawnMode, uint32 p_CellId, CellObjectGuids& p_Guids) const
+{
+    p_Guids.creatures.clear();
+    p_Guids.gameobjects.clear();
+
+    uint32           l_MapKey = MakeMapKey(p_MapId, p_SpawnMode);
+    FrozenMap const* l_Map    = FindFrozenMap(l_MapKey);
+
+    uint32 const* l_Begin[MAX_SPAWN_TYPE];
+    uint32 const* l_End[MAX_SPAWN_TYPE];
+
+    for (uint32 l_Type = 0; l_Type < MAX_SPAWN_TYPE; ++l_Type)
+        GetFrozenGuids(l_Map, p_CellId, SpawnType(l_Type), l_Begin[l_Type], l_End[l_Type]);
+
+    /// Changes of the other maps don't make this one take the lock
+    if (!GetOverlayCellCount(l_Map).load())
+    {
+        p_Guids.creatures.assign(l_Begin[SPAWN_CREATURE], l_End[SPAWN_CREATURE]);
+        p_Guids.gameobjects.assign(l_Begin[SPAWN_GAMEOBJECT], l_End[SPAWN_GAMEOBJECT]);
+        return;
+    }
+
+    TRINITY_READ_GUARD(ACE_RW_Thread_Mutex, m_OverlayLock);
+
+    auto l_Itr = m_Overlay.find(MakeCellKey(l_MapKey, p_CellId));
+    OverlayCell const* l_Overlay = l_Itr != m_Overlay.end() ? &l_Itr->second : nullptr;
+
+    MergeOverlay(l_Begin[SPAWN_CREATURE], l_End[SPAWN_CREATURE], l_Overlay, SPAWN_CREATURE, p_Guids.creatures);
+    MergeOverlay(l_Begin[SPAWN_GAMEOBJECT], l_End[SPAWN_GAMEOBJECT], l_Overlay, SPAWN_GAMEOBJECT, p_Guids.gameobjects);
+}
+
+void SpawnIndex::GetMapGuids(uint16 p_MapId, uint8 p_SpawnMode, CellObjectGuids& p_Guids) const
+{
+    p_Guids.creatures.clear();
+    p_Guids.gameobjects.clear();
+
+    uint32           l_MapKey = MakeMapKey(p_MapId, p_SpawnMode);
+    FrozenMap const* l_Map    = FindFrozenMap(l_MapKey);
+
+    TRINITY_READ_GUARD(ACE_RW_Thread_Mutex, m_OverlayLock);
+
+    if (l_Map)
+    {
+        for (uint32 l_CellId : l_Map->CellIds)
+        {
+            auto l_Itr = m_Overlay.find(MakeCellKey(l_MapKey, l_CellId));
+            OverlayCell const* l_Overlay = l_Itr != m_Overlay.end() ? &l_Itr->second : nullptr;
+
+            uint32 const* l_Begin;
+            uint32 const* l_End;
+
+            GetFrozenGuids(l_Map, l_CellId, SPAWN_CREATURE, l_Begin, l_End);
+            MergeOverlay(l_Begin, l_End, l_Overlay, SPAWN_CREATURE, p_Guids.creatures);
+
+            GetFrozenGuids(l_Map, l_CellId, SPAWN_GAMEOBJECT, l_Begin, l_End);
+            MergeOverlay(l_Begin, l_End, l_Overlay, SPAWN_GAMEOBJECT, p_Guids.gameobjects);
+        }
+    }
+
+    /// Cells without frozen spawns
+    for (auto const& l_Pair : m_Overlay)
+    {
+        if (uint32(l_Pair.first >> 32) != l_MapKey)
+            continue;
+
+        if (l_Map && std::binary_search(l_Map->CellIds.begin(), l_Map->CellIds.end(), uint32(l_Pair.first)))
+            continue;
+
+        p_Guids.creatures.insert(p_Guids.creatures.end(), l_Pair.second.Added[SPAWN_CREATURE].begin(), l_Pair.second.Added[SPAWN_CREATURE].end());
+        p_Guids.gameobjects.insert(p_Guids.gameobjects.end(), l_Pair.second.Added[SPAWN_GAMEOBJECT].begin(), l_Pair.second.Added[SPAWN_GAMEOBJECT].end());
+    }
+}
+
+SpawnIndex::FrozenMap const* SpawnIndex::FindFrozenMap(uint32 p_MapKey) const
+{
+    auto l_Itr = std::lower_bound(m_FrozenMapKeys.begin(), m_FrozenMapKeys.end(), p_MapKey);
+    if (l_Itr == m_FrozenMapKeys.end() || *l_Itr != p_MapKey)
+        return nullptr;
+
+    return &m_FrozenMaps[l_Itr - m_FrozenMapKeys.begin()];
+}
+
+void SpawnIndex::GetFrozenGuids(FrozenMap const* p_Map, uint32 p_CellId, SpawnType p_Type, uint32 const*& p_Begin, uint32 const*& p_End) const
+{
+    p_Begin = p_End = nullptr;
+
+    if (!p_Map)
+        return;
+
+    auto l_Itr = std::lower_bound(p_Map->CellIds.begin(), p_Map->CellIds.end(), p_CellId);
+    if (l_Itr == p_Map->CellIds.end() || *l_Itr != p_CellId)
+        return;
+
+    size_t l_Offset = (l_Itr - p_Map->CellIds.begin()) * 2 + p_Type;
+
+    p_Begin = p_Map->Guids.data() + p_Map->Offsets[l_Offset];
+    p_End   = p_Map->Guids.data() + p_Map->Offsets[l_Offset + 1];
+}
+
+bool SpawnIndex::IsFrozen(uint32 p_MapKey, uint32 p_CellId, SpawnType p_Type, uint32 p_Guid) const
+{
+    uint32 const* l_Begin;
+    uint32 const* l_End;
+    GetFrozenGuids(FindFrozenMap(p_MapKey), p_CellId, p_Type, l_Begin, l_End);
+
+    return std::binary_search(l_Begin, l_End, p_Guid);
+}
+
+std::atomic<uint32> const& SpawnIndex::GetOverlayCellCount(FrozenMap const* p_Map) const
+{
+    if (!p_Map)
+        return m_OverlayCellCount;
+
+    return m_FrozenMapOverlayCells[p_Map - m_FrozenMaps.data()];
+}
+
+void SpawnIndex::PruneOverlayCell(uint64 p_CellKey, bool p_HadChanges)
+{
+    bool l_HasChanges = false;
+
+    auto l_Itr = m_Overlay.find(p_CellKey);
+    if (l_Itr != m_Overlay.end())
+    {
+        for (uint32 l_Type = 0; l_Type < MAX_SPAWN_TYPE; ++l_Type)
+            l_HasChanges = l_HasChanges || !l_Itr->second.Added[l_Type].empty() || !l_Itr->second.Removed[l_Type].empty();
+
+        if (!l_HasChanges)
+            m_Overlay.erase(l_Itr);
+    }
+
+    if (l_HasChanges == p_HadChanges)
+        return;
+
+    FrozenMap const* l_Map = FindFrozenMap(uint32(p_CellKey >> 32));
+
+    if (l_HasChanges)
+    {
+        ++m_OverlayCellCount;
+        if (l_Map)
+            ++m_FrozenMapOverlayCells[l_Map - m_FrozenMaps.data()];
+    }
+    else
+    {
+        --m_OverlayCellCount;
+        if (l_Map)
+            --m_FrozenMapOverlayCells[l_Map - m_FrozenMaps.data()];
+    }
+}
+
+void SpawnIndex::MergeOverlay(uint32 const* p_Begin, uint32 const* p_End, OverlayCell const* p_Overlay, SpawnType p_Type, std::vector<uint32>& p_Guids)
+{
+    if (!p_Overlay)
+    {
+        p_Guids.insert(p_Guids.end(), p_Begin, p_End);
+        return;
+    }
+
+    size_t l_First = p_Guids.size();
+
+    std::vector<uint32> const& l_Removed = p_Overlay->Removed[p_Type];
+    for (uint32 const* l_Guid = p_Begin; l_Guid != p_End; ++l_Guid)
+    {
+        if (std::find(l_Removed.begin(), l_Removed.end(), *l_Guid) == l_Removed.end())
+            p_Guids.push_back(*l_Guid);
+    }
+
+    p_Guids.insert(p_Guids.end(), p_Overlay->Added[p_Type].begin(), p_Overlay->Added[p_Type].end());
+
+    /// Keep the order of the frozen cells, spawns are created by guid
+    std::sort(p_Guids.begin() + l_First, p_Guids.end());
+}
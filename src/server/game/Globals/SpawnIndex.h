@@ -0,0 +1,91 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+//  MILLENIUM-STUDIO
+//  Copyright 2016 Millenium-studio SARL
+//  All Rights Reserved.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef _SPAWN_INDEX_H
+#define _SPAWN_INDEX_H
+
+#include "Common.h"
+#include <memory>
+#include <unordered_map>
+
+/// Creature and gameobject spawn guids of a cell (or of a whole map), sorted
+struct CellObjectGuids
+{
+    std::vector<uint32> creatures;
+    std::vector<uint32> gameobjects;
+};
+
+/// Spawn guids of each map cell, by map and spawn mode
+/// - Spawns known when the world is loaded are frozen in sorted contiguous arrays, one set per map and spawn mode, read without lock
+/// - Spawns added or removed afterward (pools, game events, GM commands) go to an overlay merged at lookup
+class SpawnIndex
+{
+    public:
+        enum SpawnType
+        {
+            SPAWN_CREATURE   = 0,
+            SPAWN_GAMEOBJECT = 1,
+            MAX_SPAWN_TYPE
+        };
+
+        SpawnIndex() : m_OverlayCellCount(0), m_Generation(0) { }
+
+        void Add(uint16 p_MapId, uint8 p_SpawnMode, uint32 p_CellId, SpawnType p_Type, uint32 p_Guid);
+        void Remove(uint16 p_MapId, uint8 p_SpawnMode, uint32 p_CellId, SpawnType p_Type, uint32 p_Guid);
+
+        /// Move the overlay into the frozen arrays, must be called while no map is updated
+        void Freeze();
+
+        /// Replace the content of p_Guids by the spawns of the cell
+        void GetCellGuids(uint16 p_MapId, uint8 p_SpawnMode, uint32 p_CellId, CellObjectGuids& p_Guids) const;
+        /// Replace the content of p_Guids by the spawns of all the cells of the map
+        void GetMapGuids(uint16 p_MapId, uint8 p_SpawnMode, CellObjectGuids& p_Guids) const;
+
+        /// Changed each time a spawn is added or removed
+        uint32 GetGeneration() const { return m_Generation.load(); }
+
+    private:
+        struct FrozenMap
+        {
+            std::vector<uint32> CellIds;        ///< Sorted
+            std::vector<uint32> Offsets;        ///< First creature and first gameobject of each cell in Guids, then the end of the last cell
+            std::vector<uint32> Guids;          ///< Sorted within each cell and spawn type
+        };
+
+        struct OverlayCell
+        {
+            std::vector<uint32> Added[MAX_SPAWN_TYPE];
+            std::vector<uint32> Removed[MAX_SPAWN_TYPE];    ///< Frozen spawns removed since
+        };
+
+        static uint32 MakeMapKey(uint16 p_MapId, uint8 p_SpawnMode) { return uint32(p_MapId) | (uint32(p_SpawnMode) << 16); }
+        static uint64 MakeCellKey(uint32 p_MapKey, uint32 p_CellId) { return (uint64(p_MapKey) << 32) | p_CellId; }
+
+        FrozenMap const* FindFrozenMap(uint32 p_MapKey) const;
+        /// Frozen guids of the cell, an empty range if none
+        void GetFrozenGuids(FrozenMap const* p_Map, uint32 p_CellId, SpawnType p_Type, uint32 const*& p_Begin, uint32 const*& p_End) const;
+        bool IsFrozen(uint32 p_MapKey, uint32 p_CellId, SpawnType p_Type, uint32 p_Guid) const;
+        /// Changed cells of the overlay of the map, the whole overlay for maps without frozen spawns
+        std::atomic<uint32> const& GetOverlayCellCount(FrozenMap const* p_Map) const;
+        /// Drop the overlay cell once it matches the frozen spawns again and keep the changed cell counts up to date
+        void PruneOverlayCell(uint64 p_CellKey, bool p_HadChanges);
+        /// Append the frozen guids minus the removed ones and the added ones
+        static void MergeOverlay(uint32 const* p_Begin, uint32 const* p_End, OverlayCell const* p_Overlay, SpawnType p_Type, std::vector<uint32>& p_Guids);
+
+        std::vector<uint32>    m_FrozenMapKeys;     ///< Sorted
+        std::vector<FrozenMap> m_FrozenMaps;        ///< Same order as m_FrozenMapKeys
+        std::unique_ptr<std::atomic<uint32>[]> m_FrozenMapOverlayCells;    ///< Changed cells of each frozen map, same order as m_FrozenMaps
+
+        mutable ACE_RW_Thread_Mutex             m_OverlayLock;
+        std::unordered_map<uint64, OverlayCell> m_Overlay;            ///< Only holds cells with pending changes
+        std::atomic<uint32>                     m_OverlayCellCount;   ///< Changed cells of all maps, lets lookups skip the lock while there is none
+
+        std::atomic<uint32> m_Generation;
+};
+
+#endif
@@ -11,6 +11,7 @@
 
 #include "ObjectGridLoader.h"
 #include "UpdateData.h"
+#include "SharedWorldPacket.h"
 #include <iostream>
 
 #include "Corpse.h"
@@ -134,10 +135,11 @@ namespace JadeCore
         uint32 team;
         Player const* skipped_receiver;
         GuidUnorderedSet m_IgnoredGUIDs;
+        SharedWorldPacket m_SharedMessage;  ///< Payload copied once for all the receivers
         MessageDistDeliverer(WorldObject* src, WorldPacket* msg, float dist, bool own_team_only = false, Player const* skipped = NULL, GuidUnorderedSet p_IgnoredSet = GuidUnorderedSet())
             : i_source(src), i_message(msg), i_phaseMask(src->GetPhaseMask()), i_distSq(dist * dist)
             , team((own_team_only && src->IsPlayer()) ? ((Player*)src)->GetTeam() : 0)
-            , skipped_receiver(skipped), m_IgnoredGUIDs(p_IgnoredSet)
+            , skipped_receiver(skipped), m_IgnoredGUIDs(p_IgnoredSet), m_SharedMessage(*msg)
         {
         }
         void Visit(PlayerMapType &m);
@@ -159,7 +161,7 @@ namespace JadeCore
                 return;
 
             if (WorldSession* session = player->GetSession())
-                session->SendPacket(i_message);
+                session->SendPacket(m_SharedMessage);
         }
     };
 
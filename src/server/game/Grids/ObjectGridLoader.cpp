@@ -100,9 +100,9 @@ void AddObjectHelper(CellCoord &cell, GridRefManager<T> &m, uint32 &count, Map*
 }
 
 template <class T>
-void LoadHelper(CellGuidSet const& guid_set, CellCoord &cell, GridRefManager<T> &m, uint32 &count, Map* map)
+void LoadHelper(std::vector<uint32> const& guid_set, CellCoord &cell, GridRefManager<T> &m, uint32 &count, Map* map)
 {
-    for (CellGuidSet::const_iterator i_guid = guid_set.begin(); i_guid != guid_set.end(); ++i_guid)
+    for (std::vector<uint32>::const_iterator i_guid = guid_set.begin(); i_guid != guid_set.end(); ++i_guid)
     {
         T* obj = new T;
         uint32 guid = *i_guid;
@@ -152,23 +152,37 @@ void LoadHelper(CellCorpseSet const& cell_corpses, CellCoord &cell, CorpseMapTyp
 void ObjectGridLoader::Visit(GameObjectMapType &m)
 {
     CellCoord cellCoord = i_cell.GetCellCoord();
-    CellObjectGuids const& cell_guids = sObjectMgr->GetCellObjectGuids(i_map->GetId(), i_map->GetSpawnMode(), cellCoord.GetId());
-    LoadHelper(cell_guids.gameobjects, cellCoord, m, i_gameObjects, i_map);
+
+    if (m_PreparedSpawns)
+    {
+        LoadHelper(m_PreparedSpawns->Cells[i_cell.CellX()][i_cell.CellY()].gameobjects, cellCoord, m, i_gameObjects, i_map);
+        return;
+    }
+
+    sObjectMgr->GetCellObjectGuids(i_map->GetId(), i_map->GetSpawnMode(), cellCoord.GetId(), m_CellGuids);
+    LoadHelper(m_CellGuids.gameobjects, cellCoord, m, i_gameObjects, i_map);
 }
 
 void ObjectGridLoader::Visit(CreatureMapType &m)
 {
     CellCoord cellCoord = i_cell.GetCellCoord();
-    CellObjectGuids const& cell_guids = sObjectMgr->GetCellObjectGuids(i_map->GetId(), i_map->GetSpawnMode(), cellCoord.GetId());
-    LoadHelper(cell_guids.creatures, cellCoord, m, i_creatures, i_map);
+
+    if (m_PreparedSpawns)
+    {
+        LoadHelper(m_PreparedSpawns->Cells[i_cell.CellX()][i_cell.CellY()].creatures, cellCoord, m, i_creatures, i_map);
+        return;
+    }
+
+    sObjectMgr->GetCellObjectGuids(i_map->GetId(), i_map->GetSpawnMode(), cellCoord.GetId(), m_CellGuids);
+    LoadHelper(m_CellGuids.creatures, cellCoord, m, i_creatures, i_map);
 }
 
 void ObjectWorldLoader::Visit(CorpseMapType &m)
 {
     CellCoord cellCoord = i_cell.GetCellCoord();
     // corpses are always added to spawn mode 0 and they are spawned by their instance id
-    CellObjectGuids const& cell_guids = sObjectMgr->GetCellObjectGuids(i_map->GetId(), 0, cellCoord.GetId());
-    LoadHelper(cell_guids.corpses, cellCoord, m, i_corpses, i_map);
+    CellCorpseSet cell_corpses = sObjectMgr->GetCellCorpses(i_map->GetId(), cellCoord.GetId());
+    LoadHelper(cell_corpses, cellCoord, m, i_corpses, i_map);
 }
 
 void ObjectGridLoader::LoadN(void)
@@ -14,6 +14,7 @@
 #include "GridLoader.h"
 #include "GridDefines.h"
 #include "Cell.h"
+#include "GridPrefetcher.h"
 
 class ObjectWorldLoader;
 
@@ -22,8 +23,9 @@ class ObjectGridLoader
     friend class ObjectWorldLoader;
 
     public:
-        ObjectGridLoader(NGridType &grid, Map* map, const Cell &cell)
-            : i_cell(cell), i_grid(grid), i_map(map), i_gameObjects(0), i_creatures(0), i_corpses (0)
+        /// @p_PreparedSpawns : Spawn guids copied by the GridPrefetcher, read from ObjectMgr if nullptr
+        ObjectGridLoader(NGridType &grid, Map* map, const Cell &cell, GridPrefetcher::PreparedSpawns const* p_PreparedSpawns = nullptr)
+            : i_cell(cell), i_grid(grid), i_map(map), i_gameObjects(0), i_creatures(0), i_corpses (0), m_PreparedSpawns(p_PreparedSpawns)
             {}
 
         void Visit(GameObjectMapType &m);
@@ -44,6 +46,8 @@ class ObjectGridLoader
         uint32 i_gameObjects;
         uint32 i_creatures;
         uint32 i_corpses;
+        GridPrefetcher::PreparedSpawns const* m_PreparedSpawns;
+        CellObjectGuids m_CellGuids;                              ///< Reused by each cell
 };
 
 //Stop the creatures before unloading the NGrid
@@ -25,6 +25,8 @@
 #include "LootMgr.h"
 #include "Chat.h"
 #include "zlib.h"
+#include "PacketCompression.h"
+#include <chrono>
 #include "ObjectAccessor.h"
 #include "Object.h"
 #include "Battleground.h"
@@ -293,7 +295,6 @@ void WorldSession::HandleWhoOpcode(WorldPacket& p_RecvData)
     WorldPacket l_Data(SMSG_WHO, 5 * 1024);
     ByteBuffer l_Buffer(5 * 1024);
 
-    TRINITY_READ_GUARD(HashMapHolder<Player>::LockType, *HashMapHolder<Player>::GetLock());
     HashMapHolder<Player>::MapType const& l_PlayersMap = sObjectAccessor->GetPlayers();
 
     for (HashMapHolder<Player>::MapType::const_iterator l_It = l_PlayersMap.begin(); l_It != l_PlayersMap.end(); ++l_It)
@@ -1197,8 +1198,16 @@ void WorldSession::HandleRequestAccountData(WorldPacket& p_Packet)
     ByteBuffer l_CompressedData;
     l_CompressedData.resize(l_DestSize);
 
-    if (l_Size && compress(const_cast<uint8*>(l_CompressedData.contents()), &l_DestSize, (uint8*)l_AccountData->Data.c_str(), l_Size) != Z_OK)
-        return;
+    if (l_Size)
+    {
+        auto l_StartTime = std::chrono::steady_clock::now();
+
+        if (compress2(const_cast<uint8*>(l_CompressedData.contents()), &l_DestSize, (uint8*)l_AccountData->Data.c_str(), l_Size, sPacketCompression->SelectLevel(l_Size)) != Z_OK)
+            return;
+
+        uint64 l_Microseconds = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - l_StartTime).count();
+        sPacketCompression->AddStats(SMSG_UPDATE_ACCOUNT_DATA, l_Size, l_DestSize, l_Microseconds);
+    }
 
     l_CompressedData.resize(l_DestSize);
 
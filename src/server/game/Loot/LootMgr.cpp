@@ -16,6 +16,7 @@
 #include "SpellInfo.h"
 #include "Group.h"
 #include "ObjectAccessor.h"
+#include "QuerySnapshot.h"
 
 static Rates const qualityToRate[MAX_ITEM_QUALITY] =
 {
@@ -58,13 +59,38 @@ class LootTemplate::LootGroup                               // A set of loot def
         LootStoreItemList* GetExplicitlyChancedItemList() { return &ExplicitlyChanced; }
         LootStoreItemList* GetEqualChancedItemList() { return &EqualChanced; }
         void CopyConditions(ConditionContainer conditions);
+        void Compile();                                     // Builds the alias table of the first roll (after loading, entries must not be added anymore)
+        void CompareRolls(uint32 count, LootRollComparison& result) const;
+                                                            // Rolls count times with Roll() and with the alias table
     private:
         LootStoreItemList ExplicitlyChanced;                // Entries with chances defined in DB
         LootStoreItemList EqualChanced;                     // Zero chances - every entry takes the same chance
 
-        LootStoreItem const* Roll() const;                 // Rolls an item from the group, returns NULL if all miss their chances
+        // Alias table (Vose) of the first roll, one column per outcome : explicitly chanced entries, then equal chanced entries
+        // (or a single empty drop if there is none). A column is taken with RollProbabilities, its alias otherwise
+        std::vector<double> RollProbabilities;
+        std::vector<uint32> RollAliases;
+
+        LootStoreItem const* Roll() const;                  // Rolls an item from the group, returns NULL if all miss their chances, kept as the reference of the alias table
+        uint32 RollOutcome() const;                         // Rolls a column of the alias table, O(1)
 };
 
+// Non-equippable items drop up to 3 times in the same loot, equippable items once
+static bool IsDuplicateLootItem(Loot const& loot, uint32 itemid)
+{
+    ItemTemplate const* proto = sObjectMgr->GetItemTemplate(itemid);
+    if (!proto)
+        return false;
+
+    uint8 maxCount = proto->InventoryType == 0 ? 3 : 1;
+    uint8 count = 0;
+    for (LootItemList::const_iterator itr = loot.Items.begin(); itr != loot.Items.end(); ++itr)
+        if (itr->itemid == itemid && ++count == maxCount)
+            return true;
+
+    return false;
+}
+
 //Remove all data and free all memory
 void LootStore::Clear()
 {
@@ -95,7 +121,8 @@ uint32 LootStore::LoadLootTable()
     Clear();
 
     //                                                  0     1            2               3         4         5             6           7
-    QueryResult result = WorldDatabase.PQuery("SELECT entry, item, ChanceOrQuestChance, lootmode, groupid, mincountOrRef, maxcount, itemBonuses FROM %s", GetName());
+    std::string l_Query = std::string("SELECT entry, item, ChanceOrQuestChance, lootmode, groupid, mincountOrRef, maxcount, itemBonuses FROM ") + GetName();
+    QueryResult result = QuerySnapshot::Query(l_Query, { GetName() });
 
     if (!result)
         return 0;
@@ -164,6 +191,9 @@ uint32 LootStore::LoadLootTable()
 
     Verify();                                           // Checks validity of the loot store
 
+    for (LootTemplateMap::const_iterator tab = m_LootTemplates.begin(); tab != m_LootTemplates.end(); ++tab)
+        tab->second->Compile();                         // Rolling tables, all the entries are loaded
+
     return count;
 }
 
@@ -1627,88 +1657,217 @@ void LootTemplate::LootGroup::CopyConditions(ConditionContainer /*conditions*/)
     }
 }
 
+// Builds the alias table giving the same distribution as the sequential roll of Roll()
+void LootTemplate::LootGroup::Compile()
+{
+    std::vector<double> weights;
+    weights.reserve(ExplicitlyChanced.size() + std::max<size_t>(EqualChanced.size(), 1));
+
+    // Same walk as Roll() : an entry takes its chance out of what is left, an entry at 100% takes everything left
+    double left = 100.0;
+    for (LootStoreItemList::const_iterator i = ExplicitlyChanced.begin(); i != ExplicitlyChanced.end(); ++i)
+    {
+        double chance = i->chance >= 100.0f ? left : std::min<double>(i->chance, left);
+        weights.push_back(chance);
+        left -= chance;
+    }
+
+    // Nothing selected : an equal chanced entry at random, or an empty drop
+    if (!EqualChanced.empty())
+        weights.resize(weights.size() + EqualChanced.size(), left / EqualChanced.size());
+    else
+        weights.push_back(left);
+
+    uint32 count = weights.size();
+    RollProbabilities.assign(count, 1.0);
+    RollAliases.resize(count);
+
+    std::vector<uint32> small, large;
+    for (uint32 i = 0; i < count; ++i)
+    {
+        RollAliases[i] = i;
+        weights[i] = weights[i] * count / 100.0;    // 1.0 is the average column
+        if (weights[i] < 1.0)
+            small.push_back(i);
+        else
+            large.push_back(i);
+    }
+
+    // Each small column is filled up by a large one, which becomes small once it gave too much
+    while (!small.empty() && !large.empty())
+    {
+        uint32 less = small.back();
+        uint32 more = large.back();
+        small.pop_back();
+
+        RollProbabilities[less] = weights[less];
+        RollAliases[less] = more;
+
+        weights[more] -= 1.0 - weights[less];
+        if (weights[more] < 1.0)
+        {
+            large.pop_back();
+            small.push_back(more);
+        }
+    }
+
+    // Only rounding errors are left, these columns are full
+    for (uint32 i = 0; i < small.size(); ++i)
+        RollProbabilities[small[i]] = 1.0;
+    for (uint32 i = 0; i < large.size(); ++i)
+        RollProbabilities[large[i]] = 1.0;
+}
+
+uint32 LootTemplate::LootGroup::RollOutcome() const
+{
+    // The integer part picks the column, the fractional part decides between the column and its alias
+    double roll = rand_norm() * RollProbabilities.size();
+    uint32 column = std::min<uint32>(uint32(roll), RollProbabilities.size() - 1);
+
+    return roll - column < RollProbabilities[column] ? column : RollAliases[column];
+}
+
+// Rolls count times with the sequential walk of Roll() and with the alias table, then compares both samples
+void LootTemplate::LootGroup::CompareRolls(uint32 count, LootRollComparison& result) const
+{
+    uint32 outcomes = RollProbabilities.size();
+
+    result.OutcomeItems.assign(outcomes, 0);
+    result.SequentialCounts.assign(outcomes, 0);
+    result.AliasCounts.assign(outcomes, 0);
+
+    for (uint32 i = 0; i < ExplicitlyChanced.size(); ++i)
+        result.OutcomeItems[i] = ExplicitlyChanced[i].itemid;
+    for (uint32 i = 0; i < EqualChanced.size(); ++i)
+        result.OutcomeItems[ExplicitlyChanced.size() + i] = EqualChanced[i].itemid;
+
+    for (uint32 i = 0; i < count; ++i)
+    {
+        // Same columns as the alias table : explicitly chanced entries, equal chanced entries or the empty drop
+        LootStoreItem const* item = Roll();
+        if (!item)
+            ++result.SequentialCounts[ExplicitlyChanced.size()];
+        else if (!ExplicitlyChanced.empty() && item >= &ExplicitlyChanced.front() && item <= &ExplicitlyChanced.back())
+            ++result.SequentialCounts[item - &ExplicitlyChanced.front()];
+        else
+            ++result.SequentialCounts[ExplicitlyChanced.size() + (item - &EqualChanced.front())];
+
+        ++result.AliasCounts[RollOutcome()];
+    }
+
+    // Two samples of the same size : sum of (a - b)^2 / (a + b) over the outcomes rolled at least once
+    result.ChiSquare = 0.0;
+    result.Degrees = 0;
+    for (uint32 i = 0; i < outcomes; ++i)
+    {
+        double total = double(result.SequentialCounts[i]) + result.AliasCounts[i];
+        if (total == 0.0)
+            continue;
+
+        double diff = double(result.SequentialCounts[i]) - result.AliasCounts[i];
+        result.ChiSquare += diff * diff / total;
+        ++result.Degrees;
+    }
+
+    if (result.Degrees)
+        --result.Degrees;
+
+    if (!result.Degrees)
+    {
+        result.PValue = 1.0;
+        return;
+    }
+
+    // Wilson-Hilferty : the cube root of chi-square / degrees is about normal
+    double k = result.Degrees;
+    double z = (std::cbrt(result.ChiSquare / k) - (1.0 - 2.0 / (9.0 * k))) / std::sqrt(2.0 / (9.0 * k));
+    result.PValue = 0.5 * std::erfc(z / std::sqrt(2.0));
+}
+
 // Rolls an item from the group (if any takes its chance) and adds the item to the loot
 void LootTemplate::LootGroup::Process(Loot& loot, uint16 lootMode) const
 {
-    // build up list of possible drops
-    LootStoreItemList EqualPossibleDrops = EqualChanced;
-    LootStoreItemList ExplicitPossibleDrops = ExplicitlyChanced;
+    // Possible drops : the explicitly chanced entries from explicitBegin, and equalCount equal chanced entries,
+    // equalPossibleDrops holds their indexes once one of them was removed
+    uint32 explicitBegin = 0;
+    uint32 equalCount = EqualChanced.size();
+    std::vector<uint32> equalPossibleDrops;
 
     uint8 uiAttemptCount = 0;
     const uint8 uiMaxAttempts = ExplicitlyChanced.size() + EqualChanced.size();
 
-    while (!ExplicitPossibleDrops.empty() || !EqualPossibleDrops.empty())
+    while (explicitBegin < ExplicitlyChanced.size() || equalCount)
     {
         if (uiAttemptCount == uiMaxAttempts)             // already tried rolling too many times, just abort
             return;
 
-        LootStoreItem* item = NULL;
+        LootStoreItem const* item = NULL;
+        uint32 equalPosition = 0;
 
-        // begin rolling (normally called via Roll())
-        LootStoreItemList::iterator itr;
-        uint8 itemSource = 0;
-        if (!ExplicitPossibleDrops.empty())              // First explicitly chanced entries are checked
+        if (!uiAttemptCount)                             // First roll, from the alias table
+        {
+            uint32 outcome = RollOutcome();
+            if (outcome < ExplicitlyChanced.size())
+            {
+                explicitBegin = outcome;                    // Entries before the selected one missed their chance
+                item = &ExplicitlyChanced[outcome];
+            }
+            else
+            {
+                explicitBegin = ExplicitlyChanced.size();
+                equalPosition = outcome - ExplicitlyChanced.size();
+                if (equalPosition < EqualChanced.size())
+                    item = &EqualChanced[equalPosition];
+            }
+        }
+        else                                             // Rolls again what is left after a duplicate or a loot mode mismatch
         {
-            itemSource = 1;
-            float Roll = (float)rand_chance();
-            // check each explicitly chanced entry in the template and modify its chance based on quality
-            for (itr = ExplicitPossibleDrops.begin(); itr != ExplicitPossibleDrops.end(); itr = ExplicitPossibleDrops.erase(itr))
+            if (explicitBegin < ExplicitlyChanced.size())
             {
-                if (itr->chance >= 100.0f)
+                float Roll = (float)rand_chance();
+                for (; explicitBegin < ExplicitlyChanced.size(); ++explicitBegin)
                 {
-                    item = &*itr;
-                    break;
-                }
+                    LootStoreItem const& entry = ExplicitlyChanced[explicitBegin];
 
-                Roll -= itr->chance;
-                if (Roll < 0)
-                {
-                    item = &*itr;
-                    break;
+                    Roll -= entry.chance;
+                    if (entry.chance >= 100.0f || Roll < 0)
+                    {
+                        item = &entry;
+                        break;
+                    }
                 }
             }
+            if (item == NULL && equalCount)              // If nothing selected yet - an item is taken from equal-chanced part
+            {
+                equalPosition = irand(0, equalCount - 1);
+                item = &EqualChanced[equalPossibleDrops.empty() ? equalPosition : equalPossibleDrops[equalPosition]];
+            }
         }
-        if (item == NULL && !EqualPossibleDrops.empty()) // If nothing selected yet - an item is taken from equal-chanced part
-        {
-            itemSource = 2;
-            itr = EqualPossibleDrops.begin();
-            std::advance(itr, irand(0, EqualPossibleDrops.size()-1));
-            item = &*itr;
-        }
-        // finish rolling
 
         ++uiAttemptCount;
 
         if (item != NULL && item->lootmode & lootMode)   // only add this item if roll succeeds and the mode matches
         {
-            bool duplicate = false;
-            if (ItemTemplate const* _proto = sObjectMgr->GetItemTemplate(item->itemid))
+            if (!IsDuplicateLootItem(loot, item->itemid)) // otherwise, add the item and exit the function
             {
-                uint8 _item_counter = 0;
-                for (LootItemList::const_iterator _item = loot.Items.begin(); _item != loot.Items.end(); ++_item)
-                    if (_item->itemid == item->itemid)                             // search through the items that have already dropped
-                    {
-                        ++_item_counter;
-                        if (_proto->InventoryType == 0 && _item_counter == 3)      // Non-equippable items are limited to 3 drops
-                            duplicate = true;
-                        else if (_proto->InventoryType != 0 && _item_counter == 1) // Equippable item are limited to 1 drop
-                            duplicate = true;
-                    }
+                loot.AddItem(*item);
+                return;
             }
-            if (duplicate) // if item->itemid is a duplicate, remove it
-                switch (itemSource)
+
+            // item->itemid is a duplicate, remove it
+            if (explicitBegin < ExplicitlyChanced.size())
+                ++explicitBegin;
+            else
+            {
+                if (equalPossibleDrops.empty())
                 {
-                    case 1: // item came from ExplicitPossibleDrops
-                        ExplicitPossibleDrops.erase(itr);
-                        break;
-                    case 2: // item came from EqualPossibleDrops
-                        EqualPossibleDrops.erase(itr);
-                        break;
+                    equalPossibleDrops.resize(equalCount);
+                    for (uint32 i = 0; i < equalCount; ++i)
+                        equalPossibleDrops[i] = i;
                 }
-            else           // otherwise, add the item and exit the function
-            {
-                loot.AddItem(*item);
-                return;
+
+                equalPossibleDrops.erase(equalPossibleDrops.begin() + equalPosition);
+                --equalCount;
             }
         }
     }
@@ -1871,6 +2030,16 @@ void LootTemplate::CopyConditions(ConditionContainer conditions)
         i->CopyConditions(conditions);
 }
 
+// Rolls the group count times both with the sequential walk and with the alias table
+bool LootTemplate::CompareGroupRolls(uint8 groupId, uint32 count, LootRollComparison& result) const
+{
+    if (!groupId || groupId > Groups.size())
+        return false;
+
+    Groups[groupId-1].CompareRolls(count, result);
+    return true;
+}
+
 // Rolls for every item in the template and adds the rolled items the the loot
 void LootTemplate::Process(Loot& loot, bool rate, uint16 lootMode, Player const* lootOwner, uint8 groupId) const
 {
@@ -1991,6 +2160,13 @@ bool LootTemplate::HasQuestDropForPlayer(LootTemplateMap const& store, Player co
     return false;
 }
 
+// Builds the rolling tables of the groups
+void LootTemplate::Compile()
+{
+    for (LootGroups::iterator i = Groups.begin(); i != Groups.end(); ++i)
+        i->Compile();
+}
+
 // Checks integrity of the template
 void LootTemplate::Verify(LootStore const& lootstore, uint32 id) const
 {
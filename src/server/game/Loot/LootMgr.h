@@ -191,6 +191,17 @@ typedef std::unordered_map<uint32, LootTemplate*> LootTemplateMap;
 
 typedef std::set<uint32> LootIdSet;
 
+// First roll of a loot group done both with the sequential walk over the entries and with the alias table
+struct LootRollComparison
+{
+    std::vector<uint32> OutcomeItems;                       // Item of each outcome, 0 for the empty drop
+    std::vector<uint32> SequentialCounts;                   // Times each outcome was rolled by the sequential walk
+    std::vector<uint32> AliasCounts;                        // Times each outcome was rolled by the alias table
+    double ChiSquare;                                       // Homogeneity of the two samples
+    uint32 Degrees;                                         // Degrees of freedom of ChiSquare
+    double PValue;                                          // Chance to get at least ChiSquare if both rolls have the same distribution
+};
+
 class LootStore
 {
     public:
@@ -247,6 +258,10 @@ class LootTemplate
 
         // Checks integrity of the template
         void Verify(LootStore const& store, uint32 Id) const;
+        // Builds the rolling tables, once all the entries are added
+        void Compile();
+        // Rolls the group count times both ways, false if there is no such group
+        bool CompareGroupRolls(uint8 groupId, uint32 count, LootRollComparison& result) const;
         void CheckLootRefs(LootTemplateMap const& store, LootIdSet* ref_set) const;
         bool addConditionItem(Condition* cond);
         bool isReference(uint32 id);
@@ -0,0 +1,237 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+//  MILLENIUM-STUDIO
+//  Copyright 2016 Millenium-studio SARL
+//  All Rights Reserved.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+#include "GridPrefetcher.h"
+#include "Map.h"
+#include "MapTree.h"
+#include "ObjectMgr.h"
+#include "World.h"
+#include "Config.h"
+#include "Timer.h"
+
+/// A prepared grid nobody came to is dropped after this delay
+#define GRID_PREFETCH_EXPIRE_TIME   (30 * IN_MILLISECONDS)
+/// Oldest prepared grids are dropped above this count, a terrain takes a few hundred KB
+#define GRID_PREFETCH_MAX_PREPARED  64
+
+namespace
+{
+    /// Read the whole file so the following load by the map thread doesn't wait for the disk
+    void WarmFile(std::string const& p_Path)
+    {
+        FILE* l_File = fopen(p_Path.c_str(), "rb");
+        if (!l_File)
+            return;
+
+        char l_Buffer[64 * 1024];
+        while (fread(l_Buffer, 1, sizeof(l_Buffer), l_File) == sizeof(l_Buffer))
+            ;
+
+        fclose(l_File);
+    }
+}
+
+void GridPrefetcher::activate(size_t num_threads)
+{
+    for (size_t i = 0; i < num_threads; ++i)
+        _workerThreads.push_back(std::thread(&GridPrefetcher::WorkerThread, this));
+}
+
+void GridPrefetcher::deactivate()
+{
+    {
+        std::lock_guard<std::mutex> l_Lock(m_Lock);
+        _cancelationToken = true;
+    }
+
+    m_Condition.notify_all();
+
+    for (auto& l_Thread : _workerThreads)
+        l_Thread.join();
+
+    _workerThreads.clear();
+
+    for (auto& l_Pair : m_PreparedGrids)
+        delete l_Pair.second.Terrain;
+
+    m_PreparedGrids.clear();
+    m_Requests.clear();
+    m_PendingKeys.clear();
+}
+
+bool GridPrefetcher::activated()
+{
+    return _workerThreads.size() > 0 && !_cancelationToken;
+}
+
+uint64 GridPrefetcher::MakeKey(uint32 p_MapId, GridCoord const& p_Grid, uint8 p_SpawnMode)
+{
+    return (uint64(p_MapId) << 24) | (uint64(p_Grid.x_coord) << 16) | (uint64(p_Grid.y_coord) << 8) | p_SpawnMode;
+}
+
+void GridPrefetcher::Request(uint32 p_MapId, uint8 p_SpawnMode, GridCoord const& p_Grid, bool p_Terrain)
+{
+    uint64 l_Key = MakeKey(p_MapId, p_Grid, p_SpawnMode);
+
+    {
+        std::lock_guard<std::mutex> l_Lock(m_Lock);
+
+        if (_cancelationToken || m_PendingKeys.find(l_Key) != m_PendingKeys.end() || m_PreparedGrids.find(l_Key) != m_PreparedGrids.end())
+            return;
+
+        GridRequest l_Request;
+        l_Request.Key     = l_Key;
+        l_Request.Terrain = p_Terrain;
+
+        m_PendingKeys.insert(l_Key);
+        m_Requests.push_back(l_Request);
+    }
+
+    m_Condition.notify_one();
+}
+
+GridMap* GridPrefetcher::TakeTerrain(uint32 p_MapId, GridCoord const& p_Grid)
+{
+    std::lock_guard<std::mutex> l_Lock(m_Lock);
+
+    /// The terrain doesn't depend on the spawn mode, any request for this grid may have loaded it
+    auto l_End = m_PreparedGrids.upper_bound(MakeKey(p_MapId, p_Grid, 0xFF));
+    for (auto l_Itr = m_PreparedGrids.lower_bound(MakeKey(p_MapId, p_Grid, 0)); l_Itr != l_End; ++l_Itr)
+    {
+        if (GridMap* l_Terrain = l_Itr->second.Terrain)
+        {
+            l_Itr->second.Terrain = nullptr;
+            ++m_UsedTerrainCount;
+            return l_Terrain;
+        }
+    }
+
+    return nullptr;
+}
+
+std::unique_ptr<GridPrefetcher::PreparedSpawns> GridPrefetcher::TakeSpawns(uint32 p_MapId, uint8 p_SpawnMode, GridCoord const& p_Grid)
+{
+    std::unique_ptr<PreparedSpawns> l_Spawns;
+
+    std::lock_guard<std::mutex> l_Lock(m_Lock);
+
+    auto l_Itr = m_PreparedGrids.find(MakeKey(p_MapId, p_Grid, p_SpawnMode));
+    if (l_Itr == m_PreparedGrids.end())
+        return l_Spawns;
+
+    /// A spawn added or removed since the copy, the map thread reads ObjectMgr again
+    if (l_Itr->second.Generation == sObjectMgr->GetCellObjectGuidsGeneration())
+    {
+        l_Spawns = std::move(l_Itr->second.Spawns);
+
+        if (l_Spawns)
+            ++m_UsedSpawnsCount;
+    }
+
+    delete l_Itr->second.Terrain;
+    m_PreparedGrids.erase(l_Itr);
+
+    return l_Spawns;
+}
+
+void GridPrefetcher::Prepare(GridRequest const& p_Request)
+{
+    uint32     l_MapId     = uint32(p_Request.Key >> 24);
+    GridCoord  l_Grid(uint32(p_Request.Key >> 16) & 0xFF, uint32(p_Request.Key >> 8) & 0xFF);
+    uint8      l_SpawnMode = uint8(p_Request.Key);
+
+    /// Terrain files use the swapped coordinates of Map::LoadMapAndVMap
+    int l_GridX = (MAX_NUMBER_OF_GRIDS - 1) - l_Grid.x_coord;
+    int l_GridY = (MAX_NUMBER_OF_GRIDS - 1) - l_Grid.y_coord;
+
+    PreparedGrid l_Prepared;
+
+    if (p_Request.Terrain)
+    {
+        char l_Path[4096];
+        snprintf(l_Path, sizeof(l_Path), "%smaps/%04u_%02u_%02u.map", sWorld->GetDataPath().c_str(), l_MapId, l_GridX, l_GridY);
+
+        l_Prepared.Terrain = new GridMap();
+        if (!l_Prepared.Terrain->loadData(l_Path))
+        {
+            /// The map thread loads it again and reports the error
+            delete l_Prepared.Terrain;
+            l_Prepared.Terrain = nullptr;
+        }
+
+        WarmFile(sWorld->GetDataPath() + "vmaps/" + VMAP::StaticMapTree::getTileFileName(l_MapId, l_GridX, l_GridY));
+
+        snprintf(l_Path, sizeof(l_Path), "%s/mmaps/%04i%02i%02i.mmtile", ConfigMgr::GetStringDefault("DataDir", ".").c_str(), l_MapId, l_GridX, l_GridY);
+        WarmFile(l_Path);
+    }
+
+    l_Prepared.Generation = sObjectMgr->GetCellObjectGuidsGeneration();
+    l_Prepared.Spawns.reset(new PreparedSpawns());
+
+    for (uint32 l_X = 0; l_X < MAX_NUMBER_OF_CELLS; ++l_X)
+    {
+        for (uint32 l_Y = 0; l_Y < MAX_NUMBER_OF_CELLS; ++l_Y)
+        {
+            CellCoord l_CellCoord(l_Grid.x_coord * MAX_NUMBER_OF_CELLS + l_X, l_Grid.y_coord * MAX_NUMBER_OF_CELLS + l_Y);
+            sObjectMgr->GetCellObjectGuids(l_MapId, l_SpawnMode, l_CellCoord.GetId(), l_Prepared.Spawns->Cells[l_X][l_Y]);
+        }
+    }
+
+    l_Prepared.Time = getMSTime();
+
+    std::lock_guard<std::mutex> l_Lock(m_Lock);
+
+    m_PendingKeys.erase(p_Request.Key);
+
+    RemoveExpired();
+
+    m_PreparedGrids[p_Request.Key] = std::move(l_Prepared);
+    ++m_PreparedCount;
+}
+
+void GridPrefetcher::RemoveExpired()
+{
+    while (!m_PreparedGrids.empty())
+    {
+        auto l_Oldest = m_PreparedGrids.begin();
+        for (auto l_Itr = m_PreparedGrids.begin(); l_Itr != m_PreparedGrids.end(); ++l_Itr)
+        {
+            if (l_Itr->second.Time < l_Oldest->second.Time)
+                l_Oldest = l_Itr;
+        }
+
+        if (m_PreparedGrids.size() < GRID_PREFETCH_MAX_PREPARED && GetMSTimeDiffToNow(l_Oldest->second.Time) < GRID_PREFETCH_EXPIRE_TIME)
+            break;
+
+        delete l_Oldest->second.Terrain;
+        m_PreparedGrids.erase(l_Oldest);
+    }
+}
+
+void GridPrefetcher::WorkerThread()
+{
+    for (;;)
+    {
+        GridRequest l_Request;
+
+        {
+            std::unique_lock<std::mutex> l_Lock(m_Lock);
+
+            while (m_Requests.empty() && !_cancelationToken)
+                m_Condition.wait(l_Lock);
+
+            if (_cancelationToken)
+                break;
+
+            l_Request = m_Requests.front();
+            m_Requests.pop_front();
+        }
+
+        Prepare(l_Request);
+    }
+}
@@ -0,0 +1,94 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+//  MILLENIUM-STUDIO
+//  Copyright 2016 Millenium-studio SARL
+//  All Rights Reserved.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef _GRID_PREFETCHER_H_INCLUDED
+#define _GRID_PREFETCHER_H_INCLUDED
+
+#include "Define.h"
+#include "Common.h"
+#include "GridDefines.h"
+#include "SpawnIndex.h"
+#include <condition_variable>
+#include <deque>
+#include <memory>
+
+class GridMap;
+
+/// Thread pool loading in advance the grids players are heading to, shared by all maps
+/// - The terrain (.map) is parsed by the pool and handed over to Map::LoadMap
+/// - vmap and mmap tiles are read once by the pool, the map thread then loads them from the page cache
+/// - The spawn guids of each cell are copied from ObjectMgr, creatures and gameobjects are still created by the map thread
+class GridPrefetcher
+{
+    public:
+        struct PreparedSpawns
+        {
+            CellObjectGuids Cells[MAX_NUMBER_OF_CELLS][MAX_NUMBER_OF_CELLS];
+        };
+
+        GridPrefetcher() : _cancelationToken(false), m_PreparedCount(0), m_UsedTerrainCount(0), m_UsedSpawnsCount(0) { }
+        ~GridPrefetcher() { }
+
+        void activate(size_t num_threads);
+        void deactivate();
+        bool activated();
+
+        /// Queue the preparation of a grid, ignored if it's already queued or prepared
+        /// @p_Grid    : NGrid coordinates
+        /// @p_Terrain : The terrain of this grid isn't loaded yet by the base map
+        void Request(uint32 p_MapId, uint8 p_SpawnMode, GridCoord const& p_Grid, bool p_Terrain);
+
+        /// Prepared terrain of the grid, nullptr if none. The caller owns the returned GridMap
+        GridMap* TakeTerrain(uint32 p_MapId, GridCoord const& p_Grid);
+        /// Prepared spawns of the grid, nullptr if none or if ObjectMgr spawns changed since
+        std::unique_ptr<PreparedSpawns> TakeSpawns(uint32 p_MapId, uint8 p_SpawnMode, GridCoord const& p_Grid);
+
+        uint32 GetPreparedCount() const { return m_PreparedCount.load(); }
+        uint32 GetUsedTerrainCount() const { return m_UsedTerrainCount.load(); }
+        uint32 GetUsedSpawnsCount() const { return m_UsedSpawnsCount.load(); }
+
+    private:
+        struct GridRequest
+        {
+            uint64 Key;
+            bool   Terrain;
+        };
+
+        struct PreparedGrid
+        {
+            PreparedGrid() : Terrain(nullptr), Generation(0), Time(0) { }
+
+            GridMap*                        Terrain;
+            std::unique_ptr<PreparedSpawns> Spawns;
+            uint32                          Generation;     ///< ObjectMgr::GetCellObjectGuidsGeneration when the spawns were copied
+            uint32                          Time;           ///< getMSTime when prepared
+        };
+
+        /// Map, grid then spawn mode, the prepared grids of all spawn modes of a map grid are contiguous
+        static uint64 MakeKey(uint32 p_MapId, GridCoord const& p_Grid, uint8 p_SpawnMode);
+
+        void Prepare(GridRequest const& p_Request);
+        /// Must be called with m_Lock held
+        void RemoveExpired();
+        void WorkerThread();
+
+        std::mutex                     m_Lock;
+        std::condition_variable        m_Condition;
+        std::deque<GridRequest>        m_Requests;
+        std::set<uint64>               m_PendingKeys;      ///< Queued or being prepared
+        std::map<uint64, PreparedGrid> m_PreparedGrids;
+
+        std::vector<std::thread> _workerThreads;
+        bool _cancelationToken;
+
+        std::atomic<uint32> m_PreparedCount;
+        std::atomic<uint32> m_UsedTerrainCount;
+        std::atomic<uint32> m_UsedSpawnsCount;
+};
+
+#endif //_GRID_PREFETCHER_H_INCLUDED
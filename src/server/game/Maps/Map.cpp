@@ -28,6 +28,7 @@
 #include "OutdoorPvPMgr.h"
 #include "DisableMgr.h"
 #include "Logger.h"
+#include "PathGenerator.h"
 
 u_map_magic MapMagic        = { {'M','A','P','S'} };
 u_map_magic MapVersionMagic = { {'v','1','.','8'} };
@@ -37,6 +38,7 @@ u_map_magic MapLiquidMagic  = { {'M','L','I','Q'} };
 
 #define DEFAULT_GRID_EXPIRY     300
 #define MAX_GRID_LOAD_TIME      50
+#define PATH_REQUEST_MAX_TASKS  16
 #define MAX_CREATURE_ATTACK_RADIUS  (45.0f * sWorld->getRate(RATE_CREATURE_AGGRO))
 
 GridState* si_GridStates[MAX_GRID_STATE];
@@ -68,6 +70,14 @@ Map::~Map()
         sScriptMgr->DecreaseScheduledScriptCount(m_scriptSchedule.size());
 
     MMAP::MMapFactory::createOrGetMMapManager()->unloadMapInstance(GetId(), i_InstanceId);
+
+    /// Owners of requests still queued have left the map without canceling them
+    for (PathGenerator* l_Path : m_PathRequests)
+    {
+        l_Path->_requestResult = false;
+        l_Path->_requestState  = PATH_REQUEST_DONE;
+        l_Path->_requestMap    = NULL;
+    }
 }
 
 NGridType* Map::getNGrid(uint32 x, uint32 y) const
@@ -186,6 +196,16 @@ void Map::LoadMap(int gx, int gy, bool reload)
         GridMaps[gx][gy]=NULL;
     }
 
+    /// Terrain already loaded by the grid prefetcher
+    if (!GridMaps[gx][gy] && sMapMgr->GetGridPrefetcher()->activated())
+    {
+        if (GridMap* l_Terrain = sMapMgr->GetGridPrefetcher()->TakeTerrain(GetId(), GridCoord((MAX_NUMBER_OF_GRIDS - 1) - gx, (MAX_NUMBER_OF_GRIDS - 1) - gy)))
+        {
+            GridMaps[gx][gy] = l_Terrain;
+            return;
+        }
+    }
+
     // map file name
     char *tmp=NULL;
     int len = sWorld->GetDataPath().length()+strlen("maps/%04u_%02u_%02u.map")+1;
@@ -232,7 +252,7 @@ void Map::DeleteStateMachine()
 Map::Map(uint32 id, time_t expiry, uint32 InstanceId, uint8 SpawnMode, Map* _parent):
 _creatureToMoveLock(false), _gameObjectsToMoveLock(false), i_mapEntry(sMapStore.LookupEntry(id)),
 i_spawnMode(SpawnMode), i_InstanceId(InstanceId), m_unloadTimer(0), m_VisibleDistance(DEFAULT_VISIBILITY_DISTANCE),
-m_VisibilityNotifyPeriod(DEFAULT_VISIBILITY_NOTIFY_PERIOD),
+m_VisibilityNotifyPeriod(DEFAULT_VISIBILITY_NOTIFY_PERIOD), m_LastUpdateCost(0),
 m_activeNonPlayersIter(m_activeNonPlayers.end()), _transportsGameObjectUpdateIter(_transportsGameObject.end()), _transportsUpdateIter(_transports.end()),
 i_gridExpiry(expiry), i_scriptLock(false)
 {
@@ -447,12 +467,15 @@ bool Map::EnsureGridLoaded(const Cell &cell)
 
         setGridObjectDataLoaded(true, cell.GridX(), cell.GridY());
 
-        ObjectGridLoader loader(*grid, this, cell);
+        std::unique_ptr<GridPrefetcher::PreparedSpawns> l_PreparedSpawns;
+        if (sMapMgr->GetGridPrefetcher()->activated())
+            l_PreparedSpawns = sMapMgr->GetGridPrefetcher()->TakeSpawns(GetId(), GetSpawnMode(), GridCoord(cell.GridX(), cell.GridY()));
+
+        ObjectGridLoader loader(*grid, this, cell, l_PreparedSpawns.get());
         loader.LoadN();
 
         // Add resurrectable corpses to world object list in grid
         sObjectAccessor->AddCorpsesToGrid(GridCoord(cell.GridX(), cell.GridY()), grid->GetGridType(cell.CellX(), cell.CellY()), this);
-        Balance();
         return true;
     }
 
@@ -464,6 +487,35 @@ void Map::LoadGrid(float x, float y)
     EnsureGridLoaded(Cell(x, y));
 }
 
+void Map::PrefetchGridAhead(Player* p_Player)
+{
+    bool l_InFlight = p_Player->isInFlight();
+    if (!l_InFlight && !p_Player->IsMoving())
+        return;
+
+    /// Position after the look-ahead time if the player keeps the same heading and speed
+    float l_Speed    = p_Player->GetSpeed((l_InFlight || p_Player->IsFlying()) ? MOVE_FLIGHT : MOVE_RUN);
+    float l_Distance = l_Speed * float(sWorld->getIntConfig(CONFIG_GRID_PREFETCH_LOOKAHEAD)) / float(IN_MILLISECONDS);
+    float l_X        = p_Player->GetPositionX() + l_Distance * std::cos(p_Player->GetOrientation());
+    float l_Y        = p_Player->GetPositionY() + l_Distance * std::sin(p_Player->GetOrientation());
+
+    if (!JadeCore::IsValidMapCoord(l_X, l_Y))
+        return;
+
+    GridCoord l_Grid = JadeCore::ComputeGridCoord(l_X, l_Y);
+    if (l_Grid == JadeCore::ComputeGridCoord(p_Player->GetPositionX(), p_Player->GetPositionY()))
+        return;
+
+    if (getNGrid(l_Grid.x_coord, l_Grid.y_coord) && isGridObjectDataLoaded(l_Grid.x_coord, l_Grid.y_coord))
+        return;
+
+    /// Instances use the terrain of their base map
+    Map const* l_TerrainMap = i_InstanceId ? m_parentMap : this;
+    bool       l_Terrain    = !l_TerrainMap->GridMaps[(MAX_NUMBER_OF_GRIDS - 1) - l_Grid.x_coord][(MAX_NUMBER_OF_GRIDS - 1) - l_Grid.y_coord];
+
+    sMapMgr->GetGridPrefetcher()->Request(GetId(), GetSpawnMode(), l_Grid, l_Terrain);
+}
+
 bool Map::AddPlayerToMap(Player* player, bool p_Switched /*= false*/)
 {
     CellCoord cellCoord = JadeCore::ComputeCellCoord(player->GetPositionX(), player->GetPositionY());
@@ -621,7 +673,8 @@ void Map::Update(const uint32 t_diff)
 
     uint32 l_Time = getMSTime();
 
-    _dynamicTree.update(t_diff);
+    ProcessPathRequests();
+
     /// update worldsessions for existing players
     for (m_mapRefIter = m_mapRefManager.begin(); m_mapRefIter != m_mapRefManager.end(); ++m_mapRefIter)
     {
@@ -654,6 +707,8 @@ void Map::Update(const uint32 t_diff)
     // for pets
     TypeContainerVisitor<JadeCore::ObjectUpdater, WorldTypeMapContainer > world_object_update(updater);
 
+    bool l_PrefetchGrids = sMapMgr->GetGridPrefetcher()->activated();
+
     // the player iterator is stored in the map object
     // to make sure calls to Map::Remove don't invalidate it
     for (m_mapRefIter = m_mapRefManager.begin(); m_mapRefIter != m_mapRefManager.end(); ++m_mapRefIter)
@@ -679,6 +734,9 @@ void Map::Update(const uint32 t_diff)
         // update players at tick
         player->Update(t_diff);
 
+        if (l_PrefetchGrids && player->IsInWorld())
+            PrefetchGridAhead(player);
+
         VisitNearbyCellsOf(player, grid_object_update, world_object_update);
     }
 
@@ -734,6 +792,69 @@ void Map::Update(const uint32 t_diff)
 #endif
 }
 
+void Map::AddPathRequest(PathGenerator* p_Path)
+{
+    std::lock_guard<std::mutex> l_Lock(m_PathRequestsLock);
+    m_PathRequests.push_back(p_Path);
+}
+
+void Map::RemovePathRequest(PathGenerator* p_Path)
+{
+    std::lock_guard<std::mutex> l_Lock(m_PathRequestsLock);
+
+    auto l_Itr = std::find(m_PathRequests.begin(), m_PathRequests.end(), p_Path);
+    if (l_Itr == m_PathRequests.end())
+        return;
+
+    *l_Itr = m_PathRequests.back();
+    m_PathRequests.pop_back();
+}
+
+void Map::ProcessPathRequests()
+{
+    std::vector<PathGenerator*> l_Requests;
+
+    {
+        std::lock_guard<std::mutex> l_Lock(m_PathRequestsLock);
+        l_Requests.swap(m_PathRequests);
+    }
+
+    if (l_Requests.empty())
+        return;
+
+    /// Nothing else runs on this map meanwhile, each path only uses its own pooled dtNavMeshQuery
+    PathRequestUpdater* l_Updater = sMapMgr->GetPathRequestUpdater();
+    if (l_Updater->activated() && l_Requests.size() > 1)
+    {
+        size_t l_PerTask = (l_Requests.size() + PATH_REQUEST_MAX_TASKS - 1) / PATH_REQUEST_MAX_TASKS;
+
+        PathRequestUpdater::Tasks l_Tasks;
+        for (size_t l_Begin = 0; l_Begin < l_Requests.size(); l_Begin += l_PerTask)
+        {
+            size_t l_End = std::min(l_Begin + l_PerTask, l_Requests.size());
+
+            l_Tasks.push_back([&l_Requests, l_Begin, l_End]() -> void
+            {
+                for (size_t l_I = l_Begin; l_I < l_End; ++l_I)
+                    l_Requests[l_I]->ExecutePathRequest();
+            });
+        }
+
+        l_Updater->Run(l_Tasks);
+    }
+    else
+    {
+        for (PathGenerator* l_Path : l_Requests)
+            l_Path->ExecutePathRequest();
+    }
+
+    for (PathGenerator* l_Path : l_Requests)
+    {
+        l_Path->_requestState = PATH_REQUEST_DONE;
+        l_Path->_requestMap   = NULL;
+    }
+}
+
 void Map::RemovePlayerFromMap(Player* player, bool remove)
 {
     player->RemoveFromWorld();
@@ -2326,6 +2447,18 @@ bool Map::isInLineOfSight(float x1, float y1, float z1, float x2, float y2, floa
         && _dynamicTree.isInLineOfSight(x1, y1, z1, x2, y2, z2, phasemask);
 }
 
+void Map::isInLineOfSight(G3D::Vector3 const* p_Starts, G3D::Vector3 const* p_Ends, uint32 const* p_PhaseMasks, uint32 p_Count, bool* p_Results) const
+{
+    VMAP::VMapFactory::createOrGetVMapManager()->isInLineOfSight(GetId(), p_Starts, p_Ends, p_Count, p_Results);
+
+    /// Gameobjects are only checked for the rays not blocked by the terrain models, as the single query does
+    for (uint32 l_I = 0; l_I < p_Count; ++l_I)
+    {
+        if (p_Results[l_I])
+            p_Results[l_I] = _dynamicTree.isInLineOfSight(p_Starts[l_I].x, p_Starts[l_I].y, p_Starts[l_I].z, p_Ends[l_I].x, p_Ends[l_I].y, p_Ends[l_I].z, p_PhaseMasks[l_I]);
+    }
+}
+
 bool Map::getObjectHitPos(uint32 phasemask, float x1, float y1, float z1, float x2, float y2, float z2, float& rx, float& ry, float& rz, float modifyDist)
 {
     G3D::Vector3 startPos = G3D::Vector3(x1, y1, z1);
@@ -2617,8 +2750,10 @@ uint32 Map::GetPlayersCountExceptGMs() const
 
 void Map::SendToPlayers(WorldPacket const* data) const
 {
+    SharedWorldPacket l_Packet(*data);
+
     for (MapRefManager::const_iterator itr = m_mapRefManager.begin(); itr != m_mapRefManager.end(); ++itr)
-        itr->getSource()->GetSession()->SendPacket(data);
+        itr->getSource()->GetSession()->SendPacket(l_Packet);
 }
 
 bool Map::ActiveObjectsNearGrid(NGridType const& ngrid) const
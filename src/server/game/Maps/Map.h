@@ -23,6 +23,7 @@
 #include "Common.h"
 
 #include <bitset>
+#include <mutex>
 
 class Unit;
 class WorldPacket;
@@ -41,6 +42,7 @@ class Battleground;
 class MapInstanced;
 class InstanceMap;
 class Transport;
+class PathGenerator;
 namespace JadeCore { struct ObjectUpdater; }
 
 struct ScriptAction
@@ -263,6 +265,10 @@ class Map : public GridRefManager<NGridType>
         void VisitNearbyCellsOf(WorldObject* obj, TypeContainerVisitor<JadeCore::ObjectUpdater, GridTypeMapContainer> &gridVisitor, TypeContainerVisitor<JadeCore::ObjectUpdater, WorldTypeMapContainer> &worldVisitor);
         virtual void Update(const uint32);
 
+        /// Duration (in ms) of the last Update, used by MapUpdater to start the heaviest maps first
+        void SetLastUpdateCost(uint32 p_Cost) { m_LastUpdateCost = p_Cost; }
+        uint32 GetLastUpdateCost() const { return m_LastUpdateCost; }
+
         float GetVisibilityRange() const
         {
             ///< Hack fixes...
@@ -477,12 +483,20 @@ class Map : public GridRefManager<NGridType>
         float GetWaterOrGroundLevel(float x, float y, float z, float* ground = NULL, bool swim = false) const;
         float GetHeight(uint32 phasemask, float x, float y, float z, bool vmap = true, float maxSearchDist = DEFAULT_HEIGHT_SEARCH) const;
         bool isInLineOfSight(float x1, float y1, float z1, float x2, float y2, float z2, uint32 phasemask) const;
-        void Balance() { _dynamicTree.balance(); }
+        /// isInLineOfSight for p_Count pairs of positions, the vmap trees are traversed once for up to 16 of them
+        /// @p_Results : p_Results[i] is the line of sight between p_Starts[i] and p_Ends[i] in phase p_PhaseMasks[i]
+        void isInLineOfSight(G3D::Vector3 const* p_Starts, G3D::Vector3 const* p_Ends, uint32 const* p_PhaseMasks, uint32 p_Count, bool* p_Results) const;
         void RemoveGameObjectModel(const GameObjectModel& model) { _dynamicTree.remove(model); }
         void InsertGameObjectModel(const GameObjectModel& model) { _dynamicTree.insert(model); }
+        void RelocateGameObjectModel(const GameObjectModel& model) { _dynamicTree.relocate(model); }
         bool ContainsGameObjectModel(const GameObjectModel& model) const { return _dynamicTree.contains(model);}
+        void GetDynamicTreeStats(DynamicTreeStats& p_Stats) const { _dynamicTree.getStats(p_Stats); }
         bool getObjectHitPos(uint32 phasemask, float x1, float y1, float z1, float x2, float y2, float z2, float& rx, float &ry, float& rz, float modifyDist);
 
+        /// Asynchronous path requests, built at the beginning of the next update, see PathGenerator::CalculatePathAsync
+        void AddPathRequest(PathGenerator* p_Path);
+        void RemovePathRequest(PathGenerator* p_Path);
+
         virtual uint32 GetOwnerGuildId(uint32 /*team*/ = TEAM_OTHER) const { return 0; }
         /*
             RESPAWN TIMES
@@ -544,6 +558,13 @@ class Map : public GridRefManager<NGridType>
         bool GameObjectCellRelocation(GameObject* go, Cell new_cell);
 
         template<class T> void InitializeObject(T* obj);
+
+        /// Build the pending path requests, on the map task pool when it is enabled
+        void ProcessPathRequests();
+
+        std::mutex m_PathRequestsLock;
+        std::vector<PathGenerator*> m_PathRequests;
+
         void AddCreatureToMoveList(Creature* c, float x, float y, float z, float ang);
         void AddGameObjectToMoveList(GameObject* go, float x, float y, float z, float ang);
         void RemoveGameObjectFromMoveList(GameObject* go);
@@ -557,6 +578,8 @@ class Map : public GridRefManager<NGridType>
         bool IsGridLoaded(const GridCoord &) const;
         void EnsureGridCreated(const GridCoord &);
         bool EnsureGridLoaded(Cell const&);
+        /// Ask the grid prefetcher for the grid the player will be in soon
+        void PrefetchGridAhead(Player* p_Player);
         void EnsureGridLoadedForActiveObject(Cell const&, WorldObject* object);
 
         void buildNGridLinkage(NGridType* pNGridType) { pNGridType->link(this); }
@@ -590,6 +613,7 @@ class Map : public GridRefManager<NGridType>
         MapRefManager::iterator m_mapRefIter;
 
         int32 m_VisibilityNotifyPeriod;
+        uint32 m_LastUpdateCost;
 
         typedef std::set<WorldObject*> ActiveNonPlayers;
         ActiveNonPlayers m_activeNonPlayers;
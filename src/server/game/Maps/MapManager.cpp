@@ -52,6 +52,16 @@ void MapManager::Initialize()
     // Start mtmaps if needed.
     if (num_threads > 0)
         m_updater.activate(num_threads);
+
+    /// Start path request threads if needed
+    int l_PathThreads(sWorld->getIntConfig(CONFIG_MMAP_ASYNC_PATH_THREADS));
+    if (l_PathThreads > 0)
+        m_PathRequestUpdater.activate(l_PathThreads);
+
+    /// Start grid prefetch threads if needed
+    int l_PrefetchThreads(sWorld->getIntConfig(CONFIG_GRID_PREFETCH_THREADS));
+    if (l_PrefetchThreads > 0)
+        m_GridPrefetcher.activate(l_PrefetchThreads);
 }
 
 void MapManager::InitializeVisibilityDistanceInfo()
@@ -377,6 +387,12 @@ void MapManager::UnloadAll()
     if (m_updater.activated())
         m_updater.deactivate();
 
+    if (m_PathRequestUpdater.activated())
+        m_PathRequestUpdater.deactivate();
+
+    if (m_GridPrefetcher.activated())
+        m_GridPrefetcher.deactivate();
+
     Map::DeleteStateMachine();
 }
 
@@ -14,6 +14,8 @@
 #include "Map.h"
 #include "GridStates.h"
 #include "MapUpdater.h"
+#include "PathRequestUpdater.h"
+#include "GridPrefetcher.h"
 
 class Transport;
 struct TransportCreatureProto;
@@ -136,6 +138,8 @@ class MapManager
         void SetNextInstanceId(uint32 nextInstanceId) { m_NextInstanceID = nextInstanceId; };
 
         MapUpdater * GetMapUpdater() { return &m_updater; }
+        PathRequestUpdater* GetPathRequestUpdater() { return &m_PathRequestUpdater; }
+        GridPrefetcher* GetGridPrefetcher() { return &m_GridPrefetcher; }
 
         void AddCriticalOperation(std::function<bool()> const&& p_Function)
         {
@@ -183,6 +187,8 @@ class MapManager
         InstanceIDs m_InstanceIDs;
         uint32 m_NextInstanceID;
         MapUpdater m_updater;
+        PathRequestUpdater m_PathRequestUpdater;
+        GridPrefetcher m_GridPrefetcher;
         bool m_mapDiffLimit;
 
         std::queue<std::function<bool()>> m_CriticalOperation;
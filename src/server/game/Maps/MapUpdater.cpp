@@ -11,6 +11,7 @@
 #include "Common.h"
 #include "MapUpdater.h"
 #include "Map.h"
+#include "Timer.h"
 
 /// Constructor
 MapUpdaterTask::MapUpdaterTask(MapUpdater* p_Updater)
@@ -48,16 +49,27 @@ class MapUpdateRequest : MapUpdaterTask
 
         void call() override
         {
+            uint32 l_StartTime = getMSTime();
+
             m_map.Update (m_diff);
+            m_map.SetLastUpdateCost(GetMSTimeDiffToNow(l_StartTime));
+
             UpdateFinished();
         }
+
+        uint32 GetCost() const override
+        {
+            return m_map.GetLastUpdateCost();
+        }
 };
 
 void MapUpdater::activate(size_t num_threads)
 {
+    _queue.Resize(num_threads);
+
     for (size_t i = 0; i < num_threads; ++i)
     {
-        _workerThreads.push_back(std::thread(&MapUpdater::WorkerThread, this));
+        _workerThreads.push_back(std::thread(&MapUpdater::WorkerThread, this, i));
     }
 }
 
@@ -79,7 +91,7 @@ void MapUpdater::wait()
 {
     std::unique_lock<std::mutex> lock(_lock);
 
-    while (pending_requests > 0)
+    while (_pendingRequests.load() > 0)
         _condition.wait(lock);
 
     lock.unlock();
@@ -87,20 +99,17 @@ void MapUpdater::wait()
 
 void MapUpdater::schedule_update(Map& map, uint32 diff)
 {
-    std::lock_guard<std::mutex> lock(_lock);
-
-    ++pending_requests;
+    ++_pendingRequests;
 
-    _queue.Push((MapUpdaterTask*)new MapUpdateRequest(map, *this, diff));
+    MapUpdaterTask* l_Request = (MapUpdaterTask*)new MapUpdateRequest(map, *this, diff);
+    _queue.Push(l_Request, l_Request->GetCost());
 }
 
 void MapUpdater::schedule_specific(MapUpdaterTask* p_Request)
 {
-    std::lock_guard<std::mutex> lock(_lock);
-
-    ++pending_requests;
+    ++_pendingRequests;
 
-    _queue.Push(p_Request);
+    _queue.Push(p_Request, p_Request->GetCost());
 }
 
 bool MapUpdater::activated()
@@ -110,23 +119,29 @@ bool MapUpdater::activated()
 
 void MapUpdater::update_finished()
 {
-    std::lock_guard<std::mutex> lock(_lock);
+    /// Only the last finished task has to wake up the waiting thread
+    if (--_pendingRequests > 0)
+        return;
 
-    --pending_requests;
+    std::lock_guard<std::mutex> lock(_lock);
 
     _condition.notify_all();
 }
 
-void MapUpdater::WorkerThread()
+void MapUpdater::WorkerThread(size_t p_WorkerID)
 {
     while (1)
     {
         MapUpdaterTask* request = nullptr;
 
-        _queue.WaitAndPop(request);
+        if (!_queue.WaitAndPop(p_WorkerID, request))
+            return;
 
         if (_cancelationToken)
+        {
+            delete request;
             return;
+        }
 
         request->call();
 
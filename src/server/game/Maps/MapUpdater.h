@@ -12,7 +12,7 @@
 #include "Define.h"
 #include "Common.h"
 #include <condition_variable>
-#include "ProducerConsumerQueue.h"
+#include "WorkStealingQueue.h"
 
 class MapUpdater;
 
@@ -21,9 +21,13 @@ class MapUpdaterTask
     public:
         /// Constructor
         MapUpdaterTask(MapUpdater* p_Updater);
+        virtual ~MapUpdaterTask() { }
 
         virtual void call() = 0;
 
+        /// Estimated cost (in ms) of the task, heaviest tasks are started first
+        virtual uint32 GetCost() const { return 0; }
+
         /// Notify that the task is done
         void UpdateFinished();
 
@@ -38,7 +42,7 @@ class MapUpdater
 {
     public:
 
-        MapUpdater() : _cancelationToken(false), pending_requests(0) {}
+        MapUpdater() : _cancelationToken(false), _pendingRequests(0) {}
         ~MapUpdater() { };
 
         friend class MapUpdaterTask;
@@ -56,18 +60,19 @@ class MapUpdater
 
     private:
 
-        ProducerConsumerQueue<MapUpdaterTask*> _queue;
+        WorkStealingQueue<MapUpdaterTask*> _queue;
 
         std::vector<std::thread> _workerThreads;
         std::atomic<bool> _cancelationToken;
 
+        /// Only used to sleep in wait(), the counter itself is lock-free
         std::mutex _lock;
         std::condition_variable _condition;
-        size_t pending_requests;
+        std::atomic<size_t> _pendingRequests;
 
         void update_finished();
 
-        void WorkerThread();
+        void WorkerThread(size_t p_WorkerID);
 };
 
 #endif //_MAP_UPDATER_H_INCLUDED
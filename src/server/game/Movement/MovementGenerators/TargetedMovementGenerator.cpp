@@ -155,8 +155,22 @@ void TargetedMovementGeneratorMedium<T, D>::_setTargetLocation(T* owner, bool up
     bool forceDest = (owner->GetTypeId() == TYPEID_UNIT && owner->ToCreature()->isPet()
         && owner->HasUnitState(UNIT_STATE_FOLLOW));
 
-    bool result = i_path->CalculatePath(x, y, z, forceDest);
-    if (!result || (i_path->GetPathType() & PATHFIND_NOPATH))
+    /// The path is built during the next map update, see _launchPath call in DoUpdate
+    if (owner->GetTypeId() == TYPEID_UNIT && sWorld->getBoolConfig(CONFIG_MMAP_ASYNC_PATHS))
+    {
+        if (!i_path->CalculatePathAsync(x, y, z, forceDest))
+            i_recalculateTravel = true;
+
+        return;
+    }
+
+    _launchPath(owner, i_path->CalculatePath(x, y, z, forceDest));
+}
+
+template<class T, typename D>
+void TargetedMovementGeneratorMedium<T, D>::_launchPath(T* owner, bool pathResult)
+{
+    if (!pathResult || (i_path->GetPathType() & PATHFIND_NOPATH))
     {
         // Cant reach target
         i_recalculateTravel = true;
@@ -250,7 +264,12 @@ bool TargetedMovementGeneratorMedium<T, D>::DoUpdate(T* owner, uint32 time_diff)
             targetMoved = !i_target->IsWithinLOSInMap(owner);
     }
 
-    if (i_recalculateTravel || targetMoved)
+    if (i_path && i_path->GetPathRequestState() == PATH_REQUEST_DONE)
+        _launchPath(owner, i_path->TakePathRequestResult());
+
+    // a pending request already has the latest destination, only a target move must update it
+    bool pathPending = i_path && i_path->GetPathRequestState() == PATH_REQUEST_PENDING;
+    if (targetMoved || (i_recalculateTravel && !pathPending))
         _setTargetLocation(owner, targetMoved);
 
     if (owner->movespline->Finalized())
@@ -392,6 +411,10 @@ template void TargetedMovementGeneratorMedium<Player, ChaseMovementGenerator<Pla
 template void TargetedMovementGeneratorMedium<Player, FollowMovementGenerator<Player> >::_setTargetLocation(Player*, bool);
 template void TargetedMovementGeneratorMedium<Creature, ChaseMovementGenerator<Creature> >::_setTargetLocation(Creature*, bool);
 template void TargetedMovementGeneratorMedium<Creature, FollowMovementGenerator<Creature> >::_setTargetLocation(Creature*, bool);
+template void TargetedMovementGeneratorMedium<Player, ChaseMovementGenerator<Player> >::_launchPath(Player*, bool);
+template void TargetedMovementGeneratorMedium<Player, FollowMovementGenerator<Player> >::_launchPath(Player*, bool);
+template void TargetedMovementGeneratorMedium<Creature, ChaseMovementGenerator<Creature> >::_launchPath(Creature*, bool);
+template void TargetedMovementGeneratorMedium<Creature, FollowMovementGenerator<Creature> >::_launchPath(Creature*, bool);
 template bool TargetedMovementGeneratorMedium<Player, ChaseMovementGenerator<Player> >::DoUpdate(Player*, uint32);
 template bool TargetedMovementGeneratorMedium<Player, FollowMovementGenerator<Player> >::DoUpdate(Player*, uint32);
 template bool TargetedMovementGeneratorMedium<Creature, ChaseMovementGenerator<Creature> >::DoUpdate(Creature*, uint32);
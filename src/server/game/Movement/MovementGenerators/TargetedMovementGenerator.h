@@ -44,6 +44,7 @@ class TargetedMovementGeneratorMedium : public MovementGeneratorMedium< T, D >,
         bool IsReachable() const { return (i_path) ? (i_path->GetPathType() & PATHFIND_NORMAL) : true; }
     protected:
         void _setTargetLocation(T* owner, bool updateDestination);
+        void _launchPath(T* owner, bool pathResult);
 
         PathGenerator* i_path;
         TimeTrackerSmall i_recheckDistance;
@@ -21,7 +21,8 @@ PathGenerator::PathGenerator(const Unit* owner) :
     _polyLength(0), _type(PATHFIND_BLANK), _useStraightPath(false),
     _forceDestination(false), _pointPathLimit(MAX_POINT_PATH_LENGTH), _straightLine(false),
     _endPosition(G3D::Vector3::zero()), _sourceUnit(owner), _navMesh(NULL),
-    _navMeshQuery(NULL)
+    _navMeshQuery(NULL), _requestState(PATH_REQUEST_NONE), _requestMap(NULL), _requestDestination(G3D::Vector3::zero()),
+    _requestForceDest(false), _requestStraightLine(false), _requestResult(false)
 {
     memset(_pathPolyRefs, 0, sizeof(_pathPolyRefs));
 
@@ -34,7 +35,6 @@ PathGenerator::PathGenerator(const Unit* owner) :
 
         MMAP::MMapManager* mmap = MMAP::MMapFactory::createOrGetMMapManager();
         _navMesh = mmap->GetNavMesh(mapId, l_TerrainSwaps);
-        _navMeshQuery = mmap->GetNavMeshQuery(mapId, _sourceUnit->GetInstanceId(), l_TerrainSwaps);
     }
 
     CreateFilter();
@@ -43,6 +43,8 @@ PathGenerator::PathGenerator(const Unit* owner) :
 PathGenerator::~PathGenerator()
 {
     //sLog->outDebug(LOG_FILTER_MAPS, "++ PathGenerator::~PathGenerator() for %llu", _sourceUnit->GetGUID());
+
+    CancelPathRequest();
 }
 
 bool PathGenerator::CalculatePath(float destX, float destY, float destZ, bool forceDest, bool straightLine)
@@ -66,7 +68,7 @@ bool PathGenerator::CalculatePath(float destX, float destY, float destZ, bool fo
 
     // make sure navMesh works - we can run on map w/o mmap
     // check if the start and end point have a .mmtile loaded (can we pass via not loaded tile on the way?)
-    if (!_navMesh || !_navMeshQuery || _sourceUnit->HasUnitState(UNIT_STATE_IGNORE_PATHFINDING) || (_sourceUnit->GetTypeId() == TYPEID_UNIT && _sourceUnit->ToCreature()->GetCreatureTemplate()->flags_extra & CREATURE_FLAG_EXTRA_IGNORE_PATHFINDING) ||
+    if (!_navMesh || _sourceUnit->HasUnitState(UNIT_STATE_IGNORE_PATHFINDING) || (_sourceUnit->GetTypeId() == TYPEID_UNIT && _sourceUnit->ToCreature()->GetCreatureTemplate()->flags_extra & CREATURE_FLAG_EXTRA_IGNORE_PATHFINDING) ||
         !HaveTile(start) || !HaveTile(dest))
     {
         BuildShortcut();
@@ -74,12 +76,76 @@ bool PathGenerator::CalculatePath(float destX, float destY, float destZ, bool fo
         return true;
     }
 
+    /// The query is only owned for this calculation, paths of the same map can be built by several threads at once
+    MMAP::NavMeshQueryHolder l_Query(MMAP::MMapFactory::createOrGetMMapManager(), _sourceUnit->GetMapId());
+    if (!l_Query.GetQuery())
+    {
+        BuildShortcut();
+        _type = PathType(PATHFIND_NORMAL | PATHFIND_NOT_USING_PATH);
+        return true;
+    }
+
+    _navMeshQuery = l_Query.GetQuery();
+
     UpdateFilter();
 
     BuildPolyPath(start, dest);
+
+    _navMeshQuery = NULL;
     return true;
 }
 
+bool PathGenerator::CalculatePathAsync(float destX, float destY, float destZ, bool forceDest, bool straightLine)
+{
+    if (!JadeCore::IsValidMapCoord(destX, destY, destZ) || !JadeCore::IsValidMapCoord(_sourceUnit->GetPositionX(), _sourceUnit->GetPositionY(), _sourceUnit->GetPositionZ()))
+        return false;
+
+    Map* l_Map = _sourceUnit->FindMap();
+    if (!l_Map)
+        return false;
+
+    _requestDestination  = G3D::Vector3(destX, destY, destZ);
+    _requestForceDest    = forceDest;
+    _requestStraightLine = straightLine;
+
+    if (_requestState == PATH_REQUEST_PENDING && _requestMap == l_Map)
+        return true;
+
+    CancelPathRequest();
+
+    _requestState = PATH_REQUEST_PENDING;
+    _requestMap   = l_Map;
+    l_Map->AddPathRequest(this);
+    return true;
+}
+
+void PathGenerator::CancelPathRequest()
+{
+    if (_requestState == PATH_REQUEST_PENDING && _requestMap)
+        _requestMap->RemovePathRequest(this);
+
+    _requestState = PATH_REQUEST_NONE;
+    _requestMap   = NULL;
+}
+
+bool PathGenerator::TakePathRequestResult()
+{
+    _requestState = PATH_REQUEST_NONE;
+    return _requestResult;
+}
+
+/// Called by the request map while it is not updated, the owner can be read but not modified
+void PathGenerator::ExecutePathRequest()
+{
+    if (!_sourceUnit->IsInWorld() || _sourceUnit->FindMap() != _requestMap)
+    {
+        _requestResult = false;
+        return;
+    }
+
+    _requestResult = CalculatePath(_requestDestination.x, _requestDestination.y, _requestDestination.z, _requestForceDest, _requestStraightLine);
+}
+
 dtPolyRef PathGenerator::GetPathPolyByPosition(dtPolyRef const* polyPath, uint32 polyPathSize, float const* point, float* distance) const
 {
     if (!polyPath || !polyPathSize)
@@ -15,6 +15,7 @@
 #include "MoveSplineInitArgs.h"
 
 class Unit;
+class Map;
 
 // 74*4.0f=296y  number_of_points*interval = max_path_len
 // this is way more than actual evade range
@@ -39,8 +40,17 @@ enum PathType
     PATHFIND_SHORT          = 0x20    // path is longer or equal to its limited path length
 };
 
+enum PathRequestState
+{
+    PATH_REQUEST_NONE       = 0,    // no asynchronous request
+    PATH_REQUEST_PENDING    = 1,    // queued on the map, the path must not be read
+    PATH_REQUEST_DONE       = 2     // path built, see TakePathRequestResult
+};
+
 class PathGenerator
 {
+    friend class Map;
+
     public:
         explicit PathGenerator(Unit const* owner);
         ~PathGenerator();
@@ -49,6 +59,16 @@ class PathGenerator
         // return: true if new path was calculated, false otherwise (no change needed)
         bool CalculatePath(float destX, float destY, float destZ, bool forceDest = false, bool straightLine = false);
 
+        /// Queue the path calculation on the owner map, the path is built at the beginning of the next map update,
+        /// possibly on another thread. Calling it again while the request is pending only updates the destination
+        /// Return false if the path can't be requested
+        bool CalculatePathAsync(float destX, float destY, float destZ, bool forceDest = false, bool straightLine = false);
+        void CancelPathRequest();
+
+        PathRequestState GetPathRequestState() const { return _requestState; }
+        /// Acknowledge a done request, return what CalculatePath would have returned
+        bool TakePathRequestResult();
+
         // option setters - use optional
         void SetUseStraightPath(bool useStraightPath) { _useStraightPath = useStraightPath; }
         void SetPathLengthLimit(float distance) { _pointPathLimit = std::min<uint32>(uint32(distance/SMOOTH_PATH_STEP_SIZE), MAX_POINT_PATH_LENGTH); }
@@ -87,6 +107,15 @@ class PathGenerator
 
         dtQueryFilter _filter;  // use single filter for all movements, update it when needed
 
+        PathRequestState _requestState;
+        Map* _requestMap;                   // map the request is queued on
+        G3D::Vector3 _requestDestination;
+        bool _requestForceDest;
+        bool _requestStraightLine;
+        bool _requestResult;
+
+        void ExecutePathRequest();
+
         void SetStartPosition(G3D::Vector3 const& point) { _startPosition = point; }
         void SetEndPosition(G3D::Vector3 const& point) { _actualEndPosition = point; _endPosition = point; }
         void SetActualEndPosition(G3D::Vector3 const& point) { _actualEndPosition = point; }
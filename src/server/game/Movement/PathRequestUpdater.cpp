@@ -0,0 +1,92 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+//  MILLENIUM-STUDIO
+//  Copyright 2016 Millenium-studio SARL
+//  All Rights Reserved.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+#include "PathRequestUpdater.h"
+
+bool PathRequestUpdater::Batch::RunNext()
+{
+    size_t l_Index = NextTask.fetch_add(1);
+    if (l_Index >= TaskCount)
+        return false;
+
+    Functions[l_Index]();
+
+    std::lock_guard<std::mutex> l_Lock(Lock);
+
+    if (++DoneTasks == TaskCount)
+        Condition.notify_all();
+
+    return true;
+}
+
+void PathRequestUpdater::activate(size_t num_threads)
+{
+    _queue.Resize(num_threads);
+
+    for (size_t i = 0; i < num_threads; ++i)
+        _workerThreads.push_back(std::thread(&PathRequestUpdater::WorkerThread, this, i));
+
+    _workerCount = num_threads;
+}
+
+void PathRequestUpdater::deactivate()
+{
+    _cancelationToken = true;
+    _workerCount      = 0;
+
+    /// Queued tickets are dropped, their callers run the tasks left themselves
+    _queue.Cancel();
+
+    for (auto& l_Thread : _workerThreads)
+        l_Thread.join();
+
+    _workerThreads.clear();
+}
+
+bool PathRequestUpdater::activated()
+{
+    return _workerCount.load() > 0 && !_cancelationToken;
+}
+
+void PathRequestUpdater::Run(Tasks const& p_Tasks)
+{
+    if (p_Tasks.empty())
+        return;
+
+    BatchPtr l_Batch = std::make_shared<Batch>(p_Tasks);
+
+    /// One ticket per worker able to help, the calling thread takes the first task itself
+    if (activated())
+    {
+        size_t l_Tickets = std::min(p_Tasks.size() - 1, _workerCount.load());
+        for (size_t l_I = 0; l_I < l_Tickets; ++l_I)
+            _queue.Push(l_Batch, uint32(p_Tasks.size()));
+    }
+
+    while (l_Batch->RunNext())
+        ;
+
+    /// Only the tasks already claimed by workers are left
+    std::unique_lock<std::mutex> l_Lock(l_Batch->Lock);
+
+    while (l_Batch->DoneTasks < p_Tasks.size())
+        l_Batch->Condition.wait(l_Lock);
+}
+
+void PathRequestUpdater::WorkerThread(size_t p_WorkerID)
+{
+    BatchPtr l_Batch;
+
+    while (_queue.WaitAndPop(p_WorkerID, l_Batch))
+    {
+        while (l_Batch->RunNext())
+            ;
+
+        l_Batch.reset();
+    }
+}
@@ -0,0 +1,64 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+//  MILLENIUM-STUDIO
+//  Copyright 2016 Millenium-studio SARL
+//  All Rights Reserved.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef _PATH_REQUEST_UPDATER_H_INCLUDED
+#define _PATH_REQUEST_UPDATER_H_INCLUDED
+
+#include "Define.h"
+#include "Common.h"
+#include <condition_variable>
+#include <functional>
+#include "WorkStealingQueue.h"
+
+/// Thread pool building the pending path requests of a map in parallel, see Map::ProcessPathRequests
+/// Shared by all maps, the thread calling Run takes part in its own batch and never runs the tasks of another map
+class PathRequestUpdater
+{
+    public:
+        typedef std::vector<std::function<void()>> Tasks;
+
+        PathRequestUpdater() : _workerCount(0), _cancelationToken(false) { }
+        ~PathRequestUpdater() { }
+
+        void activate(size_t num_threads);
+        void deactivate();
+        bool activated();
+
+        /// Execute all tasks and return once they are all done
+        /// The calling thread runs the tasks no worker took, a canceled pool never leaves it waiting
+        /// @p_Tasks : They must not share any state
+        void Run(Tasks const& p_Tasks);
+
+    private:
+        struct Batch
+        {
+            Batch(Tasks const& p_Tasks) : Functions(p_Tasks), TaskCount(p_Tasks.size()), NextTask(0), DoneTasks(0) { }
+
+            /// Claim and run the next task of the batch, return false once they are all claimed
+            bool RunNext();
+
+            Tasks const&            Functions;      ///< Only read for a claimed task, Run doesn't return before it is done
+            size_t const            TaskCount;
+            std::atomic<size_t>     NextTask;
+            size_t                  DoneTasks;      ///< Protected by Lock
+            std::mutex              Lock;
+            std::condition_variable Condition;
+        };
+
+        typedef std::shared_ptr<Batch> BatchPtr;   ///< Queued batches may outlive Run, they are just found empty
+
+        void WorkerThread(size_t p_WorkerID);
+
+        WorkStealingQueue<BatchPtr> _queue;
+
+        std::vector<std::thread> _workerThreads;
+        std::atomic<size_t> _workerCount;          ///< Read by Run, _workerThreads only by activate and deactivate
+        std::atomic<bool> _cancelationToken;
+};
+
+#endif //_PATH_REQUEST_UPDATER_H_INCLUDED
@@ -1417,11 +1417,17 @@ void ScriptMgr::OnPacketReceive(WorldSocket* p_Socket, WorldPacket p_Packet, Wor
 /// Called when a (valid) packet is received by a client. The packet object is a copy of the original packet, so reading and modifying it is safe.
 /// @p_Socket : Socket who received the packet
 /// @p_Packet : Received packet
-void ScriptMgr::OnPacketSend(WorldSocket* p_Socket, WorldPacket p_Packet)
+void ScriptMgr::OnPacketSend(WorldSocket* p_Socket, WorldPacket const& p_Packet)
 {
     ASSERT(p_Socket);
 
-    FOREACH_SCRIPT(ServerScript)->OnPacketSend(p_Socket, p_Packet);
+    /// Only copy the packet when a script will see it, every packet sent goes through here
+    if (SCR_REG_LST(ServerScript).empty())
+        return;
+
+    WorldPacket l_Packet(p_Packet);
+
+    FOREACH_SCRIPT(ServerScript)->OnPacketSend(p_Socket, l_Packet);
 }
 
 /// Called when an invalid (unknown opcode) packet is received by a client. The packet is a reference to the original packet; not a copy.
@@ -10,7 +10,7 @@ class InterRealmDatabaseConnection : public CharacterDatabaseConnection
 public:
     //- Constructors for sync and async connections
     InterRealmDatabaseConnection(MySQLConnectionInfo& connInfo) : CharacterDatabaseConnection(connInfo) {}
-    InterRealmDatabaseConnection(ACE_Activation_Queue* q, MySQLConnectionInfo& connInfo) : CharacterDatabaseConnection(q, connInfo) {}
+    InterRealmDatabaseConnection(SQLOperationQueue* q, MySQLConnectionInfo& connInfo) : CharacterDatabaseConnection(q, connInfo) {}
 };
 typedef DatabaseWorkerPool<InterRealmDatabaseConnection> InterRealmDatabasePool;
 
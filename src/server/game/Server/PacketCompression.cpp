@@ -0,0 +1,53 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+//  MILLENIUM-STUDIO
+//  Copyright 2016 Millenium-studio SARL
+//  All Rights Reserved.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+#include <zlib.h>
+#include "PacketCompression.h"
+#include "World.h"
+
+int PacketCompression::SelectLevel(uint32 p_Size) const
+{
+    uint32 l_FastLevelSize = sWorld->getIntConfig(CONFIG_COMPRESSION_FAST_LEVEL_SIZE);
+    uint32 l_FastLevelDiff = sWorld->getIntConfig(CONFIG_COMPRESSION_FAST_LEVEL_DIFF);
+
+    if (l_FastLevelSize && p_Size > l_FastLevelSize)
+        return Z_BEST_SPEED;
+
+    if (l_FastLevelDiff && sWorld->GetUpdateTime() > l_FastLevelDiff)
+        return Z_BEST_SPEED;
+
+    return sWorld->getIntConfig(CONFIG_COMPRESSION);
+}
+
+void PacketCompression::AddStats(uint16 p_Opcode, uint32 p_RawSize, uint32 p_CompressedSize, uint64 p_CpuMicroseconds)
+{
+    std::lock_guard<std::mutex> l_Lock(m_StatsLock);
+
+    PacketCompressionStats& l_Stats = m_Stats[p_Opcode];
+    l_Stats.Count++;
+    l_Stats.RawBytes        += p_RawSize;
+    l_Stats.CompressedBytes += p_CompressedSize;
+    l_Stats.CpuMicroseconds += p_CpuMicroseconds;
+}
+
+std::vector<std::pair<uint16, PacketCompressionStats>> PacketCompression::GetStats() const
+{
+    std::vector<std::pair<uint16, PacketCompressionStats>> l_Result;
+
+    {
+        std::lock_guard<std::mutex> l_Lock(m_StatsLock);
+        l_Result.assign(m_Stats.begin(), m_Stats.end());
+    }
+
+    std::sort(l_Result.begin(), l_Result.end(), [](std::pair<uint16, PacketCompressionStats> const& p_Left, std::pair<uint16, PacketCompressionStats> const& p_Right) -> bool
+    {
+        return p_Left.second.CpuMicroseconds > p_Right.second.CpuMicroseconds;
+    });
+
+    return l_Result;
+}
@@ -0,0 +1,55 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+//  MILLENIUM-STUDIO
+//  Copyright 2016 Millenium-studio SARL
+//  All Rights Reserved.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef PACKET_COMPRESSION_H
+#define PACKET_COMPRESSION_H
+
+#include "Common.h"
+#include <ace/Singleton.h>
+
+struct PacketCompressionStats
+{
+    PacketCompressionStats() : Count(0), RawBytes(0), CompressedBytes(0), CpuMicroseconds(0) { }
+
+    uint64 Count;
+    uint64 RawBytes;
+    uint64 CompressedBytes;
+    uint64 CpuMicroseconds;
+};
+
+/// Compression level policy and per opcode compression counters
+class PacketCompression
+{
+    friend class ACE_Singleton<PacketCompression, ACE_Thread_Mutex>;
+
+    private:
+        PacketCompression() { }
+        ~PacketCompression() { }
+
+    public:
+        /// Deflate level to use for a packet
+        /// Big packets and packets compressed while the world update is late use the fastest level
+        /// @p_Size : Uncompressed size of the packet
+        int SelectLevel(uint32 p_Size) const;
+
+        /// @p_Opcode          : Uncompressed opcode
+        /// @p_RawSize         : Size before compression
+        /// @p_CompressedSize  : Size after compression
+        /// @p_CpuMicroseconds : Time spent in deflate
+        void AddStats(uint16 p_Opcode, uint32 p_RawSize, uint32 p_CompressedSize, uint64 p_CpuMicroseconds);
+
+        /// Copy of the counters, sorted by CPU time spent
+        std::vector<std::pair<uint16, PacketCompressionStats>> GetStats() const;
+
+    private:
+        mutable std::mutex m_StatsLock;
+        std::map<uint16, PacketCompressionStats> m_Stats;
+};
+
+#define sPacketCompression ACE_Singleton<PacketCompression, ACE_Thread_Mutex>::instance()
+#endif
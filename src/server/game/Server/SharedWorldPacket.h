@@ -0,0 +1,72 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+//  MILLENIUM-STUDIO
+//  Copyright 2016 Millenium-studio SARL
+//  All Rights Reserved.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef SHARED_WORLDPACKET_H
+#define SHARED_WORLDPACKET_H
+
+#include <ace/Message_Block.h>
+#include <ace/Lock_Adapter_T.h>
+#include <ace/Thread_Mutex.h>
+#include "WorldPacket.h"
+
+extern std::atomic<uint64> gSentPayloadBytes;   ///< Payload bytes sent to all sockets
+extern std::atomic<uint64> gSentCopiedBytes;    ///< Payload bytes copied to build the socket output
+
+/// Packet sent to many sessions (broadcasts, chat, grid messages)
+/// The payload is copied once in a reference counted, immutable ACE_Data_Block
+/// and every recipient socket queues a reference to it, only the header is written per socket
+/// The source packet must outlive the broadcast, the payload block itself may live longer in socket queues
+class SharedWorldPacket
+{
+    public:
+        explicit SharedWorldPacket(WorldPacket const& p_Packet)
+            : m_Packet(p_Packet), m_Payload(nullptr)
+        {
+        }
+
+        ~SharedWorldPacket()
+        {
+            if (m_Payload != nullptr)
+                m_Payload->release();
+        }
+
+        WorldPacket const& GetPacket() const { return m_Packet; }
+
+        /// Return a new reference to the payload, built on first call
+        /// Not thread safe, a shared packet is only used by the thread doing the broadcast
+        ACE_Message_Block* DuplicatePayload() const
+        {
+            if (m_Payload == nullptr)
+            {
+                /// Payload references are released by the network threads, the reference count must be locked
+                m_Payload = new ACE_Message_Block(m_Packet.size(), ACE_Message_Block::MB_DATA, nullptr, nullptr, nullptr, GetPayloadLock());
+
+                if (!m_Packet.empty())
+                    m_Payload->copy((char const*)m_Packet.contents(), m_Packet.size());
+
+                gSentCopiedBytes += m_Packet.size();
+            }
+
+            return m_Payload->duplicate();
+        }
+
+    private:
+        static ACE_Lock* GetPayloadLock()
+        {
+            static ACE_Lock_Adapter<ACE_Thread_Mutex> s_Lock;
+            return &s_Lock;
+        }
+
+        SharedWorldPacket(SharedWorldPacket const&) = delete;
+        SharedWorldPacket& operator=(SharedWorldPacket const&) = delete;
+
+        WorldPacket const& m_Packet;
+        mutable ACE_Message_Block* m_Payload;
+};
+
+#endif
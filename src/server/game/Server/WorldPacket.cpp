@@ -39,8 +39,6 @@ void WorldPacket::Compress(z_stream* compressionStream)
     *this << uint32(size);
     append(&storage[0], destsize);
     SetOpcode(opcode);
-
-    sLog->outInfo(LOG_FILTER_NETWORKIO, "Successfully compressed opcode %u (len %u) to %u (len %u)", uncompressedOpcode, size, opcode, destsize);
 }
 
 //! Compresses another packet and stores it in self (source left intact)
@@ -71,8 +69,6 @@ void WorldPacket::Compress(z_stream* compressionStream, WorldPacket const* sourc
     resize(destsize + sizeof(uint32));
 
     SetOpcode(opcode);
-
-    sLog->outInfo(LOG_FILTER_NETWORKIO, "Successfully compressed opcode %u (len %u) to %u (len %u)", uncompressedOpcode, size, opcode, destsize);
 }
 
 void WorldPacket::Compress(void* dst, uint32 *dst_size, const void* src, int src_size)
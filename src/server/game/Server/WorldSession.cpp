@@ -25,6 +25,7 @@
 #include "Log.h"
 #include "Opcodes.h"
 #include "WorldPacket.h"
+#include "SharedWorldPacket.h"
 #include "WorldSession.h"
 #include "Player.h"
 #include "Vehicle.h"
@@ -306,31 +307,31 @@ uint32 WorldSession::GetGuidLow() const
     return GetPlayer() ? GetPlayer()->GetGUIDLow() : 0;
 }
 
-/// Send a packet to the client
-void WorldSession::SendPacket(WorldPacket const* packet, bool forced /*= false*/, bool ir_packet /*=false*/)
+/// Check if a packet can be sent to the client
+bool WorldSession::CanSendPacket(WorldPacket const* packet, bool forced, bool ir_packet)
 {
 #ifndef CROSS
     if (!m_Socket)
-        return;
+        return false;
 
     if (!ir_packet && GetInterRealmBG() && !CanBeSentDuringInterRealm(packet->GetOpcode()))
-        return;
+        return false;
 
     const_cast<WorldPacket*>(packet)->OnSend();
 
     if (packet->GetOpcode() == NULL_OPCODE && !forced)
     {
         sLog->outError(LOG_FILTER_OPCODES, "Prevented sending of NULL_OPCODE to %s", GetPlayerName(false).c_str());
-        return;
+        return false;
     }
     else if (packet->GetOpcode() == UNKNOWN_OPCODE && !forced)
     {
         sLog->outError(LOG_FILTER_OPCODES, "Prevented sending of UNKNOWN_OPCODE to %s", GetPlayerName(false).c_str());
-        return;
+        return false;
     }
 #else /* CROSS */
     if (!m_ir_socket || !m_Player || m_ir_closing)
-        return;
+        return false;
 #endif
 
     if (!forced)
@@ -339,10 +340,19 @@ void WorldSession::SendPacket(WorldPacket const* packet, bool forced /*= false*/
         if (!handler || handler->status == STATUS_UNHANDLED)
         {
             sLog->outError(LOG_FILTER_OPCODES, "Prevented sending disabled opcode %s to %s", GetOpcodeNameForLogging(packet->GetOpcode(), WOW_SERVER_TO_CLIENT).c_str(), GetPlayerName(false).c_str());
-            return;
+            return false;
         }
     }
 
+    return true;
+}
+
+/// Send a packet to the client
+void WorldSession::SendPacket(WorldPacket const* packet, bool forced /*= false*/, bool ir_packet /*=false*/)
+{
+    if (!CanSendPacket(packet, forced, ir_packet))
+        return;
+
 #ifdef CROSS
     if (!m_isinIRBG && packet->GetOpcode() != SMSG_BATTLEFIELD_LIST && 
         packet->GetOpcode() != SMSG_BATTLEFIELD_STATUS_NONE &&
@@ -361,6 +371,20 @@ void WorldSession::SendPacket(WorldPacket const* packet, bool forced /*= false*/
 #endif
 }
 
+/// Send a packet shared between several clients, the payload is not copied for each of them
+void WorldSession::SendPacket(SharedWorldPacket const& p_Packet, bool forced /*= false*/)
+{
+#ifdef CROSS
+    SendPacket(&p_Packet.GetPacket(), forced);
+#else
+    if (!CanSendPacket(&p_Packet.GetPacket(), forced, false))
+        return;
+
+    if (m_Socket->SendPacket(p_Packet) == -1)
+        m_Socket->CloseSocket();
+#endif
+}
+
 /// Add an incoming packet to the queue
 void WorldSession::QueuePacket(WorldPacket* new_packet)
 {
@@ -533,7 +557,7 @@ bool WorldSession::Update(uint32 diff, PacketFilter& updater)
     //! and continue updating others. The re-enqueued packets will be handled in the next Update call for this session.
     uint32 processedPackets = 0;
     while (m_Socket && !m_Socket->IsClosed() &&
-            !_recvQueue.empty() && _recvQueue.peek(true) != firstDelayedPacket &&
+            !_recvQueue.empty() && _recvQueue.peek() != firstDelayedPacket &&
             _recvQueue.next(packet, updater))
     {
         const OpcodeHandler* opHandle = g_OpcodeTable[WOW_CLIENT_TO_SERVER][packet->GetOpcode()];
@@ -2243,4 +2267,13 @@ void WorldSession::RestoreSpecialChannels()
 
     m_SpecialChannelsSave.clear();
 }
+
+void WorldSession::SetInterRealmBG(uint32 p_ZoneID)
+{
+    m_InterRealmZoneId = p_ZoneID;
+
+    /// The cross realm server saves the character while it plays there
+    if (p_ZoneID && m_Player)
+        m_Player->ResetSaveFingerprints();
+}
 #endif /* not CROSS */
\ No newline at end of file
@@ -19,6 +19,7 @@
 #include "Opcodes.h"
 #include "LFGListMgr.h"
 #include "MSCallback.hpp"
+#include "Threading/MPSCQueue.h"
 #ifdef CROSS
 #include "Cross/InterRealmClient.h"
 #endif /* CROSS */
@@ -34,6 +35,7 @@ class SpellCastTargets;
 class Unit;
 class Warden;
 class WorldPacket;
+class SharedWorldPacket;
 class WorldSocket;
 struct AreaTableEntry;
 struct AuctionEntry;
@@ -442,7 +444,9 @@ class WorldSession
         void ReadMovementInfo(WorldPacket& data, MovementInfo* mi);
         static void WriteMovementInfo(WorldPacket& data, MovementInfo* mi);
 
+        bool CanSendPacket(WorldPacket const* packet, bool forced, bool ir_packet);
         void SendPacket(WorldPacket const* packet, bool forced = false, bool ir_packet = false);
+        void SendPacket(SharedWorldPacket const& p_Packet, bool forced = false);
         void SendNotification(const char *format, ...) ATTR_PRINTF(2, 3);
         void SendNotification(uint32 string_id, ...);
         void SendPetNameInvalid(uint32 error, const std::string& name, DeclinedName *declinedName);
@@ -673,7 +677,7 @@ class WorldSession
 #ifndef CROSS
         /// ============== Cross realm ========================= ///
         uint32 GetInterRealmBG() { return m_InterRealmZoneId; }
-        void SetInterRealmBG(uint32 value) { m_InterRealmZoneId = value; }
+        void SetInterRealmBG(uint32 p_ZoneID);
 
         void SetBattlegroundPortData(uint64 guid, uint32 time, uint32 queueslot, uint8 action)
         {
@@ -1630,7 +1634,7 @@ class WorldSession
         bool _filterAddonMessages;
         uint32 recruiterId;
         bool isRecruiter;
-        ACE_Based::LockedQueue<WorldPacket*, ACE_Thread_Mutex> _recvQueue;
+        ACE_Based::MPSCQueue<WorldPacket*> _recvQueue;  ///< Filled by the network threads, drained by the session updater
         time_t timeLastWhoCommand;
         time_t timeCharEnumOpcode;
         time_t m_TimeLastChannelInviteCommand;
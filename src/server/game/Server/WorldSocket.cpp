@@ -15,6 +15,7 @@
 #include <ace/os_include/sys/os_types.h>
 #include <ace/os_include/sys/os_socket.h>
 #include <ace/OS_NS_string.h>
+#include <ace/OS_NS_sys_socket.h>
 #include <ace/Reactor.h>
 #include <ace/Auto_Ptr.h>
 
@@ -24,6 +25,7 @@
 #include "Util.h"
 #include "World.h"
 #include "WorldPacket.h"
+#include "SharedWorldPacket.h"
 #include "SharedDefines.h"
 #include "ByteBuffer.h"
 #include "Opcodes.h"
@@ -40,6 +42,14 @@
 
 uint32_t gReceivedBytes = 0;
 uint32_t gSentBytes = 0;
+std::atomic<uint64> gSentPayloadBytes(0);
+std::atomic<uint64> gSentCopiedBytes(0);
+
+/// Shared payloads smaller than this are still copied in the output buffer, a queued chain costs more than the copy
+#define SHARED_PAYLOAD_MIN_SIZE 256
+
+/// Maximum number of buffers flushed by one gathered write
+#define MAX_GATHERED_BUFFERS 64
 
 #if defined(__GNUC__)
 #pragma pack(1)
@@ -148,6 +158,16 @@ const std::string& WorldSocket::GetRemoteAddress (void) const
 }
 
 int WorldSocket::SendPacket(WorldPacket const& pct)
+{
+    return SendPacket(pct, nullptr);
+}
+
+int WorldSocket::SendPacket(SharedWorldPacket const& p_Packet)
+{
+    return SendPacket(p_Packet.GetPacket(), &p_Packet);
+}
+
+int WorldSocket::SendPacket(WorldPacket const& pct, SharedWorldPacket const* p_Shared)
 {
     ACE_GUARD_RETURN (LockType, Guard, m_OutBufferLock, -1);
 
@@ -165,6 +185,7 @@ int WorldSocket::SendPacket(WorldPacket const& pct)
     const_cast<WorldPacket*>(pkt)->FlushBits();
 
     gSentBytes += pkt->size() + 3;
+    gSentPayloadBytes += pkt->size();
 
     if (sWorld->getBoolConfig(CONFIG_LOG_PACKETS))
     {
@@ -187,7 +208,9 @@ int WorldSocket::SendPacket(WorldPacket const& pct)
 
     ServerPktHeader header(!m_Crypt.IsInitialized() ? pkt->size() + 2 : pct.size(), pkt->GetOpcode(), &m_Crypt);
 
-    if (m_OutBuffer->space() >= pkt->size() + header.getHeaderLength() && msg_queue()->is_empty())
+    bool l_QueueShared = p_Shared != nullptr && pkt->size() >= SHARED_PAYLOAD_MIN_SIZE;
+
+    if (!l_QueueShared && m_OutBuffer->space() >= pkt->size() + header.getHeaderLength() && msg_queue()->is_empty())
     {
         // Put the packet on the buffer.
         if (m_OutBuffer->copy((char*)header.header, header.getHeaderLength()) == -1)
@@ -196,6 +219,25 @@ int WorldSocket::SendPacket(WorldPacket const& pct)
         if (!pkt->empty())
         if (m_OutBuffer->copy((char*)pkt->contents(), pkt->size()) == -1)
             ACE_ASSERT(false);
+
+        gSentCopiedBytes += pkt->size();
+    }
+    else if (p_Shared != nullptr)
+    {
+        // Enqueue the header only, the payload is a reference to the shared block.
+        ACE_Message_Block* mb;
+
+        ACE_NEW_RETURN(mb, ACE_Message_Block(header.getHeaderLength()), -1);
+
+        mb->copy((char*)header.header, header.getHeaderLength());
+        mb->cont(p_Shared->DuplicatePayload());
+
+        if (msg_queue()->enqueue_tail(mb, (ACE_Time_Value*)&ACE_Time_Value::zero) == -1)
+        {
+            sLog->outError(LOG_FILTER_NETWORKIO, "WorldSocket::SendPacket enqueue_tail failed");
+            mb->release();
+            return -1;
+        }
     }
     else
     {
@@ -209,6 +251,8 @@ int WorldSocket::SendPacket(WorldPacket const& pct)
         if (!pkt->empty())
             mb->copy((const char*)pkt->contents(), pkt->size());
 
+        gSentCopiedBytes += pkt->size();
+
         if (msg_queue()->enqueue_tail(mb, (ACE_Time_Value*)&ACE_Time_Value::zero) == -1)
         {
             sLog->outError(LOG_FILTER_NETWORKIO, "WorldSocket::SendPacket enqueue_tail failed");
@@ -335,15 +379,47 @@ int WorldSocket::handle_output (ACE_HANDLE)
     if (closing_)
         return -1;
 
-    size_t send_len = m_OutBuffer->length();
+    // Gather the output buffer and the queued packets in one write,
+    // shared payloads are sent from their own block without being copied.
+    iovec l_Buffers[MAX_GATHERED_BUFFERS];
+    int l_BufferCount = 0;
+    size_t send_len = 0;
+
+    if (m_OutBuffer->length() > 0)
+    {
+        l_Buffers[l_BufferCount].iov_base = m_OutBuffer->rd_ptr();
+        l_Buffers[l_BufferCount].iov_len  = m_OutBuffer->length();
+        send_len += m_OutBuffer->length();
+        ++l_BufferCount;
+    }
+
+    ACE_Message_Block* mblk = nullptr;
+    for (ACE_Message_Queue_Iterator<ACE_NULL_SYNCH> l_Itr(*msg_queue()); l_BufferCount < MAX_GATHERED_BUFFERS && l_Itr.next(mblk); l_Itr.advance())
+    {
+        for (ACE_Message_Block* l_Block = mblk; l_Block != nullptr && l_BufferCount < MAX_GATHERED_BUFFERS; l_Block = l_Block->cont())
+        {
+            if (l_Block->length() == 0)
+                continue;
+
+            l_Buffers[l_BufferCount].iov_base = l_Block->rd_ptr();
+            l_Buffers[l_BufferCount].iov_len  = l_Block->length();
+            send_len += l_Block->length();
+            ++l_BufferCount;
+        }
+    }
 
-    if (send_len == 0)
-        return handle_output_queue(Guard);
+    if (l_BufferCount == 0)
+        return cancel_wakeup_output(Guard);
 
 #ifdef MSG_NOSIGNAL
-    ssize_t n = peer().send (m_OutBuffer->rd_ptr(), send_len, MSG_NOSIGNAL);
+    msghdr l_Message;
+    memset(&l_Message, 0, sizeof(l_Message));
+    l_Message.msg_iov    = l_Buffers;
+    l_Message.msg_iovlen = l_BufferCount;
+
+    ssize_t n = ACE_OS::sendmsg(get_handle(), &l_Message, MSG_NOSIGNAL);
 #else
-    ssize_t n = peer().send (m_OutBuffer->rd_ptr(), send_len);
+    ssize_t n = peer().sendv(l_Buffers, l_BufferCount);
 #endif // MSG_NOSIGNAL
 
     if (n == 0)
@@ -355,84 +431,57 @@ int WorldSocket::handle_output (ACE_HANDLE)
 
         return -1;
     }
-    else if (n < (ssize_t)send_len) //now n > 0
-    {
-        m_OutBuffer->rd_ptr (static_cast<size_t> (n));
 
-        // move the data to the base of the buffer
-        m_OutBuffer->crunch();
+    size_t l_Remaining = static_cast<size_t>(n);
 
-        return schedule_wakeup_output (Guard);
-    }
-    else //now n == send_len
+    if (m_OutBuffer->length() > 0)
     {
-        m_OutBuffer->reset();
+        size_t l_Sent = std::min(l_Remaining, m_OutBuffer->length());
+        l_Remaining -= l_Sent;
 
-        return handle_output_queue (Guard);
-    }
+        m_OutBuffer->rd_ptr(l_Sent);
 
-    ACE_NOTREACHED (return 0);
-}
-
-int WorldSocket::handle_output_queue (GuardType& g)
-{
-    if (msg_queue()->is_empty())
-        return cancel_wakeup_output(g);
-
-    ACE_Message_Block* mblk;
-
-    if (msg_queue()->dequeue_head(mblk, (ACE_Time_Value*)&ACE_Time_Value::zero) == -1)
-    {
-        sLog->outError(LOG_FILTER_NETWORKIO, "WorldSocket::handle_output_queue dequeue_head");
-        return -1;
+        if (m_OutBuffer->length() == 0)
+            m_OutBuffer->reset();
+        else
+            m_OutBuffer->crunch(); // move the data to the base of the buffer
     }
 
-    const size_t send_len = mblk->length();
-
-#ifdef MSG_NOSIGNAL
-    ssize_t n = peer().send (mblk->rd_ptr(), send_len, MSG_NOSIGNAL);
-#else
-    ssize_t n = peer().send (mblk->rd_ptr(), send_len);
-#endif // MSG_NOSIGNAL
-
-    if (n == 0)
+    while (l_Remaining > 0 && !msg_queue()->is_empty())
     {
-        mblk->release();
+        if (msg_queue()->dequeue_head(mblk, (ACE_Time_Value*)&ACE_Time_Value::zero) == -1)
+        {
+            sLog->outError(LOG_FILTER_NETWORKIO, "WorldSocket::handle_output dequeue_head");
+            return -1;
+        }
 
-        return -1;
-    }
-    else if (n == -1)
-    {
-        if (errno == EWOULDBLOCK || errno == EAGAIN)
+        for (ACE_Message_Block* l_Block = mblk; l_Block != nullptr && l_Remaining > 0; l_Block = l_Block->cont())
         {
-            msg_queue()->enqueue_head(mblk, (ACE_Time_Value*) &ACE_Time_Value::zero);
-            return schedule_wakeup_output (g);
+            size_t l_Sent = std::min(l_Remaining, l_Block->length());
+            l_Remaining -= l_Sent;
+
+            l_Block->rd_ptr(l_Sent);
         }
 
-        mblk->release();
-        return -1;
-    }
-    else if (n < (ssize_t)send_len) //now n > 0
-    {
-        mblk->rd_ptr(static_cast<size_t> (n));
+        if (mblk->total_length() == 0)
+        {
+            mblk->release();
+            continue;
+        }
 
+        // Partially sent packet goes back at the head of the queue
         if (msg_queue()->enqueue_head(mblk, (ACE_Time_Value*) &ACE_Time_Value::zero) == -1)
         {
-            sLog->outError(LOG_FILTER_NETWORKIO, "WorldSocket::handle_output_queue enqueue_head");
+            sLog->outError(LOG_FILTER_NETWORKIO, "WorldSocket::handle_output enqueue_head");
             mblk->release();
             return -1;
         }
-
-        return schedule_wakeup_output (g);
     }
-    else //now n == send_len
-    {
-        mblk->release();
 
-        return msg_queue()->is_empty() ? cancel_wakeup_output(g) : ACE_Event_Handler::WRITE_MASK;
-    }
+    if (n < (ssize_t)send_len)
+        return schedule_wakeup_output (Guard);
 
-    ACE_NOTREACHED(return -1);
+    return (m_OutBuffer->length() == 0 && msg_queue()->is_empty()) ? cancel_wakeup_output(Guard) : ACE_Event_Handler::WRITE_MASK;
 }
 
 int WorldSocket::handle_close (ACE_HANDLE h, ACE_Reactor_Mask)
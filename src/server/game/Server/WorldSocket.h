@@ -36,6 +36,7 @@
 class ACE_Message_Block;
 class WorldPacket;
 class WorldSession;
+class SharedWorldPacket;
 
 /// Handler that can communicate over stream sockets.
 typedef ACE_Svc_Handler<ACE_SOCK_STREAM, ACE_NULL_SYNCH> WorldHandler;
@@ -61,6 +62,11 @@ typedef ACE_Svc_Handler<ACE_SOCK_STREAM, ACE_NULL_SYNCH> WorldHandler;
  * sending packets from "producer" threads is minimal,
  * and doing a lot of writes with small size is tolerated.
  *
+ * Broadcast packets (SharedWorldPacket) are not copied, their
+ * payload is queued by reference behind a per socket header.
+ * The output buffer and the queued blocks are flushed together
+ * with a single gathered write (sendmsg/writev).
+ *
  * The calls to Update() method are managed by WorldSocketMgr
  * and ReactorRunnable.
  *
@@ -102,6 +108,11 @@ class WorldSocket : public WorldHandler
         /// @return -1 of failure
         int SendPacket(const WorldPacket& pct);
 
+        /// Send a broadcast packet, the payload is queued by reference instead of being copied.
+        /// @param p_Packet packet shared between all recipients
+        /// @return -1 of failure
+        int SendPacket(SharedWorldPacket const& p_Packet);
+
         /// Add reference to this object.
         long AddReference (void);
 
@@ -140,8 +151,8 @@ class WorldSocket : public WorldHandler
         int cancel_wakeup_output (GuardType& g);
         int schedule_wakeup_output (GuardType& g);
 
-        /// Drain the queue if its not empty.
-        int handle_output_queue (GuardType& g);
+        /// Common part of both SendPacket, p_Shared is null for regular packets.
+        int SendPacket(WorldPacket const& pct, SharedWorldPacket const* p_Shared);
 
         /// process one incoming packet.
         /// @param new_pct received packet, note that you need to delete it.
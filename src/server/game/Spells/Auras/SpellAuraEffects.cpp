@@ -1437,7 +1437,10 @@ void AuraEffect::ChangeAmount(int32 newAmount, bool mark, bool onStackOrReapply)
     if (handleMask & AURA_EFFECT_HANDLE_CHANGE_AMOUNT)
     {
         if (!mark)
+        {
             m_amount = newAmount;
+            InvalidateTargetsAuraModifierCache();
+        }
         else
             SetAmount(newAmount);
     }
@@ -1453,6 +1456,12 @@ void AuraEffect::ChangeAmount(int32 newAmount, bool mark, bool onStackOrReapply)
         GetBase()->SetNeedClientUpdateForTargets();
 }
 
+void AuraEffect::InvalidateTargetsAuraModifierCache()
+{
+    for (Aura::ApplicationMap::const_iterator l_Itr = GetBase()->GetApplicationMap().begin(); l_Itr != GetBase()->GetApplicationMap().end(); ++l_Itr)
+        l_Itr->second->GetTarget()->InvalidateAuraModifierCache(GetAuraType());
+}
+
 void AuraEffect::HandleEffect(AuraApplication * aurApp, uint8 mode, bool apply)
 {
     // check if call is correct, we really don't want using bitmasks here (with 1 exception)
@@ -56,6 +56,7 @@ class AuraEffect
             {
                 m_amount = amount;
                 GetBase()->SetNeedClientUpdateForTargets();
+                InvalidateTargetsAuraModifierCache();
             }
             m_canBeRecalculated = false;
         }
@@ -129,6 +130,9 @@ class AuraEffect
     private:
         bool CanPeriodicTickCrit(Unit* target, Unit const* caster) const;
 
+        /// Aggregated aura modifiers of the targets depend on m_amount
+        void InvalidateTargetsAuraModifierCache();
+
     public:
         // aura effect apply/remove handlers
         void HandleNULL(AuraApplication const* /*aurApp*/, uint8 /*mode*/, bool /*apply*/) const
@@ -608,7 +608,7 @@ m_caster((info->AttributesEx6 & SPELL_ATTR6_CAST_BY_CHARMER && caster->GetCharme
 
     m_SpellVisualID = m_spellInfo->GetSpellVisualID(m_caster);
 
-    std::list<AuraEffect*>const& l_VisualModifiers = m_caster->GetAuraEffectsByType(SPELL_AURA_CHANGE_VISUAL_EFFECT);
+    Unit::AuraEffectList const& l_VisualModifiers = m_caster->GetAuraEffectsByType(SPELL_AURA_CHANGE_VISUAL_EFFECT);
     for (AuraEffect* l_Effect : l_VisualModifiers)
     {
         if (l_Effect->GetMiscValue() == m_spellInfo->Id
@@ -1204,9 +1204,13 @@ void Spell::SelectImplicitConeTargets(SpellEffIndex p_EffIndex, SpellImplicitTar
                 }
             }
 
+            PrepareTargetsLOS(l_UnitTargets);
+
             for (std::list<Unit*>::iterator l_Iterator = l_UnitTargets.begin(); l_Iterator != l_UnitTargets.end(); ++l_Iterator)
                 AddUnitTarget(*l_Iterator, p_EffMask, false);
 
+            m_TargetsLOS.clear();
+
             for (std::list<GameObject*>::iterator l_Iterator = l_GObjTargets.begin(); l_Iterator != l_GObjTargets.end(); ++l_Iterator)
                 AddGOTarget(*l_Iterator, p_EffMask);
 
@@ -1598,8 +1602,12 @@ void Spell::SelectImplicitAreaTargets(SpellEffIndex p_EffIndex, SpellImplicitTar
         if (uint32 l_MaxTargets = m_spellValue->MaxAffectedTargets)
             JadeCore::Containers::RandomResizeList(l_UnitTargets, l_MaxTargets);
 
+        PrepareTargetsLOS(l_UnitTargets);
+
         for (std::list<Unit*>::iterator l_Iterator = l_UnitTargets.begin(); l_Iterator != l_UnitTargets.end(); ++l_Iterator)
             AddUnitTarget(*l_Iterator, p_EffMask, false);
+
+        m_TargetsLOS.clear();
     }
 
     if (!l_GObjTargets.empty())
@@ -8582,15 +8590,20 @@ bool Spell::CheckEffectTarget(Unit const* target, uint32 eff) const
             if (LOSAdditionalRules(target))
                 return true;
 
+            bool const* l_LineOfSight = nullptr;
+            auto l_Itr = m_TargetsLOS.find(target->GetGUID());
+            if (l_Itr != m_TargetsLOS.end())
+                l_LineOfSight = &l_Itr->second;
+
             if (m_targets.HasDst())
             {
                 float x, y, z;
                 m_targets.GetDstPos()->GetPosition(x, y, z);
 
-                if (!target->IsWithinLOS(x, y, z))
+                if (l_LineOfSight ? !*l_LineOfSight : !target->IsWithinLOS(x, y, z))
                     return false;
             }
-            else if (target != m_caster && !target->IsWithinLOSInMap(caster))
+            else if (target != m_caster && !target->IsWithinLOSInMap(caster, l_LineOfSight))
                 return false;
             break;
     }
@@ -8598,6 +8611,60 @@ bool Spell::CheckEffectTarget(Unit const* target, uint32 eff) const
     return true;
 }
 
+void Spell::PrepareTargetsLOS(std::list<Unit*> const& p_Targets)
+{
+    m_TargetsLOS.clear();
+
+    if (p_Targets.size() < 2)
+        return;
+
+    if (!m_spellInfo->IsNeedAdditionalLosChecks() && (IsTriggered() || m_spellInfo->AttributesEx2 & SPELL_ATTR2_CAN_TARGET_NOT_IN_LOS))
+        return;
+
+    /// Same end of the line of sight as CheckEffectTarget
+    float l_X, l_Y, l_Z;
+    if (m_targets.HasDst())
+        m_targets.GetDstPos()->GetPosition(l_X, l_Y, l_Z);
+    else
+    {
+        WorldObject* l_Caster = nullptr;
+        if (IS_GAMEOBJECT_GUID(m_originalCasterGUID))
+            l_Caster = m_caster->GetMap()->GetGameObject(m_originalCasterGUID);
+        if (!l_Caster)
+            l_Caster = m_caster;
+
+        l_Caster->GetPosition(l_X, l_Y, l_Z);
+    }
+
+    Map* l_Map = m_caster->GetMap();
+
+    std::vector<G3D::Vector3> l_Starts;
+    std::vector<G3D::Vector3> l_Ends;
+    std::vector<uint32>       l_PhaseMasks;
+    std::vector<uint64>       l_Guids;
+
+    for (Unit* l_Target : p_Targets)
+    {
+        if (l_Target == m_caster || !l_Target->IsInWorld() || l_Target->GetMap() != l_Map)
+            continue;
+
+        /// Eyes height, as WorldObject::IsWithinLOS
+        l_Starts.push_back(G3D::Vector3(l_Target->GetPositionX(), l_Target->GetPositionY(), l_Target->GetPositionZ() + 2.0f));
+        l_Ends.push_back(G3D::Vector3(l_X, l_Y, l_Z + 2.0f));
+        l_PhaseMasks.push_back(l_Target->GetPhaseMask());
+        l_Guids.push_back(l_Target->GetGUID());
+    }
+
+    if (l_Guids.empty())
+        return;
+
+    std::unique_ptr<bool[]> l_Results(new bool[l_Guids.size()]);
+    l_Map->isInLineOfSight(l_Starts.data(), l_Ends.data(), l_PhaseMasks.data(), l_Guids.size(), l_Results.get());
+
+    for (size_t l_I = 0; l_I < l_Guids.size(); ++l_I)
+        m_TargetsLOS[l_Guids[l_I]] = l_Results[l_I];
+}
+
 bool Spell::IsNextMeleeSwingSpell() const
 {
     return m_spellInfo->Attributes & SPELL_ATTR0_ON_NEXT_SWING;
@@ -606,6 +606,8 @@ public:
     void DoCreateItem(uint32 i, uint32 itemtype, bool vellum = false);
 
     bool CheckEffectTarget(Unit const* target, uint32 eff) const;
+    /// Compute at once the line of sight CheckEffectTarget needs for each of these targets, one ray each instead of one per target and effect
+    void PrepareTargetsLOS(std::list<Unit*> const& p_Targets);
     bool CanAutoCast(Unit* target);
     void CheckSrc() { if (!m_targets.HasSrc()) m_targets.SetSrc(*m_caster); }
     void CheckDst() { if (!m_targets.HasDst()) m_targets.SetDst(*m_caster); }
@@ -645,6 +647,7 @@ public:
     uint32 m_Misc[2];
     uint32 m_preCastSpell;
     SpellCastTargets m_targets;
+    std::unordered_map<uint64, bool> m_TargetsLOS;      ///< Line of sight of the targets being added, filled by PrepareTargetsLOS
     int8 m_comboPointGain;
     SpellCustomErrors m_customError;
     bool isStolen;
@@ -3605,7 +3605,7 @@ SpellTargetRestrictionsEntry const* SpellInfo::GetSpellTargetRestrictions() cons
 {
     if (DifficultyID != Difficulty::DifficultyNone)
     {
-        uint32 l_EntryByDifficulty = sSpellMgr->GetDifficultyEntryForDataStore(sSpellTargetRestrictionsStore.GetDbcFileName(), Id, DifficultyID);
+        uint32 l_EntryByDifficulty = sSpellMgr->GetDifficultyEntryForDataStore(SPELL_DIFFICULTY_TARGET_RESTRICTIONS, Id, DifficultyID);
         if (l_EntryByDifficulty != 0)
             return sSpellTargetRestrictionsStore.LookupEntry(l_EntryByDifficulty);
     }
@@ -3617,7 +3617,7 @@ SpellEquippedItemsEntry const* SpellInfo::GetSpellEquippedItems() const
 {
     if (DifficultyID != Difficulty::DifficultyNone)
     {
-        uint32 l_EntryByDifficulty = sSpellMgr->GetDifficultyEntryForDataStore(sSpellEquippedItemsStore.GetDbcFileName(), Id, DifficultyID);
+        uint32 l_EntryByDifficulty = sSpellMgr->GetDifficultyEntryForDataStore(SPELL_DIFFICULTY_EQUIPPED_ITEMS, Id, DifficultyID);
         if (l_EntryByDifficulty != 0)
             return sSpellEquippedItemsStore.LookupEntry(l_EntryByDifficulty);
     }
@@ -3629,7 +3629,7 @@ SpellInterruptsEntry const* SpellInfo::GetSpellInterrupts() const
 {
     if (DifficultyID != Difficulty::DifficultyNone)
     {
-        uint32 l_EntryByDifficulty = sSpellMgr->GetDifficultyEntryForDataStore(sSpellInterruptsStore.GetDbcFileName(), Id, DifficultyID);
+        uint32 l_EntryByDifficulty = sSpellMgr->GetDifficultyEntryForDataStore(SPELL_DIFFICULTY_INTERRUPTS, Id, DifficultyID);
         if (l_EntryByDifficulty != 0)
             return sSpellInterruptsStore.LookupEntry(l_EntryByDifficulty);
     }
@@ -3641,7 +3641,7 @@ SpellLevelsEntry const* SpellInfo::GetSpellLevels() const
 {
     if (DifficultyID != Difficulty::DifficultyNone)
     {
-        uint32 l_EntryByDifficulty = sSpellMgr->GetDifficultyEntryForDataStore(sSpellLevelsStore.GetDbcFileName(), Id, DifficultyID);
+        uint32 l_EntryByDifficulty = sSpellMgr->GetDifficultyEntryForDataStore(SPELL_DIFFICULTY_LEVELS, Id, DifficultyID);
         if (l_EntryByDifficulty != 0)
             return sSpellLevelsStore.LookupEntry(l_EntryByDifficulty);
     }
@@ -3683,7 +3683,7 @@ SpellAuraOptionsEntry const* SpellInfo::GetSpellAuraOptions() const
 {
     if (DifficultyID != Difficulty::DifficultyNone)
     {
-        uint32 l_EntryByDifficulty = sSpellMgr->GetDifficultyEntryForDataStore(sSpellAuraOptionsStore.GetDbcFileName(), Id, DifficultyID);
+        uint32 l_EntryByDifficulty = sSpellMgr->GetDifficultyEntryForDataStore(SPELL_DIFFICULTY_AURA_OPTIONS, Id, DifficultyID);
         if (l_EntryByDifficulty != 0)
             return sSpellAuraOptionsStore.LookupEntry(l_EntryByDifficulty);
     }
@@ -3705,7 +3705,7 @@ SpellCategoriesEntry const* SpellInfo::GetSpellCategories() const
 {
     if (DifficultyID != Difficulty::DifficultyNone)
     {
-        uint32 l_EntryByDifficulty = sSpellMgr->GetDifficultyEntryForDataStore(sSpellCategoriesStore.GetDbcFileName(), Id, DifficultyID);
+        uint32 l_EntryByDifficulty = sSpellMgr->GetDifficultyEntryForDataStore(SPELL_DIFFICULTY_CATEGORIES, Id, DifficultyID);
         if (l_EntryByDifficulty != 0)
             return sSpellCategoriesStore.LookupEntry(l_EntryByDifficulty);
     }
@@ -3722,7 +3722,7 @@ SpellCooldownsEntry const* SpellInfo::GetSpellCooldowns() const
 {
     if (DifficultyID != Difficulty::DifficultyNone)
     {
-        uint32 l_EntryByDifficulty = sSpellMgr->GetDifficultyEntryForDataStore(sSpellCooldownsStore.GetDbcFileName(), Id, DifficultyID);
+        uint32 l_EntryByDifficulty = sSpellMgr->GetDifficultyEntryForDataStore(SPELL_DIFFICULTY_COOLDOWNS, Id, DifficultyID);
         if (l_EntryByDifficulty != 0)
             return sSpellCooldownsStore.LookupEntry(l_EntryByDifficulty);
     }
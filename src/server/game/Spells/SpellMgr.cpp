@@ -563,6 +563,8 @@ int32 GetDiminishingReturnsLimitDuration(SpellInfo const* spellproto, Unit* p_Or
 
 SpellMgr::SpellMgr()
 {
+    memset(m_DifficultyFallbacks, 0, sizeof(m_DifficultyFallbacks));
+    memset(m_DifficultyFallbackCounts, 0, sizeof(m_DifficultyFallbackCounts));
 }
 
 SpellMgr::~SpellMgr()
@@ -3007,6 +3009,8 @@ void SpellMgr::InitializeSpellDifficulty()
 {
     mAvaiableDifficultyBySpell.clear();
 
+    std::vector<std::pair<uint32, SpellDifficultyEntry>> l_DifficultyEntries;
+
     /// SpellAuraOptions
     for (uint32 l_I = 0; l_I < sSpellAuraOptionsStore.GetNumRows(); ++l_I)
     {
@@ -3015,7 +3019,7 @@ void SpellMgr::InitializeSpellDifficulty()
             mAvaiableDifficultyBySpell[l_SpellAuraOption->m_SpellID].insert(l_SpellAuraOption->m_DifficultyID);
 
             if (l_SpellAuraOption->m_DifficultyID != Difficulty::DifficultyNone)
-                mDatastoreSpellDifficultyKey[sSpellAuraOptionsStore.GetDbcFileName()].insert(std::make_pair(std::make_pair(l_SpellAuraOption->m_SpellID, l_SpellAuraOption->m_DifficultyID), l_SpellAuraOption->Id));
+                l_DifficultyEntries.push_back(std::make_pair(l_SpellAuraOption->m_SpellID, SpellDifficultyEntry(SPELL_DIFFICULTY_AURA_OPTIONS, l_SpellAuraOption->m_DifficultyID, l_SpellAuraOption->Id)));
         }
     }
 
@@ -3027,7 +3031,7 @@ void SpellMgr::InitializeSpellDifficulty()
             mAvaiableDifficultyBySpell[l_SpellCategories->SpellId].insert(l_SpellCategories->m_DifficultyID);
 
             if (l_SpellCategories->m_DifficultyID != Difficulty::DifficultyNone)
-                mDatastoreSpellDifficultyKey[sSpellCategoriesStore.GetDbcFileName()].insert(std::make_pair(std::make_pair(l_SpellCategories->SpellId, l_SpellCategories->m_DifficultyID), l_SpellCategories->Id));
+                l_DifficultyEntries.push_back(std::make_pair(l_SpellCategories->SpellId, SpellDifficultyEntry(SPELL_DIFFICULTY_CATEGORIES, l_SpellCategories->m_DifficultyID, l_SpellCategories->Id)));
         }
     }
 
@@ -3039,7 +3043,7 @@ void SpellMgr::InitializeSpellDifficulty()
             mAvaiableDifficultyBySpell[l_SpellCooldown->m_SpellID].insert(l_SpellCooldown->m_DifficultyID);
 
             if (l_SpellCooldown->m_DifficultyID != Difficulty::DifficultyNone)
-                mDatastoreSpellDifficultyKey[sSpellCooldownsStore.GetDbcFileName()].insert(std::make_pair(std::make_pair(l_SpellCooldown->m_SpellID, l_SpellCooldown->m_DifficultyID), l_SpellCooldown->Id));
+                l_DifficultyEntries.push_back(std::make_pair(l_SpellCooldown->m_SpellID, SpellDifficultyEntry(SPELL_DIFFICULTY_COOLDOWNS, l_SpellCooldown->m_DifficultyID, l_SpellCooldown->Id)));
         }
     }
 
@@ -3051,7 +3055,7 @@ void SpellMgr::InitializeSpellDifficulty()
             mAvaiableDifficultyBySpell[l_SpellEffect->EffectSpellId].insert(l_SpellEffect->EffectDifficulty);
 
             if (l_SpellEffect->EffectDifficulty != Difficulty::DifficultyNone)
-                mDatastoreSpellDifficultyKey[sSpellEffectStore.GetDbcFileName()].insert(std::make_pair(std::make_pair(l_SpellEffect->EffectSpellId, l_SpellEffect->EffectDifficulty), l_SpellEffect->Id));
+                l_DifficultyEntries.push_back(std::make_pair(l_SpellEffect->EffectSpellId, SpellDifficultyEntry(SPELL_DIFFICULTY_EFFECTS, l_SpellEffect->EffectDifficulty, l_SpellEffect->Id)));
         }
     }
 
@@ -3063,7 +3067,7 @@ void SpellMgr::InitializeSpellDifficulty()
             mAvaiableDifficultyBySpell[l_SpellEquippedItem->SpellID].insert(l_SpellEquippedItem->DifficultyID);
 
             if (l_SpellEquippedItem->DifficultyID != Difficulty::DifficultyNone)
-                mDatastoreSpellDifficultyKey[sSpellEquippedItemsStore.GetDbcFileName()].insert(std::make_pair(std::make_pair(l_SpellEquippedItem->SpellID, l_SpellEquippedItem->DifficultyID), l_SpellEquippedItem->Id));
+                l_DifficultyEntries.push_back(std::make_pair(l_SpellEquippedItem->SpellID, SpellDifficultyEntry(SPELL_DIFFICULTY_EQUIPPED_ITEMS, l_SpellEquippedItem->DifficultyID, l_SpellEquippedItem->Id)));
         }
     }
 
@@ -3075,7 +3079,7 @@ void SpellMgr::InitializeSpellDifficulty()
             mAvaiableDifficultyBySpell[l_SpellInterrupt->SpellID].insert(l_SpellInterrupt->DifficultyID);
 
             if (l_SpellInterrupt->DifficultyID != Difficulty::DifficultyNone)
-                mDatastoreSpellDifficultyKey[sSpellInterruptsStore.GetDbcFileName()].insert(std::make_pair(std::make_pair(l_SpellInterrupt->SpellID, l_SpellInterrupt->DifficultyID), l_SpellInterrupt->Id));
+                l_DifficultyEntries.push_back(std::make_pair(l_SpellInterrupt->SpellID, SpellDifficultyEntry(SPELL_DIFFICULTY_INTERRUPTS, l_SpellInterrupt->DifficultyID, l_SpellInterrupt->Id)));
 
         }
     }
@@ -3088,7 +3092,7 @@ void SpellMgr::InitializeSpellDifficulty()
             mAvaiableDifficultyBySpell[l_SpellLevel->SpellID].insert(l_SpellLevel->DifficultyID);
 
             if (l_SpellLevel->DifficultyID != Difficulty::DifficultyNone)
-                mDatastoreSpellDifficultyKey[sSpellLevelsStore.GetDbcFileName()].insert(std::make_pair(std::make_pair(l_SpellLevel->SpellID, l_SpellLevel->DifficultyID), l_SpellLevel->Id));
+                l_DifficultyEntries.push_back(std::make_pair(l_SpellLevel->SpellID, SpellDifficultyEntry(SPELL_DIFFICULTY_LEVELS, l_SpellLevel->DifficultyID, l_SpellLevel->Id)));
         }
     }
 
@@ -3100,7 +3104,7 @@ void SpellMgr::InitializeSpellDifficulty()
             mAvaiableDifficultyBySpell[l_SpellTargetRestriction->SpellId].insert(l_SpellTargetRestriction->DifficultyID);
 
             if (l_SpellTargetRestriction->DifficultyID != Difficulty::DifficultyNone)
-                mDatastoreSpellDifficultyKey[sSpellTargetRestrictionsStore.GetDbcFileName()].insert(std::make_pair(std::make_pair(l_SpellTargetRestriction->SpellId, l_SpellTargetRestriction->DifficultyID), l_SpellTargetRestriction->Id));
+                l_DifficultyEntries.push_back(std::make_pair(l_SpellTargetRestriction->SpellId, SpellDifficultyEntry(SPELL_DIFFICULTY_TARGET_RESTRICTIONS, l_SpellTargetRestriction->DifficultyID, l_SpellTargetRestriction->Id)));
         }
     }
 
@@ -3112,9 +3116,11 @@ void SpellMgr::InitializeSpellDifficulty()
             mAvaiableDifficultyBySpell[l_Visual->SpellId].insert(l_Visual->DifficultyID);
 
             if (l_Visual->DifficultyID != Difficulty::DifficultyNone)
-                mDatastoreSpellDifficultyKey[sSpellXSpellVisualStore.GetDB2FileName()].insert(std::make_pair(std::make_pair(l_Visual->SpellId, l_Visual->DifficultyID), l_Visual->Id));
+                l_DifficultyEntries.push_back(std::make_pair(l_Visual->SpellId, SpellDifficultyEntry(SPELL_DIFFICULTY_X_SPELL_VISUAL, l_Visual->DifficultyID, l_Visual->Id)));
         }
     }
+
+    m_SpellDifficultyEntries.Build(sSpellStore.GetNumRows(), l_DifficultyEntries);
 }
 
 void SpellMgr::LoadSpellInfoStore()
@@ -3149,6 +3155,8 @@ void SpellMgr::LoadSpellInfoStore()
         }
     });
 
+    BuildSpellInfoLookup();
+
     for (uint32 l_I = 0; l_I < sSpellPowerStore.GetNumRows(); l_I++)
     {
         SpellPowerEntry const* spellPower = sSpellPowerStore.LookupEntry(l_I);
@@ -3187,8 +3195,51 @@ void SpellMgr::LoadSpellInfoStore()
     sLog->outInfo(LOG_FILTER_SERVER_LOADING, ">> Loaded spell info store in %u ms", GetMSTimeDiffToNow(oldMSTime));
 }
 
+void SpellMgr::BuildSpellInfoLookup()
+{
+    static_assert(Difficulty::MaxDifficulties <= 32, "m_SpellDifficultyMasks holds a bit per difficulty");
+
+    /// Fallback chains of the Difficulty store, walked by GetSpellInfo without any datastore lookup
+    for (uint32 l_Difficulty = 0; l_Difficulty < Difficulty::MaxDifficulties; ++l_Difficulty)
+    {
+        uint8& l_Count = m_DifficultyFallbackCounts[l_Difficulty];
+        l_Count = 0;
+
+        DifficultyEntry const* l_Entry = sDifficultyStore.LookupEntry(l_Difficulty);
+        while (l_Entry != nullptr && l_Entry->ID < Difficulty::MaxDifficulties && l_Count < Difficulty::MaxDifficulties)
+        {
+            m_DifficultyFallbacks[l_Difficulty][l_Count++] = l_Entry->ID;
+            l_Entry = sDifficultyStore.LookupEntry(l_Entry->FallbackDifficultyID);
+        }
+    }
+
+    m_SpellDifficultyMasks.assign(mSpellInfoMap[DifficultyNone].size(), 0);
+    for (uint32 l_Difficulty = 0; l_Difficulty < Difficulty::MaxDifficulties; ++l_Difficulty)
+    {
+        for (uint32 l_SpellID = 0; l_SpellID < mSpellInfoMap[l_Difficulty].size(); ++l_SpellID)
+        {
+            if (mSpellInfoMap[l_Difficulty][l_SpellID])
+                m_SpellDifficultyMasks[l_SpellID] |= 1 << l_Difficulty;
+        }
+    }
+
+    std::vector<std::pair<uint32, SpellDifficultyVisual>> l_Visuals;
+    for (auto const& l_SpellVisuals : VisualsBySpellMap)
+    {
+        for (auto const& l_DifficultyVisuals : l_SpellVisuals.second)
+        {
+            if (!l_DifficultyVisuals.second.empty())
+                l_Visuals.push_back(std::make_pair(l_SpellVisuals.first, SpellDifficultyVisual(l_DifficultyVisuals.first, l_DifficultyVisuals.second[0]->Id)));
+        }
+    }
+
+    m_SpellDifficultyVisuals.Build(sSpellStore.GetNumRows(), l_Visuals);
+}
+
 void SpellMgr::UnloadSpellInfoStore()
 {
+    m_SpellDifficultyMasks.clear();
+
     for (int difficulty = 0; difficulty < Difficulty::MaxDifficulties; difficulty++)
     {
         for (uint32 i = 0; i < mSpellInfoMap[difficulty].size(); ++i)
@@ -7854,8 +7905,23 @@ const SpellInfo* SpellMgr::GetSpellInfo(uint32 p_SpellID, Difficulty p_Difficult
 {
     if (p_SpellID < GetSpellInfoStoreSize())
     {
-        if (p_Difficulty != DifficultyNone)
+        if (p_Difficulty < Difficulty::MaxDifficulties && p_SpellID < m_SpellDifficultyMasks.size())
+        {
+            /// Most spells only exist in DifficultyNone
+            uint32 l_Mask = m_SpellDifficultyMasks[p_SpellID];
+            if (p_Difficulty != DifficultyNone && (l_Mask & ~1))
+            {
+                for (uint8 l_I = 0; l_I < m_DifficultyFallbackCounts[p_Difficulty]; ++l_I)
+                {
+                    uint8 l_Difficulty = m_DifficultyFallbacks[p_Difficulty][l_I];
+                    if (l_Mask & (1 << l_Difficulty))
+                        return mSpellInfoMap[l_Difficulty][p_SpellID];
+                }
+            }
+        }
+        else if (p_Difficulty != DifficultyNone)
         {
+            /// Lookup not built yet (spell info store loading) or difficulty out of it
             /// If spell isn't available in difficulty we want, check fallback difficulty ...
             DifficultyEntry const* l_Difficulty = sDifficultyStore.LookupEntry(p_Difficulty);
             while (l_Difficulty != nullptr)
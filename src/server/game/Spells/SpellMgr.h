@@ -597,8 +597,78 @@ typedef std::set<uint32> TalentsPlaceHoldersSpell;
 typedef std::set<uint32> TalentSpellSet;
 typedef std::vector<std::list<uint32> > SpellPowerVector;
 typedef std::map<uint32, std::set<uint32>> AvaiableDifficultySpell;
-typedef std::map<std::pair<uint32, uint32>, uint32> DataStoreMapPair;
-typedef std::map<std::string, DataStoreMapPair> DatastoreDifficultyKey;
+
+/// Spell datastores having rows for a specific difficulty
+enum SpellDifficultyDataStore
+{
+    SPELL_DIFFICULTY_AURA_OPTIONS,
+    SPELL_DIFFICULTY_CATEGORIES,
+    SPELL_DIFFICULTY_COOLDOWNS,
+    SPELL_DIFFICULTY_EFFECTS,
+    SPELL_DIFFICULTY_EQUIPPED_ITEMS,
+    SPELL_DIFFICULTY_INTERRUPTS,
+    SPELL_DIFFICULTY_LEVELS,
+    SPELL_DIFFICULTY_TARGET_RESTRICTIONS,
+    SPELL_DIFFICULTY_X_SPELL_VISUAL
+};
+
+/// Datastore row of a spell for a difficulty other than DifficultyNone
+struct SpellDifficultyEntry
+{
+    SpellDifficultyEntry(uint8 p_DataStore, uint8 p_Difficulty, uint32 p_EntryID) : DataStore(p_DataStore), Difficulty(p_Difficulty), EntryID(p_EntryID) { }
+
+    uint8  DataStore;       ///< SpellDifficultyDataStore
+    uint8  Difficulty;
+    uint32 EntryID;
+};
+
+/// First SpellXSpellVisual of a spell for a difficulty
+struct SpellDifficultyVisual
+{
+    SpellDifficultyVisual(uint32 p_Difficulty, uint32 p_VisualID) : Difficulty(p_Difficulty), VisualID(p_VisualID) { }
+
+    uint32 Difficulty;
+    uint32 VisualID;
+};
+
+/// Immutable per spell lists stored in one array, built once at startup
+/// - The values of a spell are Values[Offsets[spellId]] to Values[Offsets[spellId + 1]] excluded
+/// - Most spells have no value, a lookup is then two reads in Offsets
+template<class T> class SpellFlatIndex
+{
+    public:
+        /// @p_Values : Spell id and value, values of a same spell keep their order
+        void Build(uint32 p_SpellCount, std::vector<std::pair<uint32, T>>& p_Values)
+        {
+            std::stable_sort(p_Values.begin(), p_Values.end(), [](std::pair<uint32, T> const& p_A, std::pair<uint32, T> const& p_B) -> bool
+            {
+                return p_A.first < p_B.first;
+            });
+
+            m_Offsets.assign(p_SpellCount + 1, 0);
+            m_Values.clear();
+            m_Values.reserve(p_Values.size());
+
+            for (auto const& l_Value : p_Values)
+            {
+                if (l_Value.first >= p_SpellCount)
+                    continue;
+
+                ++m_Offsets[l_Value.first + 1];
+                m_Values.push_back(l_Value.second);
+            }
+
+            for (uint32 l_I = 0; l_I < p_SpellCount; ++l_I)
+                m_Offsets[l_I + 1] += m_Offsets[l_I];
+        }
+
+        T const* Begin(uint32 p_SpellId) const { return p_SpellId + 1 < m_Offsets.size() ? m_Values.data() + m_Offsets[p_SpellId] : nullptr; }
+        T const* End(uint32 p_SpellId) const { return p_SpellId + 1 < m_Offsets.size() ? m_Values.data() + m_Offsets[p_SpellId + 1] : nullptr; }
+
+    private:
+        std::vector<uint32> m_Offsets;
+        std::vector<T>      m_Values;
+};
 
 using ItemSourceSkills = std::map<uint32, std::vector<uint32>>;
 using TradeSpellSkills = std::map<uint32, std::list<SkillLineAbilityEntry const*>>;
@@ -720,17 +790,16 @@ class SpellMgr
         uint16 GetDatasForILevel(uint16 iLevel) { return mItemUpgradeDatas.find(iLevel) != mItemUpgradeDatas.end() ? mItemUpgradeDatas[iLevel] : 0; }
 
         // Spell Difficulty
-        uint32 GetDifficultyEntryForDataStore(std::string p_DbcName, uint32 p_SpellID, uint32 p_DifficultyID) const
+        uint32 GetDifficultyEntryForDataStore(SpellDifficultyDataStore p_DataStore, uint32 p_SpellID, uint32 p_DifficultyID) const
         {
-            DatastoreDifficultyKey::const_iterator l_Itr = mDatastoreSpellDifficultyKey.find(p_DbcName);
-            if (l_Itr == mDatastoreSpellDifficultyKey.end())
-                return 0;
-
-            DataStoreMapPair::const_iterator l_Itr2 = l_Itr->second.find(std::make_pair(p_SpellID, p_DifficultyID));
-            if (l_Itr2 == l_Itr->second.end())
-                return 0;
+            SpellDifficultyEntry const* l_End = m_SpellDifficultyEntries.End(p_SpellID);
+            for (SpellDifficultyEntry const* l_Itr = m_SpellDifficultyEntries.Begin(p_SpellID); l_Itr != l_End; ++l_Itr)
+            {
+                if (l_Itr->DataStore == p_DataStore && l_Itr->Difficulty == p_DifficultyID)
+                    return l_Itr->EntryID;
+            }
 
-            return l_Itr2->second;
+            return 0;
         }
 
         std::vector<uint32> const* GetItemSourceSkills(uint32 p_ItemEntry) const
@@ -757,25 +826,21 @@ class SpellMgr
 
         std::unordered_map<uint32, SpellVisualMap> VisualsBySpellMap;
 
-        uint32 GetSpellXVisualForSpellID(uint32 p_SpellId, uint32 p_Difficulty, uint32 p_Fallback)
+        uint32 GetSpellXVisualForSpellID(uint32 p_SpellId, uint32 p_Difficulty, uint32 p_Fallback) const
         {
-            auto l_It = VisualsBySpellMap.find(p_SpellId);
-            if (l_It != VisualsBySpellMap.end())
+            uint32 l_DefaultVisual = p_Fallback;
+
+            SpellDifficultyVisual const* l_End = m_SpellDifficultyVisuals.End(p_SpellId);
+            for (SpellDifficultyVisual const* l_Itr = m_SpellDifficultyVisuals.Begin(p_SpellId); l_Itr != l_End; ++l_Itr)
             {
-                auto l_SecondIt = l_It->second.find(p_Difficulty);
-
-                if (l_SecondIt != l_It->second.end())
-                    return l_SecondIt->second.at(0)->Id;
-                else
-                {
-                    p_Difficulty = 0;
-                    l_SecondIt = l_It->second.find(p_Difficulty);
-                    if (l_SecondIt != l_It->second.end())
-                        return l_SecondIt->second.at(0)->Id;
-                }
+                if (l_Itr->Difficulty == p_Difficulty)
+                    return l_Itr->VisualID;
+
+                if (l_Itr->Difficulty == DifficultyNone)
+                    l_DefaultVisual = l_Itr->VisualID;
             }
 
-            return p_Fallback;
+            return l_DefaultVisual;
         }
 
     // Modifiers
@@ -803,6 +868,7 @@ class SpellMgr
         void LoadSpellAreas();
         void InitializeSpellDifficulty();
         void LoadSpellInfoStore();
+        void BuildSpellInfoLookup();
         void LoadSpellClassInfo();
         void UnloadSpellInfoStore();
         void UnloadSpellInfoImplicitTargetConditionLists();
@@ -860,7 +926,13 @@ class SpellMgr
         TalentsPlaceHoldersSpell   mPlaceHolderSpells;
         ItemUpgradeDatas           mItemUpgradeDatas;
         AvaiableDifficultySpell    mAvaiableDifficultyBySpell;
-        DatastoreDifficultyKey     mDatastoreSpellDifficultyKey;
+
+        /// Lookup tables built once the spell info store is loaded, see BuildSpellInfoLookup
+        std::vector<uint32>                         m_SpellDifficultyMasks;     ///< Bit N set if the spell has a SpellInfo for difficulty N
+        uint8                                       m_DifficultyFallbacks[Difficulty::MaxDifficulties][Difficulty::MaxDifficulties];
+        uint8                                       m_DifficultyFallbackCounts[Difficulty::MaxDifficulties];
+        SpellFlatIndex<SpellDifficultyEntry>        m_SpellDifficultyEntries;
+        SpellFlatIndex<SpellDifficultyVisual>       m_SpellDifficultyVisuals;
         ItemSourceSkills           m_ItemSourceSkills;
         TradeSpellSkills           m_SkillTradeSpells;
         SpellUpgradeItemStages     m_SpellUpgradeItemStages;
@@ -0,0 +1,179 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+//  MILLENIUM-STUDIO
+//  Copyright 2016 Millenium-studio SARL
+//  All Rights Reserved.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+#include "StartupTaskGraph.h"
+#include "DatabaseEnv.h"
+#include "MySQLThreading.h"
+#include "Timer.h"
+
+void StartupTaskGraph::Add(std::string const& p_Name, std::function<void()> const& p_Function, std::initializer_list<char const*> p_Dependencies)
+{
+    ASSERT(m_TaskIndexes.find(p_Name) == m_TaskIndexes.end());
+
+    uint32 l_Index = m_Tasks.size();
+
+    Task l_Task;
+    l_Task.Name                = p_Name;
+    l_Task.Function            = p_Function;
+    l_Task.PendingDependencies = 0;
+    l_Task.Duration            = 0;
+    l_Task.PathDuration        = 0;
+    l_Task.PathPrevious        = -1;
+
+    /// Dependencies must be declared first, so the graph can't have a cycle
+    for (char const* l_Dependency : p_Dependencies)
+    {
+        auto l_Itr = m_TaskIndexes.find(l_Dependency);
+        ASSERT(l_Itr != m_TaskIndexes.end());
+
+        l_Task.Dependencies.push_back(l_Itr->second);
+        m_Tasks[l_Itr->second].Dependents.push_back(l_Index);
+    }
+
+    m_Tasks.push_back(l_Task);
+    m_TaskIndexes[p_Name] = l_Index;
+}
+
+void StartupTaskGraph::Run(uint32 p_ThreadCount)
+{
+    uint32 l_StartTime = getMSTime();
+
+    p_ThreadCount = std::max<uint32>(std::min<uint32>(p_ThreadCount, m_Tasks.size()), 1);
+
+    if (p_ThreadCount == 1)
+    {
+        for (uint32 l_I = 0; l_I < m_Tasks.size(); ++l_I)
+            Execute(l_I);
+    }
+    else
+    {
+        m_Remaining = m_Tasks.size();
+
+        for (uint32 l_I = 0; l_I < m_Tasks.size(); ++l_I)
+        {
+            m_Tasks[l_I].PendingDependencies = m_Tasks[l_I].Dependencies.size();
+
+            if (!m_Tasks[l_I].PendingDependencies)
+                m_ReadyTasks.push_back(l_I);
+        }
+
+        std::vector<std::thread> l_Threads;
+        for (uint32 l_I = 1; l_I < p_ThreadCount; ++l_I)
+            l_Threads.push_back(std::thread(&StartupTaskGraph::WorkerThread, this, true));
+
+        /// The calling thread already has its database context
+        WorkerThread(false);
+
+        for (auto& l_Thread : l_Threads)
+            l_Thread.join();
+    }
+
+    LogReport(p_ThreadCount, GetMSTimeDiffToNow(l_StartTime));
+}
+
+void StartupTaskGraph::Execute(uint32 p_Index)
+{
+    uint32 l_StartTime = getMSTime();
+
+    m_Tasks[p_Index].Function();
+    m_Tasks[p_Index].Duration = GetMSTimeDiffToNow(l_StartTime);
+}
+
+void StartupTaskGraph::WorkerThread(bool p_InitDatabaseThread)
+{
+    if (p_InitDatabaseThread)
+        MySQL::Thread_Init();
+
+    for (;;)
+    {
+        uint32 l_Index;
+
+        {
+            std::unique_lock<std::mutex> l_Lock(m_Lock);
+
+            while (m_ReadyTasks.empty() && m_Remaining)
+                m_Condition.wait(l_Lock);
+
+            /// Nothing left to run
+            if (m_ReadyTasks.empty())
+                break;
+
+            l_Index = m_ReadyTasks.front();
+            m_ReadyTasks.pop_front();
+        }
+
+        Execute(l_Index);
+
+        {
+            std::lock_guard<std::mutex> l_Lock(m_Lock);
+
+            for (uint32 l_Dependent : m_Tasks[l_Index].Dependents)
+            {
+                if (--m_Tasks[l_Dependent].PendingDependencies == 0)
+                    m_ReadyTasks.push_back(l_Dependent);
+            }
+
+            --m_Remaining;
+        }
+
+        m_Condition.notify_all();
+    }
+
+    if (p_InitDatabaseThread)
+        MySQL::Thread_End();
+}
+
+void StartupTaskGraph::LogReport(uint32 p_ThreadCount, uint32 p_Duration)
+{
+    if (m_Tasks.empty())
+        return;
+
+    uint32 l_TotalDuration = 0;
+    uint32 l_PathEnd       = 0;
+
+    /// Dependencies always have a lower index, one pass is enough to find the longest chains
+    for (uint32 l_I = 0; l_I < m_Tasks.size(); ++l_I)
+    {
+        Task& l_Task = m_Tasks[l_I];
+
+        for (uint32 l_Dependency : l_Task.Dependencies)
+        {
+            if (m_Tasks[l_Dependency].PathDuration >= l_Task.PathDuration)
+            {
+                l_Task.PathDuration = m_Tasks[l_Dependency].PathDuration;
+                l_Task.PathPrevious = l_Dependency;
+            }
+        }
+
+        l_Task.PathDuration += l_Task.Duration;
+        l_TotalDuration     += l_Task.Duration;
+
+        if (l_Task.PathDuration > m_Tasks[l_PathEnd].PathDuration)
+            l_PathEnd = l_I;
+    }
+
+    sLog->outInfo(LOG_FILTER_SERVER_LOADING, ">> %s : %u loaders done in %u ms on %u threads (%u ms of loading)", m_Name.c_str(), uint32(m_Tasks.size()), p_Duration, p_ThreadCount, l_TotalDuration);
+
+    std::vector<Task const*> l_SortedTasks;
+    for (Task const& l_Task : m_Tasks)
+        l_SortedTasks.push_back(&l_Task);
+
+    std::stable_sort(l_SortedTasks.begin(), l_SortedTasks.end(), [](Task const* p_A, Task const* p_B) -> bool
+    {
+        return p_A->Duration > p_B->Duration;
+    });
+
+    for (Task const* l_Task : l_SortedTasks)
+        sLog->outInfo(LOG_FILTER_SERVER_LOADING, ">>     %-40s %6u ms", l_Task->Name.c_str(), l_Task->Duration);
+
+    std::string l_Path;
+    for (int32 l_I = l_PathEnd; l_I >= 0; l_I = m_Tasks[l_I].PathPrevious)
+        l_Path = l_Path.empty() ? m_Tasks[l_I].Name : m_Tasks[l_I].Name + " -> " + l_Path;
+
+    sLog->outInfo(LOG_FILTER_SERVER_LOADING, ">> %s critical path (%u ms) : %s", m_Name.c_str(), m_Tasks[l_PathEnd].PathDuration, l_Path.c_str());
+}
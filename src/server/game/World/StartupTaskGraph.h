@@ -0,0 +1,64 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+//  MILLENIUM-STUDIO
+//  Copyright 2016 Millenium-studio SARL
+//  All Rights Reserved.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef _STARTUP_TASK_GRAPH_H
+#define _STARTUP_TASK_GRAPH_H
+
+#include "Common.h"
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <initializer_list>
+
+/// Startup loaders declared with the loaders they depend on
+/// - Loaders whose dependencies are done are run by a pool of threads, each of them queries the database through its own synch connection
+/// - A loader must only write its own containers and only read the containers of its dependencies (or of the loaders run before the graph)
+/// - Once done, the time spent in each loader and the critical path are logged
+class StartupTaskGraph
+{
+    public:
+        explicit StartupTaskGraph(std::string const& p_Name) : m_Name(p_Name), m_Remaining(0) { }
+
+        /// Declare a loader
+        /// @p_Name         : Unique name, used in the report and by the loaders depending on this one
+        /// @p_Function     : Loader
+        /// @p_Dependencies : Loaders that must be done before this one starts, they must already be declared
+        void Add(std::string const& p_Name, std::function<void()> const& p_Function, std::initializer_list<char const*> p_Dependencies = {});
+
+        /// Run all the loaders and return once they are all done
+        /// @p_ThreadCount : Threads running loaders, including the calling one. With 0 or 1 the loaders run in declaration order
+        void Run(uint32 p_ThreadCount);
+
+    private:
+        struct Task
+        {
+            std::string           Name;
+            std::function<void()> Function;
+            std::vector<uint32>   Dependencies;
+            std::vector<uint32>   Dependents;
+            uint32                PendingDependencies;
+            uint32                Duration;             ///< Milliseconds
+            uint32                PathDuration;         ///< Milliseconds, longest chain of dependencies ending with this loader
+            int32                 PathPrevious;         ///< Previous loader of this chain, -1 if none
+        };
+
+        void Execute(uint32 p_Index);
+        void WorkerThread(bool p_InitDatabaseThread);
+        void LogReport(uint32 p_ThreadCount, uint32 p_Duration);
+
+        std::string                   m_Name;
+        std::vector<Task>             m_Tasks;
+        std::map<std::string, uint32> m_TaskIndexes;
+
+        std::mutex                    m_Lock;
+        std::condition_variable       m_Condition;
+        std::deque<uint32>            m_ReadyTasks;
+        uint32                        m_Remaining;
+};
+
+#endif
@@ -41,6 +41,7 @@
 #include "Opcodes.h"
 #include "WorldSession.h"
 #include "WorldPacket.h"
+#include "SharedWorldPacket.h"
 #include "Player.h"
 #include "Vehicle.h"
 #include "SkillExtraItems.h"
@@ -77,6 +78,8 @@
 #include "ScriptMgr.h"
 #include "AddonMgr.h"
 #include "LFGMgr.h"
+#include "StartupTaskGraph.h"
+#include "QuerySnapshot.h"
 #include "ConditionMgr.h"
 #include "DisableMgr.h"
 #include "ScriptMgr.h"
@@ -648,6 +651,8 @@ void World::LoadConfigSettings(bool reload)
         sLog->outError(LOG_FILTER_SERVER_LOADING, "Compression level (%i) must be in range 1..9. Using default compression level (1).", m_int_configs[CONFIG_COMPRESSION]);
         m_int_configs[CONFIG_COMPRESSION] = 1;
     }
+    m_int_configs[CONFIG_COMPRESSION_FAST_LEVEL_SIZE] = ConfigMgr::GetIntDefault("Compression.FastLevelSize", 16384);
+    m_int_configs[CONFIG_COMPRESSION_FAST_LEVEL_DIFF] = ConfigMgr::GetIntDefault("Compression.FastLevelDiff", 150);
     m_bool_configs[CONFIG_ADDON_CHANNEL] = ConfigMgr::GetBoolDefault("AddonChannel", true);
     m_bool_configs[CONFIG_CLEAN_CHARACTER_DB] = ConfigMgr::GetBoolDefault("CleanCharacterDB", false);
     m_int_configs[CONFIG_PERSISTENT_CHARACTER_CLEAN_FLAGS] = ConfigMgr::GetIntDefault("PersistentCharacterCleanFlags", 0);
@@ -1266,6 +1271,7 @@ void World::LoadConfigSettings(bool reload)
     }
 
     m_bool_configs[CONFIG_ENABLE_MMAPS] = ConfigMgr::GetBoolDefault("mmap.enablePathFinding", true);
+    m_bool_configs[CONFIG_MMAP_ASYNC_PATHS] = ConfigMgr::GetBoolDefault("mmap.asyncPaths", false);
     
 
     m_bool_configs[CONFIG_ENABLE_QUEST]              = ConfigMgr::GetBoolDefault("loading.quest", true);
@@ -1290,6 +1296,11 @@ void World::LoadConfigSettings(bool reload)
 
     VMAP::VMapFactory::createOrGetVMapManager()->setEnableLineOfSightCalc(enableLOS);
     VMAP::VMapFactory::createOrGetVMapManager()->setEnableHeightCalc(enableHeight);
+
+    if (VMAP::VMapManager2* vmmgr2 = dynamic_cast<VMAP::VMapManager2*>(VMAP::VMapFactory::createOrGetVMapManager()))
+        vmmgr2->SetMemoryMappedModels(ConfigMgr::GetBoolDefault("vmap.memoryMapped", false));
+
+    MMAP::MMapFactory::createOrGetMMapManager()->SetMemoryMappedTiles(ConfigMgr::GetBoolDefault("mmap.memoryMapped", false));
     sLog->outInfo(LOG_FILTER_SERVER_LOADING, "VMap support included. LineOfSight:%i, getHeight:%i, indoorCheck:%i", enableLOS, enableHeight, enableIndoor);
     sLog->outInfo(LOG_FILTER_SERVER_LOADING, "VMap data directory is: %svmaps", m_dataPath.c_str());
 
@@ -1314,6 +1325,11 @@ void World::LoadConfigSettings(bool reload)
     m_int_configs[CONFIG_INTERVAL_LOG_UPDATE] = ConfigMgr::GetIntDefault("RecordUpdateTimeDiffInterval", 60000);
     m_int_configs[CONFIG_MIN_LOG_UPDATE] = ConfigMgr::GetIntDefault("MinRecordUpdateTimeDiff", 100);
     m_int_configs[CONFIG_NUMTHREADS] = ConfigMgr::GetIntDefault("MapUpdate.Threads", 1);
+    m_int_configs[CONFIG_MMAP_ASYNC_PATH_THREADS] = ConfigMgr::GetIntDefault("mmap.asyncPathThreads", 0);
+    m_int_configs[CONFIG_GRID_PREFETCH_THREADS] = ConfigMgr::GetIntDefault("MapUpdate.GridPrefetch.Threads", 0);
+    m_int_configs[CONFIG_GRID_PREFETCH_LOOKAHEAD] = ConfigMgr::GetIntDefault("MapUpdate.GridPrefetch.LookAhead", 5000);
+    m_int_configs[CONFIG_STARTUP_LOADER_THREADS] = ConfigMgr::GetIntDefault("Startup.LoaderThreads", 4);
+    QuerySnapshot::SetDirectory(ConfigMgr::GetStringDefault("Startup.SnapshotDir", ""));
     m_int_configs[CONFIG_MAX_RESULTS_LOOKUP_COMMANDS] = ConfigMgr::GetIntDefault("Command.LookupMaxResults", 0);
 
     // chat logging
@@ -1628,88 +1644,51 @@ void World::SetInitialWorldSettings()
     sLog->outInfo(LOG_FILTER_SERVER_LOADING, "Loading instances...");
     sInstanceSaveMgr->LoadInstances();
 
-    uint32 oldMSTime = getMSTime();
-
     sLog->outInfo(LOG_FILTER_SERVER_LOADING, "Loading Creature Texts...");
     sCreatureTextMgr->LoadCreatureTexts();
 
-    if (sWorld->getBoolConfig(CONFIG_ENABLE_LOCALES))
-    {
-        sLog->outInfo(LOG_FILTER_SERVER_LOADING, "Loading Localization strings...");
-        sObjectMgr->LoadCreatureLocales();
-        sObjectMgr->LoadGameObjectLocales();
-        sObjectMgr->LoadQuestLocales();
-        sObjectMgr->LoadNpcTextLocales();
-        sObjectMgr->LoadPageTextLocales();
-        sObjectMgr->LoadGossipMenuItemsLocales();
-        sObjectMgr->LoadPointOfInterestLocales();
-
-        sLog->outInfo(LOG_FILTER_SERVER_LOADING, "Loading Creature Text Locales...");
-        sCreatureTextMgr->LoadCreatureTextLocales();
-    }
-
     sObjectMgr->SetDBCLocaleIndex(GetDefaultDbcLocale());        // Get once for all the locale index of DBC language (console/broadcasts)
-    sLog->outInfo(LOG_FILTER_SERVER_LOADING, ">> Localization strings loaded in %u ms", GetMSTimeDiffToNow(oldMSTime));
-
-    sLog->outInfo(LOG_FILTER_SERVER_LOADING, "Loading Page Texts...");
-    sObjectMgr->LoadPageTexts();
-
-    sLog->outInfo(LOG_FILTER_SERVER_LOADING, "Loading Game Object Templates...");         // must be after LoadPageTexts
-    sObjectMgr->LoadGameObjectTemplate();
-
-    sLog->outInfo(LOG_FILTER_SERVER_LOADING, "Loading Garrison Plot Building Content...");
-    sObjectMgr->LoadGarrisonPlotBuildingContent();
-
-    sLog->outInfo(LOG_FILTER_SERVER_LOADING, "Loading Npc Recipes Conditions...");
-    sObjectMgr->LoadNpcRecipesConditions();
-
-    sLog->outInfo(LOG_FILTER_SERVER_LOADING, "Loading Transport templates...");
-    sTransportMgr->LoadTransportTemplates();
-
-    sLog->outInfo(LOG_FILTER_SERVER_LOADING, "Loading Spell Rank Data...");
-    sSpellMgr->LoadSpellRanks();
-
-    sLog->outInfo(LOG_FILTER_SERVER_LOADING, "Loading Spell Required Data...");
-    sSpellMgr->LoadSpellRequired();
-
-    sLog->outInfo(LOG_FILTER_SERVER_LOADING, "Loading Spell Group types...");
-    sSpellMgr->LoadSpellGroups();
 
-    sLog->outInfo(LOG_FILTER_SERVER_LOADING, "Loading Spell Learn Skills...");
-    sSpellMgr->LoadSpellLearnSkills();                           // must be after LoadSpellRanks
-
-    sLog->outInfo(LOG_FILTER_SERVER_LOADING, "Loading Spell Learn Spells...");
-    sSpellMgr->LoadSpellLearnSpells();
-
-    sLog->outInfo(LOG_FILTER_SERVER_LOADING, "Loading Spell Proc Event conditions...");
-    sSpellMgr->LoadSpellProcEvents();
-
-    sLog->outInfo(LOG_FILTER_SERVER_LOADING, "Loading Spell Proc conditions and data...");
-    sSpellMgr->LoadSpellProcs();
-
-    sLog->outInfo(LOG_FILTER_SERVER_LOADING, "Loading Spell Bonus Data...");
-    sSpellMgr->LoadSpellBonusess();
-
-    sLog->outInfo(LOG_FILTER_SERVER_LOADING, "Loading Aggro Spells Definitions...");
-    sSpellMgr->LoadSpellThreats();
-
-    sLog->outInfo(LOG_FILTER_SERVER_LOADING, "Loading Spell Group Stack Rules...");
-    sSpellMgr->LoadSpellGroupStackRules();
-
-    sLog->outInfo(LOG_FILTER_SERVER_LOADING, "Loading forbidden spells...");
-    sSpellMgr->LoadForbiddenSpells();
-
-    sLog->outInfo(LOG_FILTER_SERVER_LOADING, "Loading Spell Phase Dbc Info...");
-    sObjectMgr->LoadSpellPhaseInfo();
-
-    sLog->outInfo(LOG_FILTER_SERVER_LOADING, "Loading NPC Texts...");
-    sObjectMgr->LoadGossipText();
+    ///- Locales, texts and spell data, each loader only fills its own store
+    sLog->outInfo(LOG_FILTER_SERVER_LOADING, "Loading localization strings, texts and spell data...");
+    {
+        StartupTaskGraph l_Graph("Localization strings, texts and spell data");
 
-    sLog->outInfo(LOG_FILTER_SERVER_LOADING, "Loading Enchant Spells Proc datas...");
-    sSpellMgr->LoadSpellEnchantProcData();
+        if (sWorld->getBoolConfig(CONFIG_ENABLE_LOCALES))
+        {
+            l_Graph.Add("CreatureLocales",          [] { sObjectMgr->LoadCreatureLocales();             });
+            l_Graph.Add("GameObjectLocales",        [] { sObjectMgr->LoadGameObjectLocales();           });
+            l_Graph.Add("QuestLocales",             [] { sObjectMgr->LoadQuestLocales();                });
+            l_Graph.Add("NpcTextLocales",           [] { sObjectMgr->LoadNpcTextLocales();              });
+            l_Graph.Add("PageTextLocales",          [] { sObjectMgr->LoadPageTextLocales();             });
+            l_Graph.Add("GossipMenuItemsLocales",   [] { sObjectMgr->LoadGossipMenuItemsLocales();      });
+            l_Graph.Add("PointOfInterestLocales",   [] { sObjectMgr->LoadPointOfInterestLocales();      });
+            l_Graph.Add("CreatureTextLocales",      [] { sCreatureTextMgr->LoadCreatureTextLocales();   });
+        }
 
-    sLog->outInfo(LOG_FILTER_SERVER_LOADING, "Loading Item Random Enchantments Table...");
-    LoadRandomEnchantmentsTable();
+        l_Graph.Add("PageTexts",                    [] { sObjectMgr->LoadPageTexts();                   });
+        l_Graph.Add("GameObjectTemplates",          [] { sObjectMgr->LoadGameObjectTemplate();          }, { "PageTexts" });
+        l_Graph.Add("GarrisonPlotBuildingContent",  [] { sObjectMgr->LoadGarrisonPlotBuildingContent(); });
+        l_Graph.Add("NpcRecipesConditions",         [] { sObjectMgr->LoadNpcRecipesConditions();        });
+        l_Graph.Add("TransportTemplates",           [] { sTransportMgr->LoadTransportTemplates();       }, { "GameObjectTemplates" });
+        l_Graph.Add("SpellRanks",                   [] { sSpellMgr->LoadSpellRanks();                   });
+        l_Graph.Add("SpellRequired",                [] { sSpellMgr->LoadSpellRequired();                }, { "SpellRanks" });
+        l_Graph.Add("SpellGroups",                  [] { sSpellMgr->LoadSpellGroups();                  }, { "SpellRanks" });
+        l_Graph.Add("SpellLearnSkills",             [] { sSpellMgr->LoadSpellLearnSkills();             }, { "SpellRanks" });
+        l_Graph.Add("SpellLearnSpells",             [] { sSpellMgr->LoadSpellLearnSpells();             });
+        l_Graph.Add("SpellProcEvents",              [] { sSpellMgr->LoadSpellProcEvents();              });
+        l_Graph.Add("SpellProcs",                   [] { sSpellMgr->LoadSpellProcs();                   }, { "SpellRanks" });
+        l_Graph.Add("SpellBonuses",                 [] { sSpellMgr->LoadSpellBonusess();                });
+        l_Graph.Add("SpellThreats",                 [] { sSpellMgr->LoadSpellThreats();                 });
+        l_Graph.Add("SpellGroupStackRules",         [] { sSpellMgr->LoadSpellGroupStackRules();         }, { "SpellGroups" });
+        l_Graph.Add("ForbiddenSpells",              [] { sSpellMgr->LoadForbiddenSpells();              });
+        l_Graph.Add("SpellPhaseInfo",               [] { sObjectMgr->LoadSpellPhaseInfo();              });
+        l_Graph.Add("GossipTexts",                  [] { sObjectMgr->LoadGossipText();                  });
+        l_Graph.Add("SpellEnchantProcData",         [] { sSpellMgr->LoadSpellEnchantProcData();         });
+        l_Graph.Add("RandomEnchantments",           [] { LoadRandomEnchantmentsTable();                 });
+
+        l_Graph.Run(getIntConfig(CONFIG_STARTUP_LOADER_THREADS));
+    }
 
     sLog->outInfo(LOG_FILTER_SERVER_LOADING, "Loading Disables");
     DisableMgr::LoadDisables();                                                             // must be before loading quests and items
@@ -2184,6 +2163,10 @@ void World::SetInitialWorldSettings()
     uint32 nextGameEvent = sGameEventMgr->StartSystem();
     m_timers[WUPDATE_EVENTS].SetInterval(nextGameEvent);    //depend on next event
 
+    ///- Initial pool and game event spawns are done, those added from now on (pool rotations, game events, GM commands) go to the overlay of the spawn index
+    sLog->outInfo(LOG_FILTER_SERVER_LOADING, "Freezing spawn index...");
+    sObjectMgr->FreezeSpawnIndex();
+
 #ifndef CROSS
     // Delete all characters which have been deleted X days before
     Player::DeleteOldCharacters();
@@ -2781,6 +2764,8 @@ void World::SendGlobalMessage(WorldPacket* packet, WorldSession* self, uint32 te
         }
     }
 #else
+    SharedWorldPacket l_Packet(*packet);
+
     SessionMap::const_iterator itr;
     for (itr = m_sessions.begin(); itr != m_sessions.end(); ++itr)
     {
@@ -2790,7 +2775,7 @@ void World::SendGlobalMessage(WorldPacket* packet, WorldSession* self, uint32 te
             itr->second != self &&
             (team == 0 || itr->second->GetPlayer()->GetTeam() == team))
         {
-            itr->second->SendPacket(packet);
+            itr->second->SendPacket(l_Packet);
         }
     }
 #endif
@@ -215,6 +215,7 @@ enum WorldBoolConfigs
     CONFIG_IGNORE_RESEARCH_SITE,
 #endif
     CONFIG_ENABLE_MMAPS,
+    CONFIG_MMAP_ASYNC_PATHS,
     CONFIG_ENABLE_QUEST,
     CONFIG_ENABLE_LOOTS,
     CONFIG_ENABLE_LOCALES,
@@ -251,6 +252,8 @@ enum WorldFloatConfigs
 enum WorldIntConfigs
 {
     CONFIG_COMPRESSION = 0,
+    CONFIG_COMPRESSION_FAST_LEVEL_SIZE,
+    CONFIG_COMPRESSION_FAST_LEVEL_DIFF,
     CONFIG_INTERVAL_SAVE,
     CONFIG_INTERVAL_GRIDCLEAN,
     CONFIG_INTERVAL_MAPUPDATE,
@@ -368,6 +371,10 @@ enum WorldIntConfigs
     CONFIG_ENABLE_SINFO_LOGIN,
     CONFIG_PLAYER_ALLOW_COMMANDS,
     CONFIG_NUMTHREADS,
+    CONFIG_MMAP_ASYNC_PATH_THREADS,
+    CONFIG_GRID_PREFETCH_THREADS,
+    CONFIG_GRID_PREFETCH_LOOKAHEAD,
+    CONFIG_STARTUP_LOADER_THREADS,
     CONFIG_LOGDB_CLEARINTERVAL,
     CONFIG_LOGDB_CLEARTIME,
     CONFIG_CLIENTCACHE_VERSION,
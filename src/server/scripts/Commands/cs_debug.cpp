@@ -27,6 +27,7 @@ EndScriptData */
 #include "DisableMgr.h"
 #include "Group.h"
 #include "LFGMgr.h"
+#include "LootMgr.h"
 #include "World.h"
 
 #ifndef CROSS
@@ -197,6 +198,7 @@ class debug_commandscript: public CommandScript
                 { "cleardr",                     SEC_ADMINISTRATOR,  false, &HandleDebugCancelDiminishingReturn,     "", NULL },
                 { "scenario",                    SEC_ADMINISTRATOR,  false, &HandleDebugScenarioCommand,             "", NULL },
                 { "dailypoint",                  SEC_ADMINISTRATOR,  false, &HandleDebugDailyPointCommand,           "", NULL },
+                { "lootroll",                    SEC_ADMINISTRATOR,  true,  &HandleDebugLootRollCommand,             "", NULL },
                 { NULL,                          SEC_PLAYER,         false, NULL,                                    "", NULL }
             };
             static ChatCommand commandTable[] =
@@ -208,6 +210,61 @@ class debug_commandscript: public CommandScript
             return commandTable;
         }
 
+        /// .debug lootroll <loot table> <loot id> <group id> [rolls]
+        /// Rolls a loot group with the sequential walk and with the alias table, and tells whether both give the same distribution
+        static bool HandleDebugLootRollCommand(ChatHandler* p_Handler, char const* p_Args)
+        {
+            char* l_TableStr = strtok((char*)p_Args, " ");
+            char* l_LootIdStr = strtok(NULL, " ");
+            char* l_GroupIdStr = strtok(NULL, " ");
+            char* l_RollsStr = strtok(NULL, " ");
+
+            if (!l_TableStr || !l_LootIdStr || !l_GroupIdStr)
+                return false;
+
+            LootStore const* l_Stores[] =
+            {
+                &LootTemplates_Creature, &LootTemplates_Disenchant, &LootTemplates_Fishing, &LootTemplates_Gameobject,
+                &LootTemplates_Item, &LootTemplates_Mail, &LootTemplates_Milling, &LootTemplates_Pickpocketing,
+                &LootTemplates_Prospecting, &LootTemplates_Reference, &LootTemplates_Skinning, &LootTemplates_Spell
+            };
+
+            LootStore const* l_Store = nullptr;
+            for (LootStore const* l_Itr : l_Stores)
+            {
+                if (!strcmp(l_Itr->GetName(), l_TableStr))
+                    l_Store = l_Itr;
+            }
+
+            if (!l_Store)
+            {
+                p_Handler->PSendSysMessage("Unknown loot table %s, expected creature_loot_template, gameobject_loot_template, reference_loot_template...", l_TableStr);
+                p_Handler->SetSentErrorMessage(true);
+                return false;
+            }
+
+            uint32 l_LootId = atoi(l_LootIdStr);
+            uint32 l_GroupId = atoi(l_GroupIdStr);
+            uint32 l_Rolls = l_RollsStr ? atoi(l_RollsStr) : 1000000;
+
+            LootTemplate const* l_Template = l_Store->GetLootFor(l_LootId);
+            LootRollComparison l_Result;
+
+            if (!l_Template || l_GroupId > 255 || !l_Rolls || !l_Template->CompareGroupRolls(uint8(l_GroupId), l_Rolls, l_Result))
+            {
+                p_Handler->PSendSysMessage("No group %u in %s for loot id %u", l_GroupId, l_Store->GetName(), l_LootId);
+                p_Handler->SetSentErrorMessage(true);
+                return false;
+            }
+
+            for (uint32 l_I = 0; l_I < l_Result.OutcomeItems.size(); ++l_I)
+                p_Handler->PSendSysMessage("Item %u : %u sequential, %u alias table", l_Result.OutcomeItems[l_I], l_Result.SequentialCounts[l_I], l_Result.AliasCounts[l_I]);
+
+            p_Handler->PSendSysMessage("%u rolls, chi-square %.3f with %u degrees of freedom, p-value %.4f : %s", l_Rolls, l_Result.ChiSquare, l_Result.Degrees, l_Result.PValue,
+                l_Result.PValue < 0.001 ? "the distributions differ" : "same distribution");
+            return true;
+        }
+
         static bool HandleDebugCancelDiminishingReturn(ChatHandler* handler, char const* args)
         {
             Unit* unit = handler->getSelectedUnit();
@@ -470,6 +470,11 @@ class misc_commandscript: public CommandScript
                 cell.GridX(), cell.GridY(), cell.CellX(), cell.CellY(), object->GetInstanceId(),
                 zoneX, zoneY, groundZ, floorZ, haveMap, haveVMap);
 
+            DynamicTreeStats l_TreeStats;
+            map->GetDynamicTreeStats(l_TreeStats);
+            handler->PSendSysMessage("Gameobject collision : %u models (tree height %u), " UI64FMTD " inserts, " UI64FMTD " removes, " UI64FMTD " moves (" UI64FMTD " reinserted), " UI64FMTD " rotations, " UI64FMTD " us spent, slowest change %u us",
+                l_TreeStats.ModelCount, l_TreeStats.Height, l_TreeStats.InsertCount, l_TreeStats.RemoveCount, l_TreeStats.MoveCount, l_TreeStats.ReinsertCount, l_TreeStats.RotationCount, l_TreeStats.ChangeTime, l_TreeStats.MaxChangeTime);
+
 #ifdef WIN32
             char   l_Buffer[120];
             char * lPtrData = nullptr;
@@ -19,6 +19,9 @@ EndScriptData */
 #include "Config.h"
 #include "ObjectAccessor.h"
 #include "MapManager.h"
+#include "SharedWorldPacket.h"
+#include "PacketCompression.h"
+#include "MappedFile.h"
 #include <regex>
 
 class server_commandscript : public CommandScript
@@ -132,6 +135,47 @@ public:
             p_Handler->PSendSysMessage("Callback diff : %u ms", sWorld->GetRecordDiff(RECORD_DIFF_CALLBACK));
         }
 
+        if (!p_Handler->GetSession() || p_Handler->GetSession()->GetSecurity() >= SEC_ADMINISTRATOR)
+        {
+            uint64 l_Hits   = sObjectAccessor->GetValuesUpdateCacheHits();
+            uint64 l_Misses = sObjectAccessor->GetValuesUpdateCacheMisses();
+
+            p_Handler->PSendSysMessage("Values update cache : " UI64FMTD " hits, " UI64FMTD " misses (%.1f%%)", l_Hits, l_Misses, (l_Hits + l_Misses) ? float(l_Hits) * 100.0f / float(l_Hits + l_Misses) : 0.0f);
+
+#ifndef CROSS
+            uint64 l_PayloadBytes = gSentPayloadBytes.load();
+            uint64 l_CopiedBytes  = gSentCopiedBytes.load();
+            uint64 l_Uptime       = std::max<uint64>(sWorld->GetUptime(), 1);
+
+            p_Handler->PSendSysMessage("Packet payload : " UI64FMTD " KB/s sent, " UI64FMTD " KB/s copied (%.1f%%)", l_PayloadBytes / 1024 / l_Uptime, l_CopiedBytes / 1024 / l_Uptime, l_PayloadBytes ? float(l_CopiedBytes) * 100.0f / float(l_PayloadBytes) : 0.0f);
+#endif /* not CROSS */
+
+            /// Top compressed opcodes by CPU time
+            std::vector<std::pair<uint16, PacketCompressionStats>> l_CompressionStats = sPacketCompression->GetStats();
+            for (size_t l_I = 0; l_I < l_CompressionStats.size() && l_I < 5; ++l_I)
+            {
+                PacketCompressionStats const& l_Stats = l_CompressionStats[l_I].second;
+
+                p_Handler->PSendSysMessage("Compression %s : " UI64FMTD " packets, ratio %.2f, " UI64FMTD " ms", GetOpcodeNameForLogging(l_CompressionStats[l_I].first, WOW_SERVER_TO_CLIENT).c_str(), l_Stats.Count,
+                    l_Stats.RawBytes ? float(l_Stats.CompressedBytes) / float(l_Stats.RawBytes) : 0.0f, l_Stats.CpuMicroseconds / 1000);
+            }
+
+            if (uint64 l_SaveCount = gPlayerSaveCount.load())
+                p_Handler->PSendSysMessage("Player saves : " UI64FMTD ", " UI64FMTD " statements per save on average, " UI64FMTD " max", l_SaveCount, gPlayerSaveStatementCount.load() / l_SaveCount, gPlayerSaveMaxStatementCount.load());
+
+            if (uint64 l_MappedSize = MappedFile::GetTotalMappedSize())
+                p_Handler->PSendSysMessage("Mapped vmap / mmap files : " UI64FMTD " MB", l_MappedSize / 1024 / 1024);
+
+            if (sLog->IsBinaryMode())
+                p_Handler->PSendSysMessage("Binary log : " UI64FMTD " records dropped", sLog->GetDroppedRecordCount());
+
+            if (sMapMgr->GetGridPrefetcher()->activated())
+            {
+                GridPrefetcher* l_Prefetcher = sMapMgr->GetGridPrefetcher();
+                p_Handler->PSendSysMessage("Grid prefetch : %u grids prepared, %u terrains and %u spawn lists used", l_Prefetcher->GetPreparedCount(), l_Prefetcher->GetUsedTerrainCount(), l_Prefetcher->GetUsedSpawnsCount());
+            }
+        }
+
         // Can't use sWorld->ShutdownMsg here in case of console command
         if (sWorld->IsShuttingDown())
             p_Handler->PSendSysMessage(LANG_SHUTDOWN_TIMELEFT, secsToTimeString(sWorld->GetShutDownTimeLeft()).c_str());
@@ -22,6 +22,7 @@ class BasicStatementTask : public SQLOperation
         ~BasicStatementTask();
 
         bool Execute();
+        bool IsBatchable() const { return !m_has_result; }
 
     private:
         const char* m_sql;      //- Raw query to be executed
@@ -12,7 +12,9 @@
 #include "MySQLConnection.h"
 #include "MySQLThreading.h"
 
-DatabaseWorker::DatabaseWorker(ACE_Activation_Queue* new_queue, MySQLConnection* con) :
+#include <mysqld_error.h>
+
+DatabaseWorker::DatabaseWorker(SQLOperationQueue* new_queue, MySQLConnection* con) :
 m_queue(new_queue),
 m_conn(con)
 {
@@ -25,18 +27,72 @@ int DatabaseWorker::svc()
     if (!m_queue)
         return -1;
 
-    SQLOperation *request = NULL;
-    while (1)
+    std::vector<SQLOperation*> batch;
+    batch.reserve(MAX_SQL_BATCH_SIZE);
+
+    while (m_queue->DequeueBatch(batch, MAX_SQL_BATCH_SIZE))
     {
-        request = (SQLOperation*)(m_queue->dequeue());
-        if (!request)
-            break;
+        if (batch.size() == 1)
+        {
+            batch[0]->SetConnection(m_conn);
+            batch[0]->call();
+        }
+        else
+            ExecuteBatch(batch);
 
-        request->SetConnection(m_conn);
-        request->call();
+        for (SQLOperation* request : batch)
+            delete request;
 
-        delete request;
+        batch.clear();
     }
 
     return 0;
 }
+
+void DatabaseWorker::ExecuteBatch(std::vector<SQLOperation*>& batch)
+{
+    /// One commit for the whole batch instead of one per statement (autocommit)
+    m_conn->BeginTransaction();
+
+    /// A reconnection loses the transaction, the statement which hit it is then executed again alone in autocommit
+    uint32 reconnectCount = m_conn->GetReconnectCount();
+    size_t executedAlone = batch.size();
+    bool replay = false;
+
+    for (size_t i = 0; i < batch.size(); ++i)
+    {
+        batch[i]->SetConnection(m_conn);
+        bool success = batch[i]->Execute();
+
+        if (m_conn->GetReconnectCount() != reconnectCount)
+        {
+            executedAlone = i;
+            replay = true;
+            break;
+        }
+
+        if (!success && m_conn->GetLastError() == ER_LOCK_DEADLOCK)
+        {
+            /// The deadlock rolled back the whole transaction
+            m_conn->RollbackTransaction();
+            replay = true;
+            break;
+        }
+    }
+
+    if (!replay)
+    {
+        m_conn->CommitTransaction();
+
+        /// Connection lost before the commit, nothing was written
+        if (m_conn->GetReconnectCount() == reconnectCount)
+            return;
+    }
+
+    /// Replay the statements one by one
+    for (size_t i = 0; i < batch.size(); ++i)
+    {
+        if (i != executedAlone)
+            batch[i]->call();
+    }
+}
@@ -10,14 +10,14 @@
 #define _WORKERTHREAD_H
 
 #include <ace/Task.h>
-#include <ace/Activation_Queue.h>
+#include "SQLOperationQueue.h"
 
 class MySQLConnection;
 
 class DatabaseWorker : protected ACE_Task_Base
 {
     public:
-        DatabaseWorker(ACE_Activation_Queue* new_queue, MySQLConnection* con);
+        DatabaseWorker(SQLOperationQueue* new_queue, MySQLConnection* con);
 
         ///- Inherited from ACE_Task_Base
         int svc();
@@ -25,7 +25,11 @@ class DatabaseWorker : protected ACE_Task_Base
 
     private:
         DatabaseWorker() : ACE_Task_Base() {}
-        ACE_Activation_Queue* m_queue;
+
+        /// Execute consecutive one-way statements in a single transaction
+        void ExecuteBatch(std::vector<SQLOperation*>& batch);
+
+        SQLOperationQueue* m_queue;
         MySQLConnection* m_conn;
 };
 
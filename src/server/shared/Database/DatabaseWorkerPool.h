@@ -37,13 +37,11 @@ class DatabaseWorkerPool
     public:
         /* Activity state */
         DatabaseWorkerPool() :
-        _queue(new ACE_Activation_Queue())
+        _queue(new SQLOperationQueue()),
+        _releasedConnections(0),
+        _nextConnection(0)
         {
             memset(_connectionCount, 0, sizeof(_connectionCount));
-            
-            /// Update queue size limit, 16 kb is not enough
-            _queue->queue()->high_water_mark(8 * 1024 * 1024);
-            _queue->queue()->low_water_mark(8 * 1024 * 1024);
 
             WPFatal (mysql_thread_safe(), "Used MySQL library isn't thread-safe.");
         }
@@ -80,6 +78,9 @@ class DatabaseWorkerPool
                 ++_connectionCount[IDX_SYNCH];
             }
 
+            if (res)
+                LoadLowPriorityStatements();
+
             if (res)
                 sLog->outInfo(LOG_FILTER_SQL_DRIVER, "DatabasePool '%s' opened successfully. %u total connections running.", GetDatabaseName(),
                     (_connectionCount[IDX_SYNCH] + _connectionCount[IDX_ASYNC]));
@@ -93,10 +94,10 @@ class DatabaseWorkerPool
         {
             sLog->outInfo(LOG_FILTER_SQL_DRIVER, "Closing down DatabasePool '%s'.", GetDatabaseName());
 
-            //! Shuts down delaythreads for this connection pool by underlying deactivate().
-            //! The next dequeue attempt in the worker thread tasks will result in an error,
+            //! Shuts down delaythreads for this connection pool.
+            //! Workers execute what is still queued, then their next dequeue attempt fails,
             //! ultimately ending the worker thread task.
-            _queue->queue()->close();
+            _queue->Close();
 
             for (uint8 i = 0; i < _connectionCount[IDX_ASYNC]; ++i)
             {
@@ -117,7 +118,7 @@ class DatabaseWorkerPool
             for (uint8 i = 0; i < _connectionCount[IDX_SYNCH]; ++i)
                 _connections[IDX_SYNCH][i]->Close();
 
-            //! Deletes the ACE_Activation_Queue object and its underlying ACE_Message_Queue
+            //! Deletes the operation queue
             delete _queue;
 
             sLog->outInfo(LOG_FILTER_SQL_DRIVER, "All connections on DatabasePool '%s' closed.", GetDatabaseName());
@@ -135,7 +136,7 @@ class DatabaseWorkerPool
                 return;
 
             BasicStatementTask* task = new BasicStatementTask(sql);
-            Enqueue(task);
+            Enqueue(task, IsLowPriorityQuery(sql) ? SQL_PRIORITY_LOW : SQL_PRIORITY_NORMAL);
         }
 
         //! Enqueues a one-way SQL operation in string format -with variable args- that will be executed asynchronously.
@@ -166,8 +167,12 @@ class DatabaseWorkerPool
                 return;
             }
 
+            SQLOperationPriority priority = SQL_PRIORITY_NORMAL;
+            if (stmt->getIndex() < _lowPriorityStatements.size() && _lowPriorityStatements[stmt->getIndex()])
+                priority = SQL_PRIORITY_LOW;
+
             PreparedStatementTask* task = new PreparedStatementTask(stmt);
-            Enqueue(task);
+            Enqueue(task, priority);
         }
 
         /**
@@ -183,7 +188,7 @@ class DatabaseWorkerPool
 
             T* t = GetFreeConnection();
             t->Execute(sql);
-            t->Unlock();
+            ReleaseConnection(t);
         }
 
         //! Directly executes a one-way SQL operation in string format -with variable args-, that will block the calling thread until finished.
@@ -216,7 +221,7 @@ class DatabaseWorkerPool
 
             T* t = GetFreeConnection();
             t->Execute(stmt);
-            t->Unlock();
+            ReleaseConnection(t);
 
             //! Delete proxy-class. Not needed anymore
             delete stmt;
@@ -234,7 +239,7 @@ class DatabaseWorkerPool
 
             T* t = GetFreeConnection();
             bool result = t->Execute(stmt);
-            t->Unlock();
+            ReleaseConnection(t);
 
             //! Delete proxy-class. Not needed anymore
             delete stmt;
@@ -253,7 +258,7 @@ class DatabaseWorkerPool
                 conn = GetFreeConnection();
 
             ResultSet* result = conn->Query(sql);
-            conn->Unlock();
+            ReleaseConnection(conn);
             if (!result || !result->GetRowCount())
             {
                 delete result;
@@ -310,7 +315,7 @@ class DatabaseWorkerPool
 
             T* t = GetFreeConnection();
             PreparedResultSet* ret = t->Query(stmt);
-            t->Unlock();
+            ReleaseConnection(t);
 
             //! Delete proxy-class. Not needed anymore
             delete stmt;
@@ -426,17 +431,25 @@ class DatabaseWorkerPool
         bool DirectCommitTransaction(SQLTransaction& transaction)
         {
             MySQLConnection* con = GetFreeConnection();
+            uint32 reconnectCount = con->GetReconnectCount();
             if (con->ExecuteTransaction(transaction))
             {
-                con->Unlock();      // OK, operation succesful
+                ReleaseConnection(con);     // OK, operation succesful
                 return true;
             }
 
             bool error = false;
 
+            //! A reconnection rolled back the queries executed before it, replay the whole transaction on the new connection
+            for (uint8 i = 0; i < 5 && !error && con->GetReconnectCount() != reconnectCount; ++i)
+            {
+                reconnectCount = con->GetReconnectCount();
+                error = con->ExecuteTransaction(transaction);
+            }
+
             //! Handle MySQL Errno 1213 without extending deadlock to the core itself
             //! TODO: More elegant way
-            if (con->GetLastError() == 1213)
+            if (!error && con->GetLastError() == 1213)
             {
                 uint8 loopBreaker = 5;
                 for (uint8 i = 0; i < loopBreaker; ++i)
@@ -452,7 +465,7 @@ class DatabaseWorkerPool
             //! Clean up now.
             transaction->Cleanup();
 
-            con->Unlock();
+            ReleaseConnection(con);
             return error;
         }
 
@@ -520,7 +533,7 @@ class DatabaseWorkerPool
                 if (t->LockIfReady())
                 {
                     t->Ping();
-                    t->Unlock();
+                    ReleaseConnection(t);
                 }
             }
 
@@ -540,30 +553,79 @@ class DatabaseWorkerPool
             return mysql_real_escape_string(_connections[IDX_SYNCH][0]->GetHandle(), to, from, length);
         }
 
-        void Enqueue(SQLOperation* op)
+        void Enqueue(SQLOperation* op, SQLOperationPriority priority = SQL_PRIORITY_NORMAL)
+        {
+            _queue->Enqueue(op, priority);
+        }
+
+        //! Log inserts are executed after the other operations (saves, login queries...)
+        static bool IsLowPriorityQuery(char const* sql)
         {
-            _queue->enqueue(op);
+            return !strnicmp(sql, "INSERT INTO log", 15) || !strnicmp(sql, "INSERT INTO `log", 16);
+        }
+
+        //! Flag the prepared statements inserting logs, read from the statements prepared on the connections
+        void LoadLowPriorityStatements()
+        {
+            T* t = _connections[IDX_ASYNC].empty() ? _connections[IDX_SYNCH][0] : _connections[IDX_ASYNC][0];
+
+            for (PreparedStatementMap::const_iterator itr = t->m_queries.begin(); itr != t->m_queries.end(); ++itr)
+            {
+                if (!IsLowPriorityQuery(itr->second.first))
+                    continue;
+
+                if (_lowPriorityStatements.size() <= itr->first)
+                    _lowPriorityStatements.resize(itr->first + 1, false);
+
+                _lowPriorityStatements[itr->first] = true;
+            }
         }
 
         //! Gets a free connection in the synchronous connection pool.
-        //! Caller MUST call t->Unlock() after touching the MySQL context to prevent deadlocks.
+        //! Caller MUST call ReleaseConnection(t) after touching the MySQL context to prevent deadlocks.
         T* GetFreeConnection()
         {
-            uint8 i = 0;
             size_t num_cons = _connectionCount[IDX_SYNCH];
             //! Block forever until a connection is free
             for (;;)
             {
-                T* t = _connections[IDX_SYNCH][++i % num_cons];
-                //! Must be matched with t->Unlock() or you will get deadlocks
-                if (t->LockIfReady())
-                    return t;
+                uint64 released;
+                {
+                    std::lock_guard<std::mutex> lock(_freeConnectionLock);
+                    released = _releasedConnections;
+                }
+
+                for (size_t i = 0; i < num_cons; ++i)
+                {
+                    T* t = _connections[IDX_SYNCH][_nextConnection++ % num_cons];
+                    //! Must be matched with ReleaseConnection(t) or you will get deadlocks
+                    if (t->LockIfReady())
+                        return t;
+                }
+
+                //! All connections are busy, sleep until one is released instead of spinning
+                std::unique_lock<std::mutex> lock(_freeConnectionLock);
+                while (_releasedConnections == released)
+                    _freeConnectionCondition.wait(lock);
             }
 
             //! This will be called when Celine Dion learns to sing
             return NULL;
         }
 
+        //! Give back a connection taken with GetFreeConnection or LockIfReady
+        void ReleaseConnection(MySQLConnection* t)
+        {
+            t->Unlock();
+
+            {
+                std::lock_guard<std::mutex> lock(_freeConnectionLock);
+                ++_releasedConnections;
+            }
+
+            _freeConnectionCondition.notify_one();
+        }
+
         char const* GetDatabaseName() const
         {
             return _connectionInfo.database.c_str();
@@ -577,10 +639,15 @@ class DatabaseWorkerPool
             IDX_SIZE
         };
 
-        ACE_Activation_Queue*           _queue;             //! Queue shared by async worker threads.
+        SQLOperationQueue*              _queue;             //! Queue shared by async worker threads.
+        std::vector<bool>               _lowPriorityStatements;         //! Prepared statements enqueued with SQL_PRIORITY_LOW
         std::vector<T*>                 _connections[IDX_SIZE];
         uint32                          _connectionCount[IDX_SIZE];       //! Counter of MySQL connections;
         MySQLConnectionInfo             _connectionInfo;
+        std::mutex                      _freeConnectionLock;            //! Protects _releasedConnections
+        std::condition_variable         _freeConnectionCondition;       //! Signaled when a synchronous connection is released
+        uint64                          _releasedConnections;           //! Number of connections released, lets waiters detect a release
+        std::atomic<uint32>             _nextConnection;                //! Round robin start for GetFreeConnection
 };
 
 #endif
@@ -14,6 +14,7 @@ Field::Field()
     data.type = MYSQL_TYPE_NULL;
     data.length = 0;
     data.raw = false;
+    data.decoding = FIELD_DECODED_NONE;
 }
 
 Field::~Field()
@@ -28,22 +29,52 @@ void Field::SetByteValue(void* newValue, enum_field_types newType, uint32 length
     data.length = length;
     data.type = newType;
     data.raw = true;
+    data.decoding = FIELD_DECODED_NONE;
 }
 
-void Field::SetStructuredValue(char* newValue, enum_field_types newType)
+void Field::SetTextValue(char const* newValue, enum_field_types newType, uint32 length)
 {
-    if (data.value)
-        CleanUp();
+    // This value stores somewhat structured data, numeric columns are converted here once instead of in every getter
+    data.value = const_cast<char*>(newValue);
+    data.length = newValue ? length : 0;
+    data.type = newType;
+    data.raw = false;
+    data.decoding = FIELD_DECODED_NONE;
 
-    // This value stores somewhat structured data that needs function style casting
-    if (newValue)
+    if (!newValue)
+        return;
+
+    switch (newType)
     {
-        size_t size = strlen(newValue);
-        data.value = new char [size+1];
-        strcpy((char*)data.value, newValue);
-        data.length = size;
-    }
+        case MYSQL_TYPE_TINY:
+        case MYSQL_TYPE_SHORT:
+        case MYSQL_TYPE_YEAR:
+        case MYSQL_TYPE_INT24:
+        case MYSQL_TYPE_LONG:
+        case MYSQL_TYPE_LONGLONG:
+        {
+            char const* digit = newValue;
+            bool negative = *digit == '-';
+            if (negative || *digit == '+')
+                ++digit;
 
-    data.type = newType;
-    data.raw = false;
+            // Unsigned BIGINT values above INT64_MAX keep their bits
+            uint64 value = 0;
+            for (; *digit >= '0' && *digit <= '9'; ++digit)
+                value = value * 10 + uint64(*digit - '0');
+
+            data.number.integer = negative ? int64(0 - value) : int64(value);
+            data.decoding = FIELD_DECODED_INTEGER;
+            break;
+        }
+        case MYSQL_TYPE_FLOAT:
+        case MYSQL_TYPE_DOUBLE:
+        case MYSQL_TYPE_DECIMAL:
+        case MYSQL_TYPE_NEWDECIMAL:
+            data.number.real = atof(newValue);
+            data.decoding = FIELD_DECODED_REAL;
+            break;
+        default:
+            break;
+    }
 }
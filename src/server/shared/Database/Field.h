@@ -13,6 +13,7 @@
 #include "Log.h"
 
 #include <mysql.h>
+#include <type_traits>
 
 /// |   MySQL type           |  method to use                         |
 /// |------------------------|----------------------------------------|
@@ -61,7 +62,7 @@ class Field
 
             if (data.raw)
                 return *reinterpret_cast<uint8*>(data.value);
-            return static_cast<uint8>(atol((char*)data.value));
+            return GetTextNumber<uint8>();
         }
 
         int8 GetInt8() const
@@ -80,7 +81,7 @@ class Field
 
             if (data.raw)
                 return *reinterpret_cast<int8*>(data.value);
-            return static_cast<int8>(atol((char*)data.value));
+            return GetTextNumber<int8>();
         }
 
         uint16 GetUInt16() const
@@ -99,7 +100,7 @@ class Field
 
             if (data.raw)
                 return *reinterpret_cast<uint16*>(data.value);
-            return static_cast<uint16>(atol((char*)data.value));
+            return GetTextNumber<uint16>();
         }
 
         int16 GetInt16() const
@@ -118,7 +119,7 @@ class Field
 
             if (data.raw)
                 return *reinterpret_cast<int16*>(data.value);
-            return static_cast<int16>(atol((char*)data.value));
+            return GetTextNumber<int16>();
         }
 
         uint32 GetUInt32() const
@@ -137,7 +138,7 @@ class Field
 
             if (data.raw)
                 return *reinterpret_cast<uint32*>(data.value);
-            return static_cast<uint32>(atol((char*)data.value));
+            return GetTextNumber<uint32>();
         }
 
         int32 GetInt32() const
@@ -156,7 +157,7 @@ class Field
 
             if (data.raw)
                 return *reinterpret_cast<int32*>(data.value);
-            return static_cast<int32>(atol((char*)data.value));
+            return GetTextNumber<int32>();
         }
 
         uint64 GetUInt64() const
@@ -175,7 +176,7 @@ class Field
 
             if (data.raw)
                 return *reinterpret_cast<uint64*>(data.value);
-            return static_cast<uint64>(atol((char*)data.value));
+            return GetTextNumber<uint64>();
         }
 
         int64 GetInt64() const
@@ -194,7 +195,7 @@ class Field
 
             if (data.raw)
                 return *reinterpret_cast<int64*>(data.value);
-            return static_cast<int64>(strtol((char*)data.value, NULL, 10));
+            return GetTextNumber<int64>();
         }
 
         float GetFloat() const
@@ -213,7 +214,7 @@ class Field
 
             if (data.raw)
                 return *reinterpret_cast<float*>(data.value);
-            return static_cast<float>(atof((char*)data.value));
+            return GetTextNumber<float>();
         }
 
         double GetDouble() const
@@ -232,7 +233,7 @@ class Field
 
             if (data.raw)
                 return *reinterpret_cast<double*>(data.value);
-            return static_cast<double>(atof((char*)data.value));
+            return GetTextNumber<double>();
         }
 
         char const* GetCString() const
@@ -269,6 +270,11 @@ class Field
             return data.length;
         }
 
+        bool IsNull() const
+        {
+            return data.value == NULL;
+        }
+
         struct Metadata
         {
             char const* TableName;
@@ -287,10 +293,16 @@ class Field
         #endif
         struct
         {
-            uint32 length;          // Length (prepared strings only)
+            uint32 length;          // Length
             void* value;            // Actual data in memory
             enum_field_types type;  // Field type
             bool raw;               // Raw bytes? (Prepared statement or ad hoc)
+            uint8 decoding;         // FieldDecoding of a text value
+            union
+            {
+                int64 integer;
+                double real;
+            } number;               // Text value of a numeric column, converted once when the row is fetched
          } data;
         #if defined(__GNUC__)
         #pragma pack()
@@ -299,14 +311,35 @@ class Field
         #endif
 
         void SetByteValue(void* newValue, enum_field_types newType, uint32 length);
-        void SetStructuredValue(char* newValue, enum_field_types newType);
+        /// Text value of an ad hoc query or of a snapshot, not copied: it must live until the next row is fetched
+        void SetTextValue(char const* newValue, enum_field_types newType, uint32 length);
 
         void CleanUp()
         {
-            // Field does not own the data if fetched with prepared statement
-            if (!data.raw)
-                delete[] ((char*)data.value);
+            // Field never owns the data, it belongs to the result set
             data.value = NULL;
+            data.decoding = FIELD_DECODED_NONE;
+        }
+
+        enum FieldDecoding
+        {
+            FIELD_DECODED_NONE,     ///< Raw bytes, or text parsed by each getter (strings, BIT...)
+            FIELD_DECODED_INTEGER,
+            FIELD_DECODED_REAL
+        };
+
+        /// Numeric value of a text field, the getters keep the atol/atof conversions between integers and reals
+        template<class T> T GetTextNumber() const
+        {
+            switch (data.decoding)
+            {
+                case FIELD_DECODED_INTEGER:
+                    return std::is_floating_point<T>::value ? static_cast<T>(static_cast<double>(data.number.integer)) : static_cast<T>(data.number.integer);
+                case FIELD_DECODED_REAL:
+                    return std::is_floating_point<T>::value ? static_cast<T>(data.number.real) : static_cast<T>(static_cast<int64>(data.number.real));
+                default:
+                    return std::is_floating_point<T>::value ? static_cast<T>(atof((char*)data.value)) : static_cast<T>(atol((char*)data.value));
+            }
         }
 
         static size_t SizeForType(MYSQL_FIELD* field)
@@ -28,6 +28,7 @@
 MySQLConnection::MySQLConnection(MySQLConnectionInfo& connInfo) :
 m_reconnecting(false),
 m_prepareError(false),
+m_reconnectCount(0),
 m_queue(NULL),
 m_worker(NULL),
 m_Mysql(NULL),
@@ -36,9 +37,10 @@ m_connectionFlags(CONNECTION_SYNCH)
 {
 }
 
-MySQLConnection::MySQLConnection(ACE_Activation_Queue* queue, MySQLConnectionInfo& connInfo) :
+MySQLConnection::MySQLConnection(SQLOperationQueue* queue, MySQLConnectionInfo& connInfo) :
 m_reconnecting(false),
 m_prepareError(false),
+m_reconnectCount(0),
 m_queue(queue),
 m_Mysql(NULL),
 m_connectionInfo(connInfo),
@@ -372,8 +374,12 @@ bool MySQLConnection::ExecuteTransaction(SQLTransaction& transaction)
 
     BeginTransaction();
 
+    /// Statements executed before a reconnection are rolled back by the server
+    uint32 reconnectCount = m_reconnectCount;
+    uint32 queryIndex = 0;
+
     std::list<SQLElementData>::const_iterator itr;
-    for (itr = queries.begin(); itr != queries.end(); ++itr)
+    for (itr = queries.begin(); itr != queries.end(); ++itr, ++queryIndex)
     {
         SQLElementData const& data = *itr;
         switch (itr->type)
@@ -403,6 +409,14 @@ bool MySQLConnection::ExecuteTransaction(SQLTransaction& transaction)
             }
             break;
         }
+
+        /// The statement which hit the reconnection was executed again alone in autocommit, don't run the next ones that way too
+        if (m_reconnectCount != reconnectCount)
+        {
+            sLog->outWarn(LOG_FILTER_SQL, "Transaction lost by a reconnection at query %u of %u. The %u queries before it were rolled back, it was executed alone and the %u next ones were not executed.",
+                queryIndex + 1, (uint32)queries.size(), queryIndex, (uint32)queries.size() - queryIndex - 1);
+            return false;
+        }
     }
 
     // we might encounter errors during certain queries, and depending on the kind of error
@@ -411,6 +425,13 @@ bool MySQLConnection::ExecuteTransaction(SQLTransaction& transaction)
     // and not while iterating over every element.
 
     CommitTransaction();
+
+    if (m_reconnectCount != reconnectCount)
+    {
+        sLog->outWarn(LOG_FILTER_SQL, "Transaction lost by a reconnection during its commit. Its %u queries were rolled back.", (uint32)queries.size());
+        return false;
+    }
+
     return true;
 }
 
@@ -501,6 +522,7 @@ bool MySQLConnection::_HandleMySQLErrno(uint32 errNo)
                             (m_connectionFlags & CONNECTION_ASYNC) ? "asynchronous" : "synchronous");
 
                 m_reconnecting = false;
+                ++m_reconnectCount;
                 return true;
             }
 
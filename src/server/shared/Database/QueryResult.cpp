@@ -13,7 +13,9 @@ ResultSet::ResultSet(MYSQL_RES *result, MYSQL_FIELD *fields, uint64 rowCount, ui
 _rowCount(rowCount),
 _fieldCount(fieldCount),
 _result(result),
-_fields(fields)
+_fields(fields),
+_snapshotRow(NULL),
+_snapshotRemaining(0)
 {
     _currentRow = new Field[_fieldCount];
 #ifdef TRINITY_DEBUG
@@ -22,6 +24,28 @@ _fields(fields)
 #endif
 }
 
+ResultSet::ResultSet(std::shared_ptr<void> const& p_Owner, char const* p_Rows, uint64 rowCount, std::vector<enum_field_types> const& p_Types) :
+_rowCount(rowCount),
+_fieldCount(p_Types.size()),
+_result(NULL),
+_fields(NULL),
+_snapshotOwner(p_Owner),
+_snapshotRow(p_Rows),
+_snapshotRemaining(rowCount),
+_snapshotTypes(p_Types)
+{
+    _currentRow = new Field[_fieldCount];
+#ifdef TRINITY_DEBUG
+    for (uint32 i = 0; i < _fieldCount; i++)
+    {
+        Field::Metadata& meta = _currentRow[i].meta;
+        meta.TableName = meta.TableAlias = meta.Name = meta.Alias = "snapshot";
+        meta.Type = Field::FieldTypeToString(p_Types[i]);
+        meta.Index = i;
+    }
+#endif
+}
+
 PreparedResultSet::PreparedResultSet(MYSQL_STMT* stmt, MYSQL_RES *result, uint64 rowCount, uint32 fieldCount) :
 m_rowCount(rowCount),
 m_rowPosition(0),
@@ -158,6 +182,33 @@ bool ResultSet::NextRow()
 {
     MYSQL_ROW row;
 
+    if (_snapshotOwner)
+    {
+        if (!_snapshotRemaining)
+        {
+            CleanUp();
+            return false;
+        }
+
+        for (uint32 i = 0; i < _fieldCount; i++)
+        {
+            uint32 length;
+            memcpy(&length, _snapshotRow, sizeof(length));
+            _snapshotRow += sizeof(length);
+
+            if (length == 0xFFFFFFFF)
+                _currentRow[i].SetTextValue(NULL, _snapshotTypes[i], 0);
+            else
+            {
+                _currentRow[i].SetTextValue(_snapshotRow, _snapshotTypes[i], length);
+                _snapshotRow += length + 1;
+            }
+        }
+
+        --_snapshotRemaining;
+        return true;
+    }
+
     if (!_result)
         return false;
 
@@ -168,8 +219,11 @@ bool ResultSet::NextRow()
         return false;
     }
 
+    /// Stored results keep every row until mysql_free_result, the fields point to them without copy
+    unsigned long* lengths = mysql_fetch_lengths(_result);
+
     for (uint32 i = 0; i < _fieldCount; i++)
-        _currentRow[i].SetStructuredValue(row[i], _fields[i].type);
+        _currentRow[i].SetTextValue(row[i], _fields[i].type, lengths[i]);
 
     return true;
 }
@@ -202,6 +256,23 @@ bool PreparedResultSet::_NextRow()
     return retval;
 }
 
+void ResultSet::AppendSnapshotRow(std::string& p_Buffer) const
+{
+    for (uint32 i = 0; i < _fieldCount; i++)
+    {
+        Field const& field = _currentRow[i];
+        uint32 length = field.data.value ? field.data.length : 0xFFFFFFFF;
+
+        p_Buffer.append(reinterpret_cast<char const*>(&length), sizeof(length));
+
+        if (field.data.value)
+        {
+            p_Buffer.append(static_cast<char const*>(field.data.value), field.data.length);
+            p_Buffer.push_back('\0');
+        }
+    }
+}
+
 void ResultSet::CleanUp()
 {
     if (_currentRow)
@@ -215,6 +286,8 @@ void ResultSet::CleanUp()
         mysql_free_result(_result);
         _result = NULL;
     }
+
+    _snapshotOwner.reset();
 }
 
 void PreparedResultSet::CleanUp()
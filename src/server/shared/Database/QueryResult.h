@@ -22,6 +22,9 @@ class ResultSet
 {
     public:
         ResultSet(MYSQL_RES* result, MYSQL_FIELD* fields, uint64 rowCount, uint32 fieldCount);
+        /// Rows encoded by AppendSnapshotRow, the text values are used in place
+        /// @p_Owner : Keeps the encoded rows alive as long as the result
+        ResultSet(std::shared_ptr<void> const& p_Owner, char const* p_Rows, uint64 rowCount, std::vector<enum_field_types> const& p_Types);
         ~ResultSet();
 
         bool NextRow();
@@ -35,6 +38,16 @@ class ResultSet
             return _currentRow[index];
         }
 
+        enum_field_types GetFieldType(uint32 index) const
+        {
+            ASSERT(index < _fieldCount);
+            return _currentRow[index].data.type;
+        }
+
+        /// Encode the current row at the end of p_Buffer
+        /// Each field is its length (0xFFFFFFFF if NULL) followed by its text and a '\0'
+        void AppendSnapshotRow(std::string& p_Buffer) const;
+
     protected:
         uint64 _rowCount;
         Field* _currentRow;
@@ -45,6 +58,11 @@ class ResultSet
         MYSQL_RES* _result;
         MYSQL_FIELD* _fields;
 
+        std::shared_ptr<void>          _snapshotOwner;
+        char const*                    _snapshotRow;        ///< Next encoded row
+        uint64                         _snapshotRemaining;  ///< Encoded rows not read yet
+        std::vector<enum_field_types>  _snapshotTypes;
+
         ResultSet(ResultSet const& right) = delete;
         ResultSet& operator=(ResultSet const& right) = delete;
 };
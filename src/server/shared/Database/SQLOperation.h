@@ -59,6 +59,9 @@ class SQLOperation : public ACE_Method_Request
         virtual bool Execute() = 0;
         virtual void SetConnection(MySQLConnection* con) { m_conn = con; }
 
+        //! One-way statements without result, the worker can execute several of them in the same transaction
+        virtual bool IsBatchable() const { return false; }
+
         MySQLConnection* m_conn;
 };
 
@@ -0,0 +1,90 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+//  MILLENIUM-STUDIO
+//  Copyright 2016 Millenium-studio SARL
+//  All Rights Reserved.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+#include "SQLOperationQueue.h"
+#include "SQLOperation.h"
+
+SQLOperationQueue::SQLOperationQueue() :
+m_NormalSinceLow(0),
+m_Closed(false)
+{
+}
+
+SQLOperationQueue::~SQLOperationQueue()
+{
+    for (uint8 l_Priority = 0; l_Priority < MAX_SQL_PRIORITY; ++l_Priority)
+    {
+        for (SQLOperation* l_Operation : m_Operations[l_Priority])
+            delete l_Operation;
+    }
+}
+
+void SQLOperationQueue::Enqueue(SQLOperation* p_Operation, SQLOperationPriority p_Priority)
+{
+    {
+        std::lock_guard<std::mutex> l_Lock(m_Lock);
+        m_Operations[p_Priority].push_back(p_Operation);
+    }
+
+    m_Condition.notify_one();
+}
+
+bool SQLOperationQueue::DequeueBatch(std::vector<SQLOperation*>& p_Batch, size_t p_MaxBatch)
+{
+    std::unique_lock<std::mutex> l_Lock(m_Lock);
+
+    while (m_Operations[SQL_PRIORITY_NORMAL].empty() && m_Operations[SQL_PRIORITY_LOW].empty())
+    {
+        if (m_Closed)
+            return false;
+
+        m_Condition.wait(l_Lock);
+    }
+
+    /// Low priority operations are served when nothing else waits, or from time to time so they can't grow forever
+    SQLOperationPriority l_Priority = SQL_PRIORITY_NORMAL;
+    if (m_Operations[SQL_PRIORITY_NORMAL].empty() || (!m_Operations[SQL_PRIORITY_LOW].empty() && m_NormalSinceLow >= SQL_LOW_PRIORITY_INTERVAL))
+        l_Priority = SQL_PRIORITY_LOW;
+
+    std::deque<SQLOperation*>& l_Operations = m_Operations[l_Priority];
+
+    p_Batch.push_back(l_Operations.front());
+    l_Operations.pop_front();
+
+    if (p_Batch.back()->IsBatchable())
+    {
+        while (!l_Operations.empty() && p_Batch.size() < p_MaxBatch && l_Operations.front()->IsBatchable())
+        {
+            p_Batch.push_back(l_Operations.front());
+            l_Operations.pop_front();
+        }
+    }
+
+    if (l_Priority == SQL_PRIORITY_LOW)
+        m_NormalSinceLow = 0;
+    else
+        m_NormalSinceLow += p_Batch.size();
+
+    return true;
+}
+
+void SQLOperationQueue::Close()
+{
+    {
+        std::lock_guard<std::mutex> l_Lock(m_Lock);
+        m_Closed = true;
+    }
+
+    m_Condition.notify_all();
+}
+
+size_t SQLOperationQueue::Size()
+{
+    std::lock_guard<std::mutex> l_Lock(m_Lock);
+    return m_Operations[SQL_PRIORITY_NORMAL].size() + m_Operations[SQL_PRIORITY_LOW].size();
+}
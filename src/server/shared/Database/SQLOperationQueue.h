@@ -0,0 +1,60 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+//  MILLENIUM-STUDIO
+//  Copyright 2016 Millenium-studio SARL
+//  All Rights Reserved.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef _SQLOPERATIONQUEUE_H
+#define _SQLOPERATIONQUEUE_H
+
+#include "Common.h"
+#include <condition_variable>
+#include <deque>
+
+class SQLOperation;
+
+enum SQLOperationPriority
+{
+    SQL_PRIORITY_NORMAL,        ///< Saves, queries, login... executed in queue order
+    SQL_PRIORITY_LOW,           ///< Log inserts, only executed when no normal operation is waiting
+    MAX_SQL_PRIORITY
+};
+
+/// Maximum number of one-way statements executed in the same transaction by a worker
+#define MAX_SQL_BATCH_SIZE          64
+/// Number of normal operations after which a low priority one is served anyway
+#define SQL_LOW_PRIORITY_INTERVAL   16
+
+/// Queue shared by the asynchronous connections of a DatabaseWorkerPool
+/// Operations of the same priority keep their order, consecutive one-way statements
+/// are handed to a worker together so it can execute them in a single transaction
+class SQLOperationQueue
+{
+    public:
+        SQLOperationQueue();
+        ~SQLOperationQueue();
+
+        void Enqueue(SQLOperation* p_Operation, SQLOperationPriority p_Priority);
+
+        /// Block until an operation is queued
+        /// @p_Batch    : Filled with the next operation, followed by the next batchable ones of the same priority
+        /// @p_MaxBatch : Maximum number of operations returned
+        /// Return false once the queue is closed and empty
+        bool DequeueBatch(std::vector<SQLOperation*>& p_Batch, size_t p_MaxBatch);
+
+        /// Wake up all the workers, they exit once the remaining operations are executed
+        void Close();
+
+        size_t Size();
+
+    private:
+        std::mutex                  m_Lock;
+        std::condition_variable     m_Condition;
+        std::deque<SQLOperation*>   m_Operations[MAX_SQL_PRIORITY];
+        uint32                      m_NormalSinceLow;
+        bool                        m_Closed;
+};
+
+#endif
@@ -65,9 +65,18 @@ void Transaction::Cleanup()
 
 bool TransactionTask::Execute()
 {
+    uint32 l_ReconnectCount = m_conn->GetReconnectCount();
     bool l_ExecuteResult = m_conn->ExecuteTransaction(m_trans);
 
-    if (m_conn->GetLastError() == 1213)
+    /// A reconnection rolled back the queries executed before it, replay the whole transaction on the new connection
+    /// The query executed alone after the reconnection is replayed as well, saves delete their rows before inserting them again
+    for (uint8 i = 0; i < 5 && !l_ExecuteResult && m_conn->GetReconnectCount() != l_ReconnectCount; ++i)
+    {
+        l_ReconnectCount = m_conn->GetReconnectCount();
+        l_ExecuteResult = m_conn->ExecuteTransaction(m_trans);
+    }
+
+    if (!l_ExecuteResult && m_conn->GetLastError() == 1213)
     {
         uint8 loopBreaker = 5;  // Handle MySQL Errno 1213 without extending deadlock to the core itself
         for (uint8 i = 0; i < loopBreaker; ++i)
@@ -274,8 +274,28 @@ void Log::EnableDBAppenders()
 
 void Log::vlog(LogFilterType filter, LogLevel level, char const* str, va_list argptr)
 {
+    /// Binary mode, the message is formatted later by the LogWorker thread
+    if (worker && worker->IsBinaryMode())
+    {
+        va_list l_Args;
+        va_copy(l_Args, argptr);
+        bool l_Stored = worker->EnqueueRecord(filter, level, str, l_Args);
+        va_end(l_Args);
+
+        if (l_Stored)
+            return;
+    }
+
     char text[MAX_QUERY_LEN];
     vsnprintf(text, MAX_QUERY_LEN, str, argptr);
+
+    /// Written after the binary records of the thread
+    if (worker && worker->IsBinaryMode())
+    {
+        worker->EnqueueText(filter, level, text);
+        return;
+    }
+
     write(new LogMessage(level, filter, text));
 }
 
@@ -388,7 +408,21 @@ void Log::LoadFromConfig()
 
     lowestLogLevel = LOG_LEVEL_FATAL;
     AppenderId = 0;
-    worker = new LogWorker();
+
+    if (ConfigMgr::GetBoolDefault("Log.Binary.Enable", false))
+    {
+        worker = new LogWorker(ConfigMgr::GetIntDefault("Log.Binary.BufferSize", 1024), [this](uint8 p_Filter, uint8 p_Level, time_t p_Time, std::string const& p_Text) -> void
+        {
+            LogMessage l_Message(LogLevel(p_Level), LogFilterType(p_Filter), p_Text);
+            l_Message.text.append("\n");
+            l_Message.mtime = p_Time;
+
+            GetLoggerByType(l_Message.type)->write(l_Message);
+        });
+    }
+    else
+        worker = new LogWorker();
+
     m_logsDir = ConfigMgr::GetStringDefault("LogsDir", "");
     if (!m_logsDir.empty())
         if ((m_logsDir.at(m_logsDir.length() - 1) != '/') && (m_logsDir.at(m_logsDir.length() - 1) != '\\'))
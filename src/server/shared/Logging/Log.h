@@ -146,6 +146,9 @@ class Log
         void SetRealmID(uint32 id);
         uint32 GetRealmID() const { return realm; }
 
+        bool IsBinaryMode() const { return worker && worker->IsBinaryMode(); }
+        uint64 GetDroppedRecordCount() const { return worker ? worker->GetDroppedRecordCount() : 0; }
+
     private:
         void vlog(LogFilterType f, LogLevel level, char const* str, va_list argptr);
         void write(LogMessage* msg);
@@ -0,0 +1,435 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+//  MILLENIUM-STUDIO
+//  Copyright 2016 Millenium-studio SARL
+//  All Rights Reserved.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+#include "LogRecordBuffer.h"
+
+#include <cctype>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <algorithm>
+
+namespace
+{
+    enum LogArgType
+    {
+        LOG_ARG_INT,
+        LOG_ARG_LONG,
+        LOG_ARG_LONG_LONG,
+        LOG_ARG_SIZE,
+        LOG_ARG_PTRDIFF,
+        LOG_ARG_INTMAX,
+        LOG_ARG_DOUBLE,
+        LOG_ARG_STRING,
+        LOG_ARG_POINTER,
+        LOG_ARG_PERCENT,
+        LOG_ARG_UNSUPPORTED
+    };
+
+    enum LogArgLength
+    {
+        LOG_LENGTH_NONE,
+        LOG_LENGTH_SHORT,
+        LOG_LENGTH_LONG,
+        LOG_LENGTH_LONG_LONG,
+        LOG_LENGTH_LONG_DOUBLE,
+        LOG_LENGTH_SIZE,
+        LOG_LENGTH_PTRDIFF,
+        LOG_LENGTH_INTMAX
+    };
+
+    uint16 const NULL_STRING_LENGTH = 0xFFFF;
+
+    /// Parse a printf conversion specification
+    /// @p_Spec      : Pointer just after the '%'
+    /// @p_Type      : Type of the argument consumed by the conversion
+    /// @p_StarCount : Number of int arguments consumed by '*' width / precision
+    /// Return the pointer after the conversion character
+    char const* ParseConversion(char const* p_Spec, LogArgType& p_Type, uint32& p_StarCount)
+    {
+        char const* l_Itr = p_Spec;
+        p_StarCount = 0;
+
+        while (*l_Itr && strchr("-+ #0'", *l_Itr))
+            ++l_Itr;
+
+        if (*l_Itr == '*')
+        {
+            ++p_StarCount;
+            ++l_Itr;
+        }
+        else
+        {
+            while (isdigit(static_cast<unsigned char>(*l_Itr)))
+                ++l_Itr;
+        }
+
+        if (*l_Itr == '.')
+        {
+            ++l_Itr;
+
+            if (*l_Itr == '*')
+            {
+                ++p_StarCount;
+                ++l_Itr;
+            }
+            else
+            {
+                while (isdigit(static_cast<unsigned char>(*l_Itr)))
+                    ++l_Itr;
+            }
+        }
+
+        LogArgLength l_Length = LOG_LENGTH_NONE;
+        switch (*l_Itr)
+        {
+            case 'h':
+                l_Length = LOG_LENGTH_SHORT;
+                if (*++l_Itr == 'h')
+                    ++l_Itr;
+                break;
+            case 'l':
+                l_Length = LOG_LENGTH_LONG;
+                if (*++l_Itr == 'l')
+                {
+                    l_Length = LOG_LENGTH_LONG_LONG;
+                    ++l_Itr;
+                }
+                break;
+            case 'q':
+                l_Length = LOG_LENGTH_LONG_LONG;
+                ++l_Itr;
+                break;
+            case 'L':
+                l_Length = LOG_LENGTH_LONG_DOUBLE;
+                ++l_Itr;
+                break;
+            case 'z':
+                l_Length = LOG_LENGTH_SIZE;
+                ++l_Itr;
+                break;
+            case 't':
+                l_Length = LOG_LENGTH_PTRDIFF;
+                ++l_Itr;
+                break;
+            case 'j':
+                l_Length = LOG_LENGTH_INTMAX;
+                ++l_Itr;
+                break;
+            default:
+                break;
+        }
+
+        p_Type = LOG_ARG_UNSUPPORTED;
+
+        switch (*l_Itr)
+        {
+            case '%':
+                if (l_Itr == p_Spec)
+                    p_Type = LOG_ARG_PERCENT;
+                break;
+            case 'c':
+                if (l_Length == LOG_LENGTH_NONE)
+                    p_Type = LOG_ARG_INT;
+                break;
+            case 'd': case 'i': case 'o': case 'u': case 'x': case 'X':
+                switch (l_Length)
+                {
+                    case LOG_LENGTH_NONE:
+                    case LOG_LENGTH_SHORT:     p_Type = LOG_ARG_INT;       break;
+                    case LOG_LENGTH_LONG:      p_Type = LOG_ARG_LONG;      break;
+                    case LOG_LENGTH_LONG_LONG: p_Type = LOG_ARG_LONG_LONG; break;
+                    case LOG_LENGTH_SIZE:      p_Type = LOG_ARG_SIZE;      break;
+                    case LOG_LENGTH_PTRDIFF:   p_Type = LOG_ARG_PTRDIFF;   break;
+                    case LOG_LENGTH_INTMAX:    p_Type = LOG_ARG_INTMAX;    break;
+                    default:                                               break;
+                }
+                break;
+            case 'f': case 'F': case 'e': case 'E': case 'g': case 'G': case 'a': case 'A':
+                if (l_Length == LOG_LENGTH_NONE || l_Length == LOG_LENGTH_LONG)
+                    p_Type = LOG_ARG_DOUBLE;
+                break;
+            case 's':
+                if (l_Length == LOG_LENGTH_NONE)
+                    p_Type = LOG_ARG_STRING;
+                break;
+            case 'p':
+                if (l_Length == LOG_LENGTH_NONE)
+                    p_Type = LOG_ARG_POINTER;
+                break;
+            default:
+                break;
+        }
+
+        if (*l_Itr)
+            ++l_Itr;
+
+        return l_Itr;
+    }
+
+    class RecordWriter
+    {
+        public:
+            RecordWriter(char* p_Data, size_t p_Size) : m_Cursor(p_Data), m_End(p_Data + p_Size) { }
+
+            template<typename T> bool Write(T p_Value)
+            {
+                return Write(&p_Value, sizeof(T));
+            }
+
+            bool Write(void const* p_Data, size_t p_Size)
+            {
+                if (size_t(m_End - m_Cursor) < p_Size)
+                    return false;
+
+                memcpy(m_Cursor, p_Data, p_Size);
+                m_Cursor += p_Size;
+                return true;
+            }
+
+            bool WriteString(char const* p_String)
+            {
+                if (!p_String)
+                    return Write<uint16>(NULL_STRING_LENGTH);
+
+                size_t l_Length = strlen(p_String);
+                if (l_Length >= NULL_STRING_LENGTH)
+                    return false;
+
+                return Write<uint16>(uint16(l_Length)) && Write(p_String, l_Length);
+            }
+
+            char* GetCursor() const { return m_Cursor; }
+
+        private:
+            char* m_Cursor;
+            char* m_End;
+    };
+
+    class RecordReader
+    {
+        public:
+            explicit RecordReader(char const* p_Data) : m_Cursor(p_Data) { }
+
+            template<typename T> T Read()
+            {
+                T l_Value;
+                memcpy(&l_Value, m_Cursor, sizeof(T));
+                m_Cursor += sizeof(T);
+                return l_Value;
+            }
+
+            /// Return false for a null string
+            bool ReadString(std::string& p_String)
+            {
+                uint16 l_Length = Read<uint16>();
+                if (l_Length == NULL_STRING_LENGTH)
+                    return false;
+
+                p_String.assign(m_Cursor, l_Length);
+                m_Cursor += l_Length;
+                return true;
+            }
+
+            void Skip(size_t p_Size) { m_Cursor += p_Size; }
+
+        private:
+            char const* m_Cursor;
+    };
+
+    template<typename T>
+    void AppendConversion(std::string& p_Out, std::string const& p_Spec, int const* p_Stars, uint32 p_StarCount, T p_Value)
+    {
+        char l_Buffer[LOG_RECORD_SIZE];
+        int l_Length = 0;
+
+        switch (p_StarCount)
+        {
+            case 0:  l_Length = snprintf(l_Buffer, sizeof(l_Buffer), p_Spec.c_str(), p_Value);                           break;
+            case 1:  l_Length = snprintf(l_Buffer, sizeof(l_Buffer), p_Spec.c_str(), p_Stars[0], p_Value);               break;
+            default: l_Length = snprintf(l_Buffer, sizeof(l_Buffer), p_Spec.c_str(), p_Stars[0], p_Stars[1], p_Value);   break;
+        }
+
+        if (l_Length > 0)
+            p_Out.append(l_Buffer, std::min<size_t>(l_Length, sizeof(l_Buffer) - 1));
+    }
+}
+
+bool LogRecord::Capture(uint8 p_Filter, uint8 p_Level, char const* p_Format, va_list p_Args)
+{
+    Time   = time(NULL);
+    Filter = p_Filter;
+    Level  = p_Level;
+
+    RecordWriter l_Writer(Data, sizeof(Data));
+
+    /// The format is copied as well, it isn't always a literal
+    if (!l_Writer.Write(p_Format, strlen(p_Format) + 1))
+        return false;
+
+    for (char const* l_Itr = p_Format; *l_Itr;)
+    {
+        if (*l_Itr++ != '%')
+            continue;
+
+        LogArgType l_Type;
+        uint32 l_StarCount;
+        l_Itr = ParseConversion(l_Itr, l_Type, l_StarCount);
+
+        if (l_Type == LOG_ARG_UNSUPPORTED)
+            return false;
+
+        for (uint32 l_I = 0; l_I < l_StarCount; ++l_I)
+        {
+            if (!l_Writer.Write<int>(va_arg(p_Args, int)))
+                return false;
+        }
+
+        bool l_Written = true;
+        switch (l_Type)
+        {
+            case LOG_ARG_INT:       l_Written = l_Writer.Write<int>(va_arg(p_Args, int));                     break;
+            case LOG_ARG_LONG:      l_Written = l_Writer.Write<long>(va_arg(p_Args, long));                   break;
+            case LOG_ARG_LONG_LONG: l_Written = l_Writer.Write<long long>(va_arg(p_Args, long long));         break;
+            case LOG_ARG_SIZE:      l_Written = l_Writer.Write<size_t>(va_arg(p_Args, size_t));               break;
+            case LOG_ARG_PTRDIFF:   l_Written = l_Writer.Write<ptrdiff_t>(va_arg(p_Args, ptrdiff_t));         break;
+            case LOG_ARG_INTMAX:    l_Written = l_Writer.Write<intmax_t>(va_arg(p_Args, intmax_t));           break;
+            case LOG_ARG_DOUBLE:    l_Written = l_Writer.Write<double>(va_arg(p_Args, double));               break;
+            case LOG_ARG_POINTER:   l_Written = l_Writer.Write<void*>(va_arg(p_Args, void*));                 break;
+            case LOG_ARG_STRING:    l_Written = l_Writer.WriteString(va_arg(p_Args, char const*));            break;
+            default:                                                                                          break;
+        }
+
+        if (!l_Written)
+            return false;
+    }
+
+    Size = uint16(l_Writer.GetCursor() - Data);
+    return true;
+}
+
+void LogRecord::SetText(uint8 p_Filter, uint8 p_Level, char const* p_Text)
+{
+    size_t l_Length = std::min(strlen(p_Text), sizeof(Data));
+
+    Time   = time(NULL);
+    Filter = p_Filter;
+    Level  = p_Level;
+    Size   = uint16(l_Length) | TEXT_RECORD_FLAG;
+
+    memcpy(Data, p_Text, l_Length);
+}
+
+std::string LogRecord::Format() const
+{
+    if (IsText())
+        return std::string(Data, Size & ~TEXT_RECORD_FLAG);
+
+    std::string l_Text;
+    char const* l_Format = Data;
+
+    RecordReader l_Reader(Data);
+    l_Reader.Skip(strlen(l_Format) + 1);
+
+    for (char const* l_Itr = l_Format; *l_Itr;)
+    {
+        char const* l_Literal = l_Itr;
+        while (*l_Itr && *l_Itr != '%')
+            ++l_Itr;
+
+        l_Text.append(l_Literal, l_Itr - l_Literal);
+
+        if (!*l_Itr)
+            break;
+
+        char const* l_SpecStart = l_Itr++;
+
+        LogArgType l_Type;
+        uint32 l_StarCount;
+        l_Itr = ParseConversion(l_Itr, l_Type, l_StarCount);
+
+        if (l_Type == LOG_ARG_PERCENT)
+        {
+            l_Text.push_back('%');
+            continue;
+        }
+
+        int l_Stars[2] = { 0, 0 };
+        for (uint32 l_I = 0; l_I < l_StarCount; ++l_I)
+            l_Stars[l_I] = l_Reader.Read<int>();
+
+        std::string l_Spec(l_SpecStart, l_Itr - l_SpecStart);
+
+        switch (l_Type)
+        {
+            case LOG_ARG_INT:       AppendConversion(l_Text, l_Spec, l_Stars, l_StarCount, l_Reader.Read<int>());        break;
+            case LOG_ARG_LONG:      AppendConversion(l_Text, l_Spec, l_Stars, l_StarCount, l_Reader.Read<long>());       break;
+            case LOG_ARG_LONG_LONG: AppendConversion(l_Text, l_Spec, l_Stars, l_StarCount, l_Reader.Read<long long>());  break;
+            case LOG_ARG_SIZE:      AppendConversion(l_Text, l_Spec, l_Stars, l_StarCount, l_Reader.Read<size_t>());     break;
+            case LOG_ARG_PTRDIFF:   AppendConversion(l_Text, l_Spec, l_Stars, l_StarCount, l_Reader.Read<ptrdiff_t>());  break;
+            case LOG_ARG_INTMAX:    AppendConversion(l_Text, l_Spec, l_Stars, l_StarCount, l_Reader.Read<intmax_t>());   break;
+            case LOG_ARG_DOUBLE:    AppendConversion(l_Text, l_Spec, l_Stars, l_StarCount, l_Reader.Read<double>());     break;
+            case LOG_ARG_POINTER:   AppendConversion(l_Text, l_Spec, l_Stars, l_StarCount, l_Reader.Read<void*>());      break;
+            case LOG_ARG_STRING:
+            {
+                std::string l_String;
+                if (l_Reader.ReadString(l_String))
+                    AppendConversion(l_Text, l_Spec, l_Stars, l_StarCount, l_String.c_str());
+                else
+                    AppendConversion(l_Text, l_Spec, l_Stars, l_StarCount, static_cast<char const*>(NULL));
+                break;
+            }
+            default:
+                break;
+        }
+    }
+
+    return l_Text;
+}
+
+LogRecordBuffer::LogRecordBuffer(uint32 p_Capacity)
+    : m_Head(0), m_Tail(0), m_Dropped(0), m_Abandoned(false)
+{
+    uint32 l_Capacity = 1;
+    while (l_Capacity < p_Capacity)
+        l_Capacity <<= 1;
+
+    m_Records.resize(l_Capacity);
+    m_Mask = l_Capacity - 1;
+}
+
+LogRecord* LogRecordBuffer::Reserve()
+{
+    uint32 l_Head = m_Head.load(std::memory_order_relaxed);
+
+    if (l_Head - m_Tail.load(std::memory_order_acquire) > m_Mask)
+        return nullptr;
+
+    return &m_Records[l_Head & m_Mask];
+}
+
+void LogRecordBuffer::Commit()
+{
+    m_Head.store(m_Head.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+}
+
+LogRecord const* LogRecordBuffer::Front() const
+{
+    uint32 l_Tail = m_Tail.load(std::memory_order_relaxed);
+
+    if (l_Tail == m_Head.load(std::memory_order_acquire))
+        return nullptr;
+
+    return &m_Records[l_Tail & m_Mask];
+}
+
+void LogRecordBuffer::Pop()
+{
+    m_Tail.store(m_Tail.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+}
@@ -0,0 +1,84 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+//  MILLENIUM-STUDIO
+//  Copyright 2016 Millenium-studio SARL
+//  All Rights Reserved.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef LOGRECORDBUFFER_H
+#define LOGRECORDBUFFER_H
+
+#include "Define.h"
+
+#include <atomic>
+#include <cstdarg>
+#include <ctime>
+#include <string>
+#include <vector>
+
+#define LOG_RECORD_SIZE 512
+
+/// Fixed size binary log record
+/// Data holds the format string followed by the raw arguments, the text itself is only built by the LogWorker thread
+/// A message that can't be captured is formatted by the caller and stored as a text record instead, to keep the order of the thread
+struct LogRecord
+{
+    static uint16 const TEXT_RECORD_FLAG = 0x8000;  ///< Set in Size for a text record, Data is far smaller
+
+
+    time_t Time;
+    uint8  Filter;
+    uint8  Level;
+    uint16 Size;
+    char   Data[LOG_RECORD_SIZE - sizeof(time_t) - 4];
+
+    /// Copy the format and its arguments into the record
+    /// Return false if the format uses a conversion that can't be replayed or if the arguments don't fit,
+    /// the caller must then format the message itself
+    bool Capture(uint8 p_Filter, uint8 p_Level, char const* p_Format, va_list p_Args);
+
+    /// Copy an already formatted message into the record, truncated to the size of Data
+    void SetText(uint8 p_Filter, uint8 p_Level, char const* p_Text);
+    bool IsText() const { return (Size & TEXT_RECORD_FLAG) != 0; }
+
+    /// Replay the captured format or return the text of a text record
+    std::string Format() const;
+};
+
+/// Single producer / single consumer ring of log records
+/// Each logging thread owns one buffer, only the LogWorker thread consumes it
+/// The thread abandons its buffer when it exits, the LogWorker frees it once drained
+class LogRecordBuffer
+{
+    public:
+        explicit LogRecordBuffer(uint32 p_Capacity);
+
+        /// Reserve the next free record, return nullptr if the ring is full
+        LogRecord* Reserve();
+        /// Publish the record returned by the last Reserve call
+        void Commit();
+
+        /// Consumer side, return nullptr if the ring is empty
+        LogRecord const* Front() const;
+        void Pop();
+
+        /// Count a record lost because the ring was full
+        void Drop() { m_Dropped.fetch_add(1, std::memory_order_relaxed); }
+        uint64 GetDroppedCount() const { return m_Dropped.load(std::memory_order_relaxed); }
+
+        /// Called by the producer thread on exit, after its last Commit
+        void Abandon() { m_Abandoned.store(true, std::memory_order_release); }
+        bool IsAbandoned() const { return m_Abandoned.load(std::memory_order_acquire); }
+
+    private:
+        std::vector<LogRecord> m_Records;
+        uint32                 m_Mask;
+
+        std::atomic<uint32>    m_Head;     ///< Next record written by the producer
+        std::atomic<uint32>    m_Tail;     ///< Next record read by the consumer
+        std::atomic<uint64>    m_Dropped;
+        std::atomic<bool>      m_Abandoned;
+};
+
+#endif
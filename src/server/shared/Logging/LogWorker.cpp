@@ -7,9 +7,44 @@
 ////////////////////////////////////////////////////////////////////////////////
 
 #include "LogWorker.h"
+#include "Appender.h"
 
-LogWorker::LogWorker()
-    : m_queue(HIGH_WATERMARK, LOW_WATERMARK)
+#include <ace/TSS_T.h>
+
+#include <cerrno>
+
+namespace
+{
+    /// Max delay between two drains of the binary record buffers, in milliseconds
+    uint32 const RECORD_DRAIN_INTERVAL = 10;
+
+    std::atomic<uint64> s_NextWorkerId(1);
+
+    /// Ring buffer of the current thread, only valid while it belongs to the running worker
+    thread_local uint64           t_RecordBufferOwner  = 0;
+    thread_local LogRecordBuffer* t_RecordBuffer       = nullptr;
+
+    /// Keeps the ring buffer of the thread alive until the thread exits, then hands it back to the LogWorker
+    struct RecordBufferOwner
+    {
+        ~RecordBufferOwner()
+        {
+            if (Buffer)
+                Buffer->Abandon();
+
+            t_RecordBufferOwner = 0;
+            t_RecordBuffer      = nullptr;
+        }
+
+        std::shared_ptr<LogRecordBuffer> Buffer;
+    };
+
+    ACE_TSS<RecordBufferOwner> g_RecordBufferOwners;
+}
+
+LogWorker::LogWorker(uint32 p_RecordBufferSize, RecordWriter p_RecordWriter)
+    : m_queue(HIGH_WATERMARK, LOW_WATERMARK), m_Id(s_NextWorkerId++), m_RecordBufferSize(p_RecordWriter ? p_RecordBufferSize : 0),
+    m_RecordWriter(p_RecordWriter), m_FreedDropCount(0), m_ReportedDropCount(0)
 {
     ACE_Task_Base::activate(THR_NEW_LWP | THR_JOINABLE | THR_INHERIT_SCHED, 1);
 }
@@ -18,6 +53,10 @@ LogWorker::~LogWorker()
 {
     m_queue.deactivate();
     wait();
+
+    /// Records stored while the worker was stopping
+    if (IsBinaryMode())
+        DrainRecordBuffers();
 }
 
 int LogWorker::enqueue(LogOperation* op)
@@ -25,13 +64,161 @@ int LogWorker::enqueue(LogOperation* op)
     return m_queue.enqueue(op);
 }
 
+bool LogWorker::EnqueueRecord(uint8 p_Filter, uint8 p_Level, char const* p_Format, va_list p_Args)
+{
+    LogRecordBuffer* l_Buffer = GetThreadRecordBuffer();
+
+    /// Full ring buffer, the record is counted as dropped
+    LogRecord* l_Record = l_Buffer->Reserve();
+    if (!l_Record)
+    {
+        l_Buffer->Drop();
+        return true;
+    }
+
+    if (!l_Record->Capture(p_Filter, p_Level, p_Format, p_Args))
+        return false;
+
+    l_Buffer->Commit();
+    return true;
+}
+
+void LogWorker::EnqueueText(uint8 p_Filter, uint8 p_Level, char const* p_Text)
+{
+    LogRecordBuffer* l_Buffer = GetThreadRecordBuffer();
+
+    /// Full ring buffer, the record is counted as dropped like binary records
+    LogRecord* l_Record = l_Buffer->Reserve();
+    if (!l_Record)
+    {
+        l_Buffer->Drop();
+        return;
+    }
+
+    l_Record->SetText(p_Filter, p_Level, p_Text);
+    l_Buffer->Commit();
+}
+
+uint64 LogWorker::GetDroppedRecordCount() const
+{
+    std::lock_guard<std::mutex> l_Lock(m_RecordBuffersLock);
+
+    uint64 l_Dropped = m_FreedDropCount;
+    for (auto const& l_Buffer : m_RecordBuffers)
+        l_Dropped += l_Buffer->GetDroppedCount();
+
+    return l_Dropped;
+}
+
+LogRecordBuffer* LogWorker::GetThreadRecordBuffer()
+{
+    if (t_RecordBufferOwner == m_Id)
+        return t_RecordBuffer;
+
+    std::shared_ptr<LogRecordBuffer> l_Buffer = std::make_shared<LogRecordBuffer>(m_RecordBufferSize);
+
+    {
+        std::lock_guard<std::mutex> l_Lock(m_RecordBuffersLock);
+        m_RecordBuffers.push_back(l_Buffer);
+    }
+
+    /// Buffer of a previous worker, that one keeps it until it is destroyed
+    RecordBufferOwner* l_Owner = g_RecordBufferOwners.operator->();
+    if (l_Owner->Buffer)
+        l_Owner->Buffer->Abandon();
+
+    l_Owner->Buffer = l_Buffer;
+
+    t_RecordBufferOwner = m_Id;
+    t_RecordBuffer      = l_Buffer.get();
+    return t_RecordBuffer;
+}
+
+void LogWorker::DrainRecordBuffers()
+{
+    /// Buffers are only freed by this thread, the list can be walked without holding the lock
+    std::vector<LogRecordBuffer*> l_Buffers;
+    {
+        std::lock_guard<std::mutex> l_Lock(m_RecordBuffersLock);
+        for (auto const& l_Buffer : m_RecordBuffers)
+            l_Buffers.push_back(l_Buffer.get());
+    }
+
+    bool l_HasAbandoned = false;
+    for (LogRecordBuffer* l_Buffer : l_Buffers)
+    {
+        /// Checked before the drain, the thread doesn't write anymore once it abandoned its buffer
+        bool l_Abandoned = l_Buffer->IsAbandoned();
+
+        while (LogRecord const* l_Record = l_Buffer->Front())
+        {
+            m_RecordWriter(l_Record->Filter, l_Record->Level, l_Record->Time, l_Record->Format());
+            l_Buffer->Pop();
+        }
+
+        l_HasAbandoned = l_HasAbandoned || l_Abandoned;
+    }
+
+    uint64 l_Dropped = 0;
+    {
+        std::lock_guard<std::mutex> l_Lock(m_RecordBuffersLock);
+
+        /// Buffers of the exited threads are drained, free them
+        if (l_HasAbandoned)
+        {
+            auto l_End = std::remove_if(m_RecordBuffers.begin(), m_RecordBuffers.end(), [this](std::shared_ptr<LogRecordBuffer> const& p_Buffer) -> bool
+            {
+                if (!p_Buffer->IsAbandoned() || p_Buffer->Front())
+                    return false;
+
+                m_FreedDropCount += p_Buffer->GetDroppedCount();
+                return true;
+            });
+
+            m_RecordBuffers.erase(l_End, m_RecordBuffers.end());
+        }
+
+        l_Dropped = m_FreedDropCount;
+        for (auto const& l_Buffer : m_RecordBuffers)
+            l_Dropped += l_Buffer->GetDroppedCount();
+    }
+
+    if (l_Dropped != m_ReportedDropCount)
+    {
+        char l_Text[128];
+        snprintf(l_Text, sizeof(l_Text), "LogWorker: " UI64FMTD " log records dropped, binary log buffers are full", l_Dropped - m_ReportedDropCount);
+
+        m_RecordWriter(LOG_FILTER_GENERAL, LOG_LEVEL_WARN, time(NULL), l_Text);
+        m_ReportedDropCount = l_Dropped;
+    }
+}
+
 int LogWorker::svc()
 {
     while (1)
     {
         LogOperation* request;
-        if (m_queue.dequeue(request) == -1)
-            break;
+
+        if (!IsBinaryMode())
+        {
+            if (m_queue.dequeue(request) == -1)
+                break;
+        }
+        else
+        {
+            ACE_Time_Value l_Timeout = ACE_OS::gettimeofday() + ACE_Time_Value(0, RECORD_DRAIN_INTERVAL * 1000);
+            int l_Result = m_queue.dequeue(request, &l_Timeout);
+
+            DrainRecordBuffers();
+
+            if (l_Result == -1)
+            {
+                if (errno == EWOULDBLOCK)
+                    continue;
+
+                break;
+            }
+        }
 
         request->call();
         delete request;
@@ -10,14 +10,23 @@
 #define LOGWORKER_H
 
 #include "LogOperation.h"
+#include "LogRecordBuffer.h"
 
 #include <ace/Task.h>
 #include <ace/Activation_Queue.h>
 
+#include <functional>
+#include <memory>
+#include <mutex>
+
 class LogWorker: protected ACE_Task_Base
 {
     public:
-        LogWorker();
+        typedef std::function<void(uint8 p_Filter, uint8 p_Level, time_t p_Time, std::string const& p_Text)> RecordWriter;
+
+        /// @p_RecordBufferSize : Records per thread ring buffer, 0 disables the binary mode
+        /// @p_RecordWriter     : Called on the worker thread for each formatted record
+        LogWorker(uint32 p_RecordBufferSize = 0, RecordWriter p_RecordWriter = nullptr);
         ~LogWorker();
 
         typedef ACE_Message_Queue_Ex<LogOperation, ACE_MT_SYNCH> LogMessageQueueType;
@@ -30,9 +39,32 @@ class LogWorker: protected ACE_Task_Base
 
         int enqueue(LogOperation *op);
 
+        bool IsBinaryMode() const { return m_RecordBufferSize != 0; }
+
+        /// Copy the message arguments into the calling thread ring buffer, never blocks
+        /// The record is dropped and counted if the ring buffer is full
+        /// Return false if the message can't be stored as a binary record and must be formatted by the caller
+        bool EnqueueRecord(uint8 p_Filter, uint8 p_Level, char const* p_Format, va_list p_Args);
+        /// Store a message formatted by the caller in the calling thread ring buffer, after its previous records, never blocks
+        /// The text is truncated to the size of a record, the record is dropped and counted if the ring buffer is full
+        void EnqueueText(uint8 p_Filter, uint8 p_Level, char const* p_Text);
+
+        uint64 GetDroppedRecordCount() const;
+
     private:
         virtual int svc();
+        LogRecordBuffer* GetThreadRecordBuffer();
+        void DrainRecordBuffers();
+
         LogMessageQueueType m_queue;
+
+        uint64                                        m_Id;
+        uint32                                        m_RecordBufferSize;
+        RecordWriter                                  m_RecordWriter;
+        mutable std::mutex                            m_RecordBuffersLock;
+        std::vector<std::shared_ptr<LogRecordBuffer>> m_RecordBuffers;     ///< Shared with the TSS of their thread
+        uint64                                        m_FreedDropCount;    ///< Drops of the buffers freed after their thread exited
+        uint64                                        m_ReportedDropCount;
 };
 
 #endif
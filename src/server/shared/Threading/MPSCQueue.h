@@ -0,0 +1,114 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+//  MILLENIUM-STUDIO
+//  Copyright 2016 Millenium-studio SARL
+//  All Rights Reserved.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef MPSCQUEUE_H
+#define MPSCQUEUE_H
+
+#include <atomic>
+
+namespace ACE_Based
+{
+    /// Lock free multiple producers / single consumer queue (intrusive stub node list)
+    /// Same interface as LockedQueue for the consumer side :
+    /// - add() can be called from any thread
+    /// - next(), peek() and empty() must only be called by one thread at a time
+    /// A producer preempted between its two atomic operations hides its item (and the following ones)
+    /// from the consumer until it resumes, the consumer simply sees a shorter queue.
+    template <class T>
+        class MPSCQueue
+    {
+        struct Node
+        {
+            Node() : Value(), Next(nullptr) { }
+            explicit Node(T const& p_Value) : Value(p_Value), Next(nullptr) { }
+
+            T                  Value;
+            std::atomic<Node*> Next;
+        };
+
+        //! Last pushed node, shared by the producers.
+        std::atomic<Node*> _head;
+
+        //! Already consumed node, its successor is the front of the queue. Consumer only.
+        Node* _tail;
+
+        public:
+
+            //! Create a MPSCQueue.
+            MPSCQueue()
+                : _head(new Node()), _tail(_head.load(std::memory_order_relaxed))
+            {
+            }
+
+            //! Destroy a MPSCQueue, remaining items are dropped.
+            virtual ~MPSCQueue()
+            {
+                T l_Item;
+                while (next(l_Item))
+                    ;
+
+                delete _tail;
+            }
+
+            //! Adds an item to the queue.
+            void add(const T& item)
+            {
+                Node* l_Node = new Node(item);
+                Node* l_Previous = _head.exchange(l_Node, std::memory_order_acq_rel);
+                l_Previous->Next.store(l_Node, std::memory_order_release);
+            }
+
+            //! Gets the next result in the queue, if any.
+            bool next(T& result)
+            {
+                Node* l_Front = _tail->Next.load(std::memory_order_acquire);
+                if (l_Front == nullptr)
+                    return false;
+
+                result = l_Front->Value;
+
+                delete _tail;
+                _tail = l_Front;
+                return true;
+            }
+
+            //! Gets the next result in the queue if the checker accepts it, the item stays in front otherwise.
+            template<class Checker>
+            bool next(T& result, Checker& check)
+            {
+                Node* l_Front = _tail->Next.load(std::memory_order_acquire);
+                if (l_Front == nullptr)
+                    return false;
+
+                result = l_Front->Value;
+                if (!check.Process(result))
+                    return false;
+
+                delete _tail;
+                _tail = l_Front;
+                return true;
+            }
+
+            //! Peeks at the top of the queue. Check if the queue is empty before calling!
+            T& peek()
+            {
+                return _tail->Next.load(std::memory_order_acquire)->Value;
+            }
+
+            //! Checks if we're empty or not.
+            bool empty() const
+            {
+                return _tail->Next.load(std::memory_order_acquire) == nullptr;
+            }
+
+        private:
+            MPSCQueue(MPSCQueue const&) = delete;
+            MPSCQueue& operator=(MPSCQueue const&) = delete;
+    };
+}
+#endif
@@ -0,0 +1,220 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+//  MILLENIUM-STUDIO
+//  Copyright 2016 Millenium-studio SARL
+//  All Rights Reserved.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef _WORK_STEALING_QUEUE_H
+#define _WORK_STEALING_QUEUE_H
+
+#include <condition_variable>
+#include <mutex>
+#include <deque>
+#include <vector>
+#include <memory>
+#include <atomic>
+#include <algorithm>
+#include <type_traits>
+#include <cstdint>
+
+/// Task queue with one deque per worker thread
+/// - Producers push on the least loaded worker deque (by queued cost)
+/// - Each deque is kept sorted by cost, the heaviest task is always popped first
+/// - Idle workers steal from the most loaded deque instead of sleeping
+/// Worker deques are only contended when a steal happens, producers never share a global lock
+template <typename T>
+class WorkStealingQueue
+{
+    private:
+        struct Entry
+        {
+            Entry(T const& p_Value, uint32_t p_Cost) : Value(p_Value), Cost(p_Cost) { }
+
+            T        Value;
+            uint32_t Cost;
+        };
+
+        struct WorkerDeque
+        {
+            WorkerDeque() : QueuedCost(0) { }
+
+            std::mutex            Lock;
+            std::deque<Entry>     Items;
+            std::atomic<uint64_t> QueuedCost;
+        };
+
+        std::vector<std::unique_ptr<WorkerDeque>> _deques;
+
+        std::atomic<size_t> _queuedCount;
+        std::atomic<size_t> _sleepingWorkers;
+        std::atomic<bool>   _shutdown;
+
+        std::mutex              _idleLock;
+        std::condition_variable _idleCondition;
+
+    public:
+
+        WorkStealingQueue() : _queuedCount(0), _sleepingWorkers(0), _shutdown(false) { }
+
+        /// Must be called before any worker starts to use the queue
+        /// @p_WorkerCount : Number of worker deques
+        void Resize(size_t p_WorkerCount)
+        {
+            _deques.clear();
+
+            for (size_t l_I = 0; l_I < std::max<size_t>(p_WorkerCount, 1); ++l_I)
+                _deques.emplace_back(new WorkerDeque());
+        }
+
+        size_t GetWorkerCount() const
+        {
+            return _deques.size();
+        }
+
+        /// Queue a new task
+        /// @p_Value : Task
+        /// @p_Cost  : Estimated cost of the task, heaviest tasks are started first
+        void Push(T const& p_Value, uint32_t p_Cost)
+        {
+            WorkerDeque* l_Target = _deques[0].get();
+
+            for (size_t l_I = 1; l_I < _deques.size(); ++l_I)
+            {
+                if (_deques[l_I]->QueuedCost.load(std::memory_order_relaxed) < l_Target->QueuedCost.load(std::memory_order_relaxed))
+                    l_Target = _deques[l_I].get();
+            }
+
+            /// Counted before insertion so a popping worker never sees a negative count
+            _queuedCount.fetch_add(1);
+
+            {
+                std::lock_guard<std::mutex> l_Lock(l_Target->Lock);
+
+                auto l_Position = std::upper_bound(l_Target->Items.begin(), l_Target->Items.end(), p_Cost, [](uint32_t p_Left, Entry const& p_Right) -> bool
+                {
+                    return p_Left > p_Right.Cost;
+                });
+
+                l_Target->Items.insert(l_Position, Entry(p_Value, p_Cost));
+                l_Target->QueuedCost.fetch_add(p_Cost + 1, std::memory_order_relaxed);
+            }
+
+            if (_sleepingWorkers.load() > 0)
+            {
+                std::lock_guard<std::mutex> l_Lock(_idleLock);
+                _idleCondition.notify_one();
+            }
+        }
+
+        bool Empty() const
+        {
+            return _queuedCount.load() == 0;
+        }
+
+        /// Pop the heaviest task of the worker deque, steal one if the deque is empty, wait if nothing is queued at all
+        /// @p_WorkerID : Index of the calling worker
+        /// @p_Value    : Output task
+        /// Return false if the queue has been canceled
+        bool WaitAndPop(size_t p_WorkerID, T& p_Value)
+        {
+            while (!_shutdown)
+            {
+                if (TryPop(p_WorkerID, p_Value))
+                    return true;
+
+                std::unique_lock<std::mutex> l_Lock(_idleLock);
+
+                ++_sleepingWorkers;
+
+                while (_queuedCount.load() == 0 && !_shutdown)
+                    _idleCondition.wait(l_Lock);
+
+                --_sleepingWorkers;
+            }
+
+            return false;
+        }
+
+        void Cancel()
+        {
+            for (auto& l_Deque : _deques)
+            {
+                std::lock_guard<std::mutex> l_Lock(l_Deque->Lock);
+
+                for (Entry& l_Entry : l_Deque->Items)
+                    DeleteQueuedObject(l_Entry.Value);
+
+                l_Deque->Items.clear();
+                l_Deque->QueuedCost = 0;
+            }
+
+            std::lock_guard<std::mutex> l_Lock(_idleLock);
+
+            _queuedCount = 0;
+            _shutdown    = true;
+
+            _idleCondition.notify_all();
+        }
+
+    private:
+        bool TryPop(size_t p_WorkerID, T& p_Value)
+        {
+            if (_queuedCount.load() == 0)
+                return false;
+
+            /// Own deque first
+            if (PopFront(*_deques[p_WorkerID % _deques.size()], p_Value))
+                return true;
+
+            /// Then steal from the most loaded worker
+            WorkerDeque* l_Victim = nullptr;
+
+            for (auto& l_Deque : _deques)
+            {
+                if (l_Deque->QueuedCost.load(std::memory_order_relaxed) == 0)
+                    continue;
+
+                if (l_Victim == nullptr || l_Deque->QueuedCost.load(std::memory_order_relaxed) > l_Victim->QueuedCost.load(std::memory_order_relaxed))
+                    l_Victim = l_Deque.get();
+            }
+
+            if (l_Victim != nullptr && PopFront(*l_Victim, p_Value))
+                return true;
+
+            /// Victim was drained meanwhile, walk all deques once
+            for (auto& l_Deque : _deques)
+            {
+                if (PopFront(*l_Deque, p_Value))
+                    return true;
+            }
+
+            return false;
+        }
+
+        bool PopFront(WorkerDeque& p_Deque, T& p_Value)
+        {
+            std::lock_guard<std::mutex> l_Lock(p_Deque.Lock);
+
+            if (p_Deque.Items.empty())
+                return false;
+
+            Entry& l_Entry = p_Deque.Items.front();
+
+            p_Value = l_Entry.Value;
+            p_Deque.QueuedCost.fetch_sub(l_Entry.Cost + 1, std::memory_order_relaxed);
+            p_Deque.Items.pop_front();
+
+            _queuedCount.fetch_sub(1);
+            return true;
+        }
+
+        template<typename E = T>
+        typename std::enable_if<std::is_pointer<E>::value>::type DeleteQueuedObject(E& obj) { delete obj; }
+
+        template<typename E = T>
+        typename std::enable_if<!std::is_pointer<E>::value>::type DeleteQueuedObject(E const& /*obj*/) { }
+};
+
+#endif
@@ -8,57 +8,290 @@
 
 #include "EventProcessor.h"
 
+#include <ace/TSS_T.h>
+
+#include <atomic>
+#include <cstring>
+#include <limits>
+#include <vector>
+
+#ifdef _MSC_VER
+# include <intrin.h>
+#endif
+
+namespace
+{
+    /// Block sizes are multiples of 16 bytes, bigger allocations go to the heap
+    enum
+    {
+        k_PoolGranularity = 16,
+        k_PoolClassCount  = 256,
+        k_PoolChunkSize   = 64 * 1024
+    };
+
+    struct ThreadPool;
+
+    /// In front of each block, k_PoolGranularity bytes so the blocks stay aligned
+    struct PoolBlockHeader
+    {
+        ThreadPool* Owner;
+        size_t      Class;
+    };
+
+    /// Stored in the block itself while it's free
+    struct PoolLink
+    {
+        PoolLink* Next;
+    };
+
+    inline PoolBlockHeader* GetHeader(void* p_Pointer)
+    {
+        return reinterpret_cast<PoolBlockHeader*>(static_cast<char*>(p_Pointer) - k_PoolGranularity);
+    }
+
+    /// Blocks allocated by a thread always come back to its pool
+    /// - A block freed by another thread is pushed on RemoteBlocks, the owner takes them back when a free list is empty
+    /// - Once the thread exited, the pool and its chunks are deleted with its last block
+    struct ThreadPool
+    {
+        /// Set in LiveBlocks when the owner thread exited
+        static size_t const k_Orphaned = size_t(1) << (sizeof(size_t) * 8 - 1);
+
+        ThreadPool() : RemoteBlocks(nullptr), LiveBlocks(0)
+        {
+            memset(FreeBlocks, 0, sizeof(FreeBlocks));
+        }
+
+        ~ThreadPool()
+        {
+            for (char* l_Chunk : Chunks)
+                ::operator delete(l_Chunk);
+        }
+
+        void AddChunk(size_t p_Class)
+        {
+            size_t l_BlockSize  = p_Class * k_PoolGranularity + k_PoolGranularity;
+            size_t l_BlockCount = k_PoolChunkSize / l_BlockSize;
+            char*  l_Chunk      = static_cast<char*>(::operator new(l_BlockCount * l_BlockSize));
+
+            Chunks.push_back(l_Chunk);
+
+            for (size_t l_I = l_BlockCount; l_I-- > 0;)
+            {
+                PoolBlockHeader* l_Header = reinterpret_cast<PoolBlockHeader*>(l_Chunk + l_I * l_BlockSize);
+                l_Header->Owner = this;
+                l_Header->Class = p_Class;
+
+                PoolLink* l_Link = reinterpret_cast<PoolLink*>(l_Chunk + l_I * l_BlockSize + k_PoolGranularity);
+                l_Link->Next = FreeBlocks[p_Class];
+                FreeBlocks[p_Class] = l_Link;
+            }
+        }
+
+        /// Owner thread only
+        void TakeRemoteBlocks()
+        {
+            PoolLink* l_Link = RemoteBlocks.exchange(nullptr, std::memory_order_acquire);
+
+            while (l_Link)
+            {
+                PoolLink* l_Next = l_Link->Next;
+                size_t l_Class = GetHeader(l_Link)->Class;
+
+                l_Link->Next = FreeBlocks[l_Class];
+                FreeBlocks[l_Class] = l_Link;
+                l_Link = l_Next;
+            }
+        }
+
+        /// Any thread, only the owner empties the list so there is no ABA
+        void PushRemoteBlock(PoolLink* p_Link)
+        {
+            PoolLink* l_Head = RemoteBlocks.load(std::memory_order_relaxed);
+            do
+                p_Link->Next = l_Head;
+            while (!RemoteBlocks.compare_exchange_weak(l_Head, p_Link, std::memory_order_release, std::memory_order_relaxed));
+        }
+
+        /// Called by each free, the last one after the thread exited deletes the pool
+        void ReleaseBlock()
+        {
+            if (LiveBlocks.fetch_sub(1, std::memory_order_acq_rel) == k_Orphaned + 1)
+                delete this;
+        }
+
+        /// Called once when the owner thread exits
+        void Orphan()
+        {
+            if (LiveBlocks.fetch_add(k_Orphaned, std::memory_order_acq_rel) == 0)
+                delete this;
+        }
+
+        PoolLink*              FreeBlocks[k_PoolClassCount];    ///< Owner thread only
+        std::atomic<PoolLink*> RemoteBlocks;                    ///< Blocks freed by other threads
+        std::atomic<size_t>    LiveBlocks;                      ///< Allocated blocks, plus k_Orphaned once the thread exited
+        std::vector<char*>     Chunks;
+    };
+
+    thread_local ThreadPool* t_ThreadPool = nullptr;
+
+    /// Created with the pool of a thread and destroyed when the thread exits, the pool lives until its last block is freed
+    struct ThreadPoolOwner
+    {
+        ThreadPoolOwner() : Pool(nullptr) { }
+
+        ~ThreadPoolOwner()
+        {
+            if (Pool)
+                Pool->Orphan();
+
+            t_ThreadPool = nullptr;
+        }
+
+        ThreadPool* Pool;
+    };
+
+    ACE_TSS<ThreadPoolOwner> g_ThreadPoolOwners;
+
+    void* PoolAllocate(size_t p_Size)
+    {
+        size_t l_Class = (p_Size + k_PoolGranularity - 1) / k_PoolGranularity;
+        if (!l_Class || l_Class >= k_PoolClassCount)
+            return ::operator new(p_Size);
+
+        ThreadPool*& l_Pool = t_ThreadPool;
+        if (!l_Pool)
+        {
+            l_Pool = new ThreadPool();
+            g_ThreadPoolOwners->Pool = l_Pool;
+        }
+
+        if (!l_Pool->FreeBlocks[l_Class])
+            l_Pool->TakeRemoteBlocks();
+
+        if (!l_Pool->FreeBlocks[l_Class])
+            l_Pool->AddChunk(l_Class);
+
+        PoolLink* l_Link = l_Pool->FreeBlocks[l_Class];
+        l_Pool->FreeBlocks[l_Class] = l_Link->Next;
+        l_Pool->LiveBlocks.fetch_add(1, std::memory_order_relaxed);
+        return l_Link;
+    }
+
+    void PoolFree(void* p_Pointer, size_t p_Size)
+    {
+        if (!p_Pointer)
+            return;
+
+        size_t l_Class = (p_Size + k_PoolGranularity - 1) / k_PoolGranularity;
+        if (!l_Class || l_Class >= k_PoolClassCount)
+        {
+            ::operator delete(p_Pointer);
+            return;
+        }
+
+        PoolLink*   l_Link  = static_cast<PoolLink*>(p_Pointer);
+        ThreadPool* l_Owner = GetHeader(p_Pointer)->Owner;
+
+        /// Events allocated by a map thread are often deleted by the world thread (logout, KillAllEvents)
+        if (l_Owner == t_ThreadPool)
+        {
+            l_Link->Next = l_Owner->FreeBlocks[l_Class];
+            l_Owner->FreeBlocks[l_Class] = l_Link;
+        }
+        else
+            l_Owner->PushRemoteBlock(l_Link);
+
+        l_Owner->ReleaseBlock();
+    }
+
+    inline uint32 LowestBit(uint64 p_Mask)
+    {
+#ifdef _MSC_VER
+        unsigned long l_Index;
+        _BitScanForward64(&l_Index, p_Mask);
+        return l_Index;
+#else
+        return __builtin_ctzll(p_Mask);
+#endif
+    }
+
+}
+
+void* BasicEvent::operator new(size_t p_Size)
+{
+    return PoolAllocate(p_Size);
+}
+
+void BasicEvent::operator delete(void* p_Pointer, size_t p_Size)
+{
+    PoolFree(p_Pointer, p_Size);
+}
+
 EventProcessor::EventProcessor()
 {
     m_time = 0;
     m_aborting = false;
+
+    m_Wheel        = nullptr;
+    m_WheelTime    = 0;
+    m_EventCount   = 0;
+    m_NextSequence = 0;
 }
 
 EventProcessor::~EventProcessor()
 {
     KillAllEvents(true);
+
+    if (m_Wheel)
+        PoolFree(m_Wheel, sizeof(Wheel));
 }
 
 void EventProcessor::Update(uint32 p_time)
 {
-    auto d = [this](BasicEvent* Event) {
-        Event->Abort(m_time);
-        delete Event;
-    };
-    auto c = [this](BasicEvent* Event, uint32 p_time) {
-        if (Event->Execute(m_time, p_time))
+    // update time
+    m_time += p_time;
+
+    for (;;)
+    {
+        if (!m_Wheel)
         {
-            // completely destroy event if it is not re-added
-            delete Event;
+            m_WheelTime = m_time;
+            break;
         }
-    };
-    auto b = [this, &c, &d](EventList::iterator i, uint32 p_time) {
-        // get and remove event from queue
-        BasicEvent* Event = i->second;
-        m_events.erase(i);
 
-        if (!Event->to_Abort)
+        ExecuteCurrentSlot(p_time);
+
+        if (!m_Wheel || !m_EventCount || m_WheelTime >= m_time)
         {
-            c(Event, p_time);
+            m_WheelTime = m_time;
+            break;
         }
-        else
+
+        uint64 l_Current    = m_WheelTime & k_SlotMask;
+        uint64 l_BlockStart = m_WheelTime - l_Current;
+
+        /// Jump to the next non empty slot of level 0
+        uint64 l_NextSlots = m_Wheel->UsedSlots[0] & ~((uint64(2) << l_Current) - 1);
+        if (l_NextSlots && l_BlockStart + LowestBit(l_NextSlots) <= m_time)
         {
-            d(Event);
+            m_WheelTime = l_BlockStart + LowestBit(l_NextSlots);
+            continue;
         }
-    };
-    auto a = [this, &b](uint32 p_time) {
-        // main event loop
-        EventList::iterator i;
-        while (((i = m_events.begin()) != m_events.end()) && i->first <= m_time)
+
+        /// Level 0 is done, the events of the next block are moved down from the upper levels
+        uint64 l_NextCascade = m_Wheel->UsedSlots[0] ? l_BlockStart + k_SlotCount : GetNextCascadeTime();
+        if (l_NextCascade > m_time)
         {
-            b(i, p_time);
+            m_WheelTime = m_time;
+            break;
         }
-    };
 
-    // update time
-    m_time += p_time;
+        m_WheelTime = l_NextCascade;
+        Cascade(1);
+    }
 
-    a(p_time);
+    ReleaseWheelIfEmpty();
 }
 
 void EventProcessor::KillAllEvents(bool force)
@@ -66,33 +299,57 @@ void EventProcessor::KillAllEvents(bool force)
     // prevent event insertions
     m_aborting = true;
 
-    // first, abort all existing events
-    for (EventList::iterator i = m_events.begin(); i != m_events.end();)
-    {
-        EventList::iterator i_old = i;
-        ++i;
+    if (!m_Wheel)
+        return;
+
+    /// Events are aborted in order of execution, like they were in the previous std::multimap
+    std::vector<BasicEvent*> l_Events;
+    l_Events.reserve(m_EventCount);
 
-        i_old->second->to_Abort = true;
-        i_old->second->Abort(m_time);
-        if (force || i_old->second->IsDeletable())
+    for (uint32 l_Level = 0; l_Level < k_LevelCount; ++l_Level)
+    {
+        for (uint32 l_Slot = 0; l_Slot < k_SlotCount; ++l_Slot)
         {
-            delete i_old->second;
+            while (BasicEvent* l_Event = m_Wheel->Slots[l_Level][l_Slot])
+            {
+                Unlink(l_Level, l_Slot, l_Event);
+                l_Events.push_back(l_Event);
+            }
+        }
+    }
+
+    m_EventCount -= l_Events.size();
+
+    std::sort(l_Events.begin(), l_Events.end(), [](BasicEvent const* p_A, BasicEvent const* p_B) -> bool
+    {
+        return ExecutedBefore(p_A, p_B);
+    });
 
-            if (!force)                                      // need per-element cleanup
-                m_events.erase (i_old);
+    for (BasicEvent* l_Event : l_Events)
+    {
+        l_Event->to_Abort = true;
+        l_Event->Abort(m_time);
+
+        if (force || l_Event->IsDeletable())
+            delete l_Event;
+        else
+        {
+            ++m_EventCount;
+            Schedule(l_Event);
         }
     }
 
-    // fast clear event list (in force case)
-    if (force)
-        m_events.clear();
+    ReleaseWheelIfEmpty();
 }
 
 void EventProcessor::AddEvent(BasicEvent* Event, uint64 e_time, bool set_addtime)
 {
     if (set_addtime) Event->m_addTime = m_time;
     Event->m_execTime = e_time;
-    m_events.insert(std::pair<uint64, BasicEvent*>(e_time, Event));
+    Event->m_Sequence = m_NextSequence++;
+
+    ++m_EventCount;
+    Schedule(Event);
 }
 
 uint64 EventProcessor::CalculateTime(uint64 t_offset) const
@@ -100,3 +357,178 @@ uint64 EventProcessor::CalculateTime(uint64 t_offset) const
     return(m_time + t_offset);
 }
 
+bool EventProcessor::ExecutedBefore(BasicEvent const* p_A, BasicEvent const* p_B)
+{
+    return p_A->m_execTime < p_B->m_execTime || (p_A->m_execTime == p_B->m_execTime && p_A->m_Sequence < p_B->m_Sequence);
+}
+
+void EventProcessor::Schedule(BasicEvent* p_Event)
+{
+    if (!m_Wheel)
+    {
+        m_Wheel = static_cast<Wheel*>(PoolAllocate(sizeof(Wheel)));
+        memset(m_Wheel, 0, sizeof(Wheel));
+    }
+
+    /// Events already due go to the current slot, they are executed first as their time is lower
+    uint64 l_Time  = std::max(p_Event->m_execTime, m_WheelTime);
+    uint64 l_Delta = l_Time - m_WheelTime;
+
+    uint32 l_Level = 0;
+    while (l_Level + 1 < k_LevelCount && l_Delta >= (uint64(1) << ((l_Level + 1) * k_SlotBits)))
+        ++l_Level;
+
+    /// Beyond the last level, the event is moved down again when its slot is reached
+    if (l_Delta >= (uint64(1) << (k_LevelCount * k_SlotBits)))
+        l_Time = m_WheelTime + (uint64(1) << (k_LevelCount * k_SlotBits)) - 1;
+
+    Link(l_Level, (l_Time >> (l_Level * k_SlotBits)) & k_SlotMask, p_Event);
+}
+
+void EventProcessor::Link(uint32 p_Level, uint32 p_Slot, BasicEvent* p_Event)
+{
+    BasicEvent*& l_Head = m_Wheel->Slots[p_Level][p_Slot];
+
+    if (!l_Head)
+    {
+        p_Event->m_Next     = p_Event;
+        p_Event->m_Previous = p_Event;
+        l_Head = p_Event;
+        m_Wheel->UsedSlots[p_Level] |= uint64(1) << p_Slot;
+        return;
+    }
+
+    BasicEvent* l_Tail    = l_Head->m_Previous;
+    BasicEvent* l_After   = l_Tail;
+    bool        l_NewHead = false;
+
+    /// Level 0 slots are kept sorted, new events are usually the last ones
+    if (p_Level == 0)
+    {
+        while (ExecutedBefore(p_Event, l_After))
+        {
+            if (l_After == l_Head)
+            {
+                l_After   = l_Tail;
+                l_NewHead = true;
+                break;
+            }
+
+            l_After = l_After->m_Previous;
+        }
+    }
+
+    p_Event->m_Previous = l_After;
+    p_Event->m_Next     = l_After->m_Next;
+    l_After->m_Next->m_Previous = p_Event;
+    l_After->m_Next = p_Event;
+
+    if (l_NewHead)
+        l_Head = p_Event;
+}
+
+void EventProcessor::Unlink(uint32 p_Level, uint32 p_Slot, BasicEvent* p_Event)
+{
+    BasicEvent*& l_Head = m_Wheel->Slots[p_Level][p_Slot];
+
+    if (p_Event->m_Next == p_Event)
+    {
+        l_Head = nullptr;
+        m_Wheel->UsedSlots[p_Level] &= ~(uint64(1) << p_Slot);
+    }
+    else
+    {
+        p_Event->m_Previous->m_Next = p_Event->m_Next;
+        p_Event->m_Next->m_Previous = p_Event->m_Previous;
+
+        if (l_Head == p_Event)
+            l_Head = p_Event->m_Next;
+    }
+
+    p_Event->m_Next     = nullptr;
+    p_Event->m_Previous = nullptr;
+}
+
+uint64 EventProcessor::GetNextCascadeTime() const
+{
+    uint64 l_NextTime = std::numeric_limits<uint64>::max();
+
+    /// Cascading an empty slot does nothing, only the next non empty slot of each level matters
+    for (uint32 l_Level = 1; l_Level < k_LevelCount; ++l_Level)
+    {
+        uint64 l_UsedSlots = m_Wheel->UsedSlots[l_Level];
+        if (!l_UsedSlots)
+            continue;
+
+        uint32 l_Shift      = l_Level * k_SlotBits;
+        uint64 l_Current    = (m_WheelTime >> l_Shift) & k_SlotMask;
+        uint64 l_BlockStart = (m_WheelTime >> (l_Shift + k_SlotBits)) << (l_Shift + k_SlotBits);
+        uint64 l_NextSlots  = l_UsedSlots & ~((uint64(2) << l_Current) - 1);
+
+        if (l_NextSlots)
+            l_NextTime = std::min(l_NextTime, l_BlockStart + (uint64(LowestBit(l_NextSlots)) << l_Shift));
+        else
+            l_NextTime = std::min(l_NextTime, l_BlockStart + (uint64(k_SlotCount + LowestBit(l_UsedSlots)) << l_Shift));
+    }
+
+    return l_NextTime;
+}
+
+void EventProcessor::Cascade(uint32 p_Level)
+{
+    uint32 l_Slot = (m_WheelTime >> (p_Level * k_SlotBits)) & k_SlotMask;
+
+    /// The upper level reached a new slot too, its events may go down to this level
+    if (!l_Slot && p_Level + 1 < k_LevelCount)
+        Cascade(p_Level + 1);
+
+    BasicEvent* l_Event = m_Wheel->Slots[p_Level][l_Slot];
+    if (!l_Event)
+        return;
+
+    l_Event->m_Previous->m_Next = nullptr;
+    m_Wheel->Slots[p_Level][l_Slot] = nullptr;
+    m_Wheel->UsedSlots[p_Level] &= ~(uint64(1) << l_Slot);
+
+    while (l_Event)
+    {
+        BasicEvent* l_Next = l_Event->m_Next;
+        Schedule(l_Event);
+        l_Event = l_Next;
+    }
+}
+
+void EventProcessor::ExecuteCurrentSlot(uint32 p_time)
+{
+    uint32 l_Slot = m_WheelTime & k_SlotMask;
+
+    // main event loop, events can be added or removed by the executed ones
+    while (m_Wheel && m_Wheel->Slots[0][l_Slot])
+    {
+        // get and remove event from queue
+        BasicEvent* l_Event = m_Wheel->Slots[0][l_Slot];
+        Unlink(0, l_Slot, l_Event);
+        --m_EventCount;
+
+        if (!l_Event->to_Abort)
+        {
+            // completely destroy event if it is not re-added
+            if (l_Event->Execute(m_time, p_time))
+                delete l_Event;
+        }
+        else
+        {
+            l_Event->Abort(m_time);
+            delete l_Event;
+        }
+    }
+}
+
+void EventProcessor::ReleaseWheelIfEmpty()
+{
+    if (!m_Wheel || m_EventCount)
+        return;
+
+    PoolFree(m_Wheel, sizeof(Wheel));
+    m_Wheel = nullptr;
+}
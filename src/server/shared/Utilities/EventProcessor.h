@@ -16,10 +16,15 @@
 
 class BasicEvent
 {
+    friend class EventProcessor;
+
     public:
-        BasicEvent() { to_Abort = false; }
+        BasicEvent() { to_Abort = false; m_Next = nullptr; m_Previous = nullptr; m_Sequence = 0; }
         virtual ~BasicEvent() {}                              // override destructor to perform some actions on event removal
 
+        /// Events are allocated from per thread pools of fixed size blocks instead of the heap
+        static void* operator new(size_t p_Size);
+        static void operator delete(void* p_Pointer, size_t p_Size);
 
         // this method executes when the event is triggered
         // return false if event does not want to be deleted
@@ -36,10 +41,18 @@ class BasicEvent
         // these can be used for time offset control
         uint64 m_addTime;                                   // time when the event was added to queue, filled by event handler
         uint64 m_execTime;                                  // planned time of next execution, filled by event handler
-};
 
-typedef std::multimap<uint64, BasicEvent*> EventList;
+    private:
+        BasicEvent* m_Next;                                 ///< Next event of the same timer wheel slot, the slot is a circular list
+        BasicEvent* m_Previous;                             ///< Previous event of the same timer wheel slot, the head's previous is the tail
+        uint64      m_Sequence;                             ///< Insertion order, events due at the same time are executed in this order
+};
 
+/// Events are kept in a hierarchical timer wheel
+/// - Level 0 has one slot per millisecond for the next 64 ms, each next level has 64 slots covering 64 slots of the previous one
+/// - Adding or unlinking an event is O(1), an event is moved down at most once per level before it's due
+/// - Events are executed in order of execution time then of insertion, exactly like the previous std::multimap
+/// - The wheel is only allocated while the processor has events
 class EventProcessor
 {
     public:
@@ -50,9 +63,40 @@ class EventProcessor
         void KillAllEvents(bool force);
         void AddEvent(BasicEvent* Event, uint64 e_time, bool set_addtime = true);
         uint64 CalculateTime(uint64 t_offset) const;
+
     protected:
+        enum
+        {
+            k_SlotBits   = 6,
+            k_SlotCount  = 1 << k_SlotBits,
+            k_SlotMask   = k_SlotCount - 1,
+            k_LevelCount = 5
+        };
+
+        struct Wheel
+        {
+            BasicEvent* Slots[k_LevelCount][k_SlotCount];   ///< Head of each slot
+            uint64      UsedSlots[k_LevelCount];            ///< One bit per non empty slot
+        };
+
+        /// Order of execution of two events
+        static bool ExecutedBefore(BasicEvent const* p_A, BasicEvent const* p_B);
+
+        void Schedule(BasicEvent* p_Event);
+        void Link(uint32 p_Level, uint32 p_Slot, BasicEvent* p_Event);
+        void Unlink(uint32 p_Level, uint32 p_Slot, BasicEvent* p_Event);
+        /// Next time a non empty slot of the upper levels is reached
+        uint64 GetNextCascadeTime() const;
+        void Cascade(uint32 p_Level);
+        void ExecuteCurrentSlot(uint32 p_time);
+        void ReleaseWheelIfEmpty();
+
         uint64 m_time;
-        EventList m_events;
         bool m_aborting;
+
+        Wheel* m_Wheel;
+        uint64 m_WheelTime;                                 ///< Time of the level 0 current slot, never greater than m_time
+        uint64 m_EventCount;
+        uint64 m_NextSequence;
 };
 #endif
@@ -695,6 +695,10 @@ bool Master::_StartDB()
     }
 
     synch_threads = ConfigMgr::GetIntDefault("WorldDatabase.SynchThreads", 1);
+
+    /// One connection per startup loader thread, they are used by the other synch queries once the server is loaded
+    synch_threads = std::max<int>(synch_threads, std::min<int>(ConfigMgr::GetIntDefault("Startup.LoaderThreads", 4), 32));
+
     ///- Initialize the world database
     if (!WorldDatabase.Open(dbstring, async_threads, synch_threads))
     {